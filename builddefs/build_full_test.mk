@@ -28,7 +28,13 @@ $(TEST_OUTPUT)_SRC := \
 	tests/test_common/test_fixture.cpp \
 	tests/test_common/test_keymap_key.cpp \
 	tests/test_common/test_logger.cpp \
-	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp))
+	$(patsubst $(ROOTDIR)/%,%,$(wildcard $(TEST_PATH)/*.cpp)) \
+	$(patsubst $(CURDIR)/%,%,$(abspath $(addprefix $(TEST_PATH)/,$(TEST_SRC))))
+
+# Benchmarks only measure performance, so they are left out unless asked for
+ifneq ($(strip $(BENCHMARK)), yes)
+    $(TEST_OUTPUT)_SRC := $(foreach file,$($(TEST_OUTPUT)_SRC),$(if $(filter benchmark_%,$(notdir $(file))),,$(file)))
+endif
 
 $(TEST_OUTPUT)_DEFS := $(OPT_DEFS) "-DKEYMAP_C=\"keymap.c\""
 
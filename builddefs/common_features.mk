@@ -23,6 +23,7 @@ QUANTUM_SRC += \
     $(QUANTUM_DIR)/action_util.c \
     $(QUANTUM_DIR)/eeconfig.c \
     $(QUANTUM_DIR)/keyboard.c \
+    $(QUANTUM_DIR)/task_scheduler.c \
     $(QUANTUM_DIR)/keymap_common.c \
     $(QUANTUM_DIR)/keycode_config.c \
     $(QUANTUM_DIR)/sync_timer.c \
@@ -44,6 +45,15 @@ else ifeq ($(strip $(DEBUG_MATRIX_SCAN_RATE_ENABLE)), api)
     OPT_DEFS += -DDEBUG_MATRIX_SCAN_RATE
 endif
 
+ifeq ($(strip $(PROCESS_RECORD_LEGACY_DISPATCH)), yes)
+    OPT_DEFS += -DPROCESS_RECORD_LEGACY_DISPATCH
+endif
+
+ifeq ($(strip $(SEND_STRING_ASYNC_ENABLE)), yes)
+    OPT_DEFS += -DSEND_STRING_ASYNC_ENABLE
+    SRC += $(QUANTUM_DIR)/send_string/send_string_async.c
+endif
+
 AUDIO_ENABLE ?= no
 ifeq ($(strip $(AUDIO_ENABLE)), yes)
     ifeq ($(PLATFORM),CHIBIOS)
@@ -78,6 +78,11 @@ void eeprom_update_dword(uint32_t *addr, uint32_t value) {
     }
 }
 
+void eeprom_driver_flush(void) __attribute__((weak));
+void eeprom_driver_flush(void) {
+    /* The default implementation assumes that writes are not buffered. */
+}
+
 void eeprom_driver_format(bool erase) __attribute__((weak));
 void eeprom_driver_format(bool erase) {
     (void)erase; /* The default implementation assumes that the eeprom must be erased in order to be usable. */
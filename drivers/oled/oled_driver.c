@@ -165,6 +165,11 @@ uint32_t oled_scroll_timeout;
 #if OLED_UPDATE_INTERVAL > 0
 uint16_t oled_update_timeout;
 #endif
+#ifdef OLED_SHADOW_BUFFER
+// Copy of what was last sent to the display, so that blocks redrawn with identical content aren't sent again
+static uint8_t         oled_shadow[OLED_MATRIX_SIZE];
+static OLED_BLOCK_TYPE oled_shadow_valid = 0;
+#endif
 
 #if defined(OLED_TRANSPORT_SPI)
 #    ifndef OLED_DC_PIN
@@ -362,6 +367,11 @@ bool oled_init(oled_rotation_t rotation) {
     oled_scroll_timeout = timer_read32() + OLED_SCROLL_TIMEOUT;
 #endif
 
+#ifdef OLED_SHADOW_BUFFER
+    // Whatever the display holds now is unknown
+    oled_shadow_valid = 0;
+#endif
+
     oled_clear();
     oled_initialized = true;
     oled_active      = true;
@@ -382,23 +392,46 @@ void oled_clear(void) {
     oled_dirty  = OLED_ALL_BLOCKS_MASK;
 }
 
-static void calc_bounds(uint8_t update_start, uint8_t *cmd_array) {
-    // Calculate commands to set memory addressing bounds.
-    uint8_t start_page   = OLED_BLOCK_SIZE * update_start / OLED_DISPLAY_WIDTH;
-    uint8_t start_column = OLED_BLOCK_SIZE * update_start % OLED_DISPLAY_WIDTH;
-#if !OLED_IC_HAS_HORIZONTAL_MODE
-    // Commands for Page Addressing Mode. Sets starting page and column; has no end bound.
-    // Column value must be split into high and low nybble and sent as two commands.
-    cmd_array[0] = PAM_PAGE_ADDR | start_page;
-    cmd_array[1] = PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f);
-    cmd_array[2] = PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f);
+// Sends the buffer bytes in [start, end) to the display, addressing each page-aligned part of the span once
+static bool oled_send_span(uint16_t start, uint16_t end) {
+    while (start < end) {
+        uint8_t  start_page   = start / OLED_DISPLAY_WIDTH;
+        uint8_t  start_column = start % OLED_DISPLAY_WIDTH;
+        uint16_t length       = OLED_DISPLAY_WIDTH - start_column;
+#if OLED_IC_HAS_HORIZONTAL_MODE
+        // Horizontal Addressing Mode wraps onto the next page, so whole pages can go out in one transfer
+        uint8_t end_page = start_page;
+        if (start_column == 0 && end - start >= OLED_DISPLAY_WIDTH) {
+            end_page += (end - start) / OLED_DISPLAY_WIDTH - 1;
+            length = (end_page - start_page + 1) * OLED_DISPLAY_WIDTH;
+        } else if (length > end - start) {
+            length = end - start;
+        }
+        uint8_t end_column      = (end_page == start_page) ? start_column + length - 1 : OLED_DISPLAY_WIDTH - 1;
+        uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, start_column + OLED_COLUMN_OFFSET, end_column + OLED_COLUMN_OFFSET, PAGE_ADDR, start_page, end_page};
 #else
-    // Commands for use in Horizontal Addressing mode.
-    cmd_array[1] = start_column + OLED_COLUMN_OFFSET;
-    cmd_array[4] = start_page;
-    cmd_array[2] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) % OLED_DISPLAY_WIDTH + cmd_array[1];
-    cmd_array[5] = (OLED_BLOCK_SIZE + OLED_DISPLAY_WIDTH - 1) / OLED_DISPLAY_WIDTH - 1 + cmd_array[4];
+        // Page Addressing Mode has no end bound, and doesn't move on to the next page by itself
+        if (length > end - start) {
+            length = end - start;
+        }
+        uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR | start_page, PAM_SETCOLUMN_LSB | ((OLED_COLUMN_OFFSET + start_column) & 0x0f), PAM_SETCOLUMN_MSB | ((OLED_COLUMN_OFFSET + start_column) >> 4 & 0x0f)};
 #endif
+
+        // Send column & page position
+        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+            print("oled_render offset command failed\n");
+            return false;
+        }
+
+        // Send render data as is
+        if (!oled_send_data(&oled_buffer[start], length)) {
+            print("oled_render data failed\n");
+            return false;
+        }
+
+        start += length;
+    }
+    return true;
 }
 
 static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
@@ -431,19 +464,89 @@ static void calc_bounds_90(uint8_t update_start, uint8_t *cmd_array) {
 #endif
 }
 
-uint8_t crot(uint8_t a, int8_t n) {
-    const uint8_t mask = 0x7;
-    n &= mask;
-    return a << n | a >> (-n & mask);
+// Rotates an 8x8 block of pixels, so bit i of source byte j ends up as bit 7-j of destination byte i. This is a bitwise
+// transpose done a whole 32-bit word at a time, rather than one bit at a time.
+static void rotate_90(const uint8_t *src, uint8_t *dest) {
+    uint32_t x = ((uint32_t)src[0] << 24) | ((uint32_t)src[1] << 16) | ((uint32_t)src[2] << 8) | src[3];
+    uint32_t y = ((uint32_t)src[4] << 24) | ((uint32_t)src[5] << 16) | ((uint32_t)src[6] << 8) | src[7];
+    uint32_t t;
+
+    // Swap bits within 2x2, then 4x4 blocks of each half, then swap the 4x4 blocks between halves
+    t = (x ^ (x >> 7)) & 0x00AA00AA;
+    x = x ^ t ^ (t << 7);
+    t = (y ^ (y >> 7)) & 0x00AA00AA;
+    y = y ^ t ^ (t << 7);
+    t = (x ^ (x >> 14)) & 0x0000CCCC;
+    x = x ^ t ^ (t << 14);
+    t = (y ^ (y >> 14)) & 0x0000CCCC;
+    y = y ^ t ^ (t << 14);
+    t = (x & 0xF0F0F0F0) | ((y >> 4) & 0x0F0F0F0F);
+    y = ((x << 4) & 0xF0F0F0F0) | (y & 0x0F0F0F0F);
+    x = t;
+
+    dest[7] = x >> 24;
+    dest[6] = x >> 16;
+    dest[5] = x >> 8;
+    dest[4] = x;
+    dest[3] = y >> 24;
+    dest[2] = y >> 16;
+    dest[1] = y >> 8;
+    dest[0] = y;
 }
 
-static void rotate_90(const uint8_t *src, uint8_t *dest) {
-    for (uint8_t i = 0, shift = 7; i < 8; ++i, --shift) {
-        uint8_t selector = (1 << i);
-        for (uint8_t j = 0; j < 8; ++j) {
-            dest[i] |= crot(src[j] & selector, shift - (int8_t)j);
+// Renders a single block when rotated by 90 degrees, which is made up of 8x8 tiles that each need rotating
+static bool oled_render_block_90(uint8_t update_start) {
+    // Set column & page position
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
+#else
+    static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
+#endif
+    calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
+
+    // Send column & page position
+    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+        print("oled_render offset command failed\n");
+        return false;
+    }
+
+    // Rotate the render chunks
+    const static uint8_t source_map[] = OLED_SOURCE_MAP;
+    const static uint8_t target_map[] = OLED_TARGET_MAP;
+
+    static uint8_t temp_buffer[OLED_BLOCK_SIZE];
+    memset(temp_buffer, 0, sizeof(temp_buffer));
+    for (uint8_t i = 0; i < sizeof(source_map); ++i) {
+        rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
+    }
+
+#if OLED_IC_HAS_HORIZONTAL_MODE
+    // Send render data chunk after rotating
+    if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
+        print("oled_render90 data failed\n");
+        return false;
+    }
+#else
+    // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
+    const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
+    const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
+    for (uint8_t i = 0; i < num_pages; ++i) {
+        // Send column & page position for all pages except the first one
+        if (i > 0) {
+            display_start[1]++;
+            if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
+                print("oled_render offset command failed\n");
+                return false;
+            }
+        }
+        // Send data for the page
+        if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
+            print("oled_render90 data failed\n");
+            return false;
         }
     }
+#endif
+    return true;
 }
 
 void oled_render_dirty(bool all) {
@@ -453,82 +556,57 @@ void oled_render_dirty(bool all) {
         return;
     }
 
+#ifdef OLED_SHADOW_BUFFER
+    // Skip blocks that were redrawn with exactly what the display already shows
+    for (uint8_t i = 0; i < OLED_BLOCK_COUNT; ++i) {
+        OLED_BLOCK_TYPE block = (OLED_BLOCK_TYPE)1 << i;
+        if ((oled_dirty & oled_shadow_valid & block) && !memcmp(&oled_buffer[OLED_BLOCK_SIZE * i], &oled_shadow[OLED_BLOCK_SIZE * i], OLED_BLOCK_SIZE)) {
+            oled_dirty &= ~block;
+        }
+    }
+    if (!oled_dirty) {
+        return;
+    }
+#endif
+
     // Turn on display if it is off
     oled_on();
 
     uint8_t update_start  = 0;
     uint8_t num_processed = 0;
-    while (oled_dirty && (num_processed++ < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
+    while (oled_dirty && (num_processed < OLED_UPDATE_PROCESS_LIMIT || all)) { // render all dirty blocks (up to the configured limit)
         // Find next dirty block
         while (!(oled_dirty & ((OLED_BLOCK_TYPE)1 << update_start))) {
             ++update_start;
         }
 
-        // Set column & page position
-#if OLED_IC_HAS_HORIZONTAL_MODE
-        static uint8_t display_start[] = {I2C_CMD, COLUMN_ADDR, 0, OLED_DISPLAY_WIDTH - 1, PAGE_ADDR, 0, OLED_DISPLAY_HEIGHT / 8 - 1};
-#else
-        static uint8_t display_start[] = {I2C_CMD, PAM_PAGE_ADDR, PAM_SETCOLUMN_LSB, PAM_SETCOLUMN_MSB};
-#endif
+        uint8_t update_end = update_start + 1;
         if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            calc_bounds(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        } else {
-            calc_bounds_90(update_start, &display_start[1]); // Offset from I2C_CMD byte at the start
-        }
-
-        // Send column & page position
-        if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-            print("oled_render offset command failed\n");
-            return;
-        }
-
-        if (!HAS_FLAGS(oled_rotation, OLED_ROTATION_90)) {
-            // Send render data chunk as is
-            if (!oled_send_data(&oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE)) {
-                print("oled_render data failed\n");
+            // Contiguous dirty blocks are contiguous on the display too, so send them together
+            while (update_end < OLED_BLOCK_COUNT && (oled_dirty & ((OLED_BLOCK_TYPE)1 << update_end)) && (all || num_processed + (update_end - update_start) < OLED_UPDATE_PROCESS_LIMIT)) {
+                ++update_end;
+            }
+            if (!oled_send_span(OLED_BLOCK_SIZE * update_start, OLED_BLOCK_SIZE * update_end)) {
                 return;
             }
         } else {
-            // Rotate the render chunks
-            const static uint8_t source_map[] = OLED_SOURCE_MAP;
-            const static uint8_t target_map[] = OLED_TARGET_MAP;
-
-            static uint8_t temp_buffer[OLED_BLOCK_SIZE];
-            memset(temp_buffer, 0, sizeof(temp_buffer));
-            for (uint8_t i = 0; i < sizeof(source_map); ++i) {
-                rotate_90(&oled_buffer[OLED_BLOCK_SIZE * update_start + source_map[i]], &temp_buffer[target_map[i]]);
-            }
-
-#if OLED_IC_HAS_HORIZONTAL_MODE
-            // Send render data chunk after rotating
-            if (!oled_send_data(&temp_buffer[0], OLED_BLOCK_SIZE)) {
-                print("oled_render90 data failed\n");
+            if (!oled_render_block_90(update_start)) {
                 return;
             }
-#else
-            // For SH1106 or SH1107 the data chunk must be split into separate pieces for each page
-            const uint8_t columns_in_block = (OLED_BLOCK_SIZE + OLED_DISPLAY_HEIGHT - 1) / OLED_DISPLAY_HEIGHT * 8;
-            const uint8_t num_pages        = OLED_BLOCK_SIZE / columns_in_block;
-            for (uint8_t i = 0; i < num_pages; ++i) {
-                // Send column & page position for all pages except the first one
-                if (i > 0) {
-                    display_start[1]++;
-                    if (!oled_send_cmd(display_start, ARRAY_SIZE(display_start))) {
-                        print("oled_render offset command failed\n");
-                        return;
-                    }
-                }
-                // Send data for the page
-                if (!oled_send_data(&temp_buffer[columns_in_block * i], columns_in_block)) {
-                    print("oled_render90 data failed\n");
-                    return;
-                }
-            }
-#endif
         }
+        num_processed += update_end - update_start;
+
+#ifdef OLED_SHADOW_BUFFER
+        memcpy(&oled_shadow[OLED_BLOCK_SIZE * update_start], &oled_buffer[OLED_BLOCK_SIZE * update_start], OLED_BLOCK_SIZE * (update_end - update_start));
+#endif
 
-        // Clear dirty flag of just rendered block
-        oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+        // Clear dirty flags of just rendered blocks
+        for (; update_start < update_end; ++update_start) {
+            oled_dirty &= ~((OLED_BLOCK_TYPE)1 << update_start);
+#ifdef OLED_SHADOW_BUFFER
+            oled_shadow_valid |= ((OLED_BLOCK_TYPE)1 << update_start);
+#endif
+        }
     }
 }
 
@@ -878,6 +956,10 @@ bool oled_scroll_off(void) {
         }
         oled_scrolling = false;
         oled_dirty     = OLED_ALL_BLOCKS_MASK;
+#ifdef OLED_SHADOW_BUFFER
+        // Scrolling moved the display's contents around
+        oled_shadow_valid = 0;
+#endif
     }
     return !oled_scrolling;
 }
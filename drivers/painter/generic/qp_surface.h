@@ -21,6 +21,32 @@
 #    define SURFACE_NUM_DEVICES 1
 #endif
 
+#ifndef SURFACE_DIRTY_REGION_COUNT
+/**
+ * @def This controls the maximum number of separate dirty regions each surface tracks. Drawing to areas far apart from
+ *      each other gets sent as separate regions, instead of one bounding box covering everything in between. Setting
+ *      this to 1 tracks a single bounding box.
+ */
+#    define SURFACE_DIRTY_REGION_COUNT 4
+#endif
+
+#ifndef SURFACE_DIRTY_REGION_MERGE_PIXELS
+/**
+ * @def Dirty regions are combined whenever their bounding box includes no more than this many clean pixels beyond
+ *      the regions themselves, as each region transferred costs a viewport change on the target.
+ */
+#    define SURFACE_DIRTY_REGION_MERGE_PIXELS 64
+#endif
+
+#ifndef SURFACE_ASYNC_PIXELS_PER_TASK
+/**
+ * @def This controls how many pixels an asynchronous surface draw sends to the target each time Quantum Painter's
+ *      housekeeping task runs. Whole rows are always sent, so at least one row is transferred per task invocation.
+ *      Higher values finish transfers sooner, at the cost of longer stalls of the main loop.
+ */
+#    define SURFACE_ASYNC_PIXELS_PER_TASK 4096
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Forward declarations
 
@@ -30,6 +56,9 @@
 struct surface_painter_device_t;
 typedef struct surface_painter_device_t surface_painter_device_t;
 
+// Callback invoked when an asynchronous surface draw finishes
+typedef void (*qp_surface_flush_callback_t)(painter_device_t surface, painter_device_t target, bool success, void *cb_arg);
+
 /**
  * Factory method for an RGB565 surface (aka framebuffer).
  *
@@ -53,7 +82,7 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
 /**
  * Helper method to draw the contents of the framebuffer to the target device.
  *
- * After successful completion, the dirty area is reset.
+ * After successful completion, the dirty area is reset. Each dirty region is sent separately.
  *
  * @param surface[in] the surface to copy from
  * @param target[in] the target device to copy into
@@ -64,4 +93,43 @@ painter_device_t qp_make_mono1bpp_surface(uint16_t panel_width, uint16_t panel_h
  */
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface);
 
+/**
+ * Queues the contents of the framebuffer to be drawn to the target device in the background.
+ *
+ * The dirty area is captured and reset immediately, and the pixel data is then streamed out in chunks of
+ * `SURFACE_ASYNC_PIXELS_PER_TASK` pixels from Quantum Painter's housekeeping task. Only one transfer per surface may be
+ * in flight at a time.
+ *
+ * Unless the surface is double-buffered, anything drawn to the surface while the transfer is in progress may end up
+ * being sent as part of it.
+ *
+ * @param surface[in] the surface to copy from
+ * @param target[in] the target device to copy into
+ * @param x[in] the x-location of the original position of the framebuffer
+ * @param y[in] the y-location of the original position of the framebuffer
+ * @param entire_surface[in] whether the entire surface should be drawn, instead of just the dirty region
+ * @param callback[in] optional function invoked once the transfer completes or fails
+ * @param cb_arg[in] argument passed to the callback
+ * @return whether the transfer was queued, or there was nothing to transfer; false if one is already in progress
+ */
+bool qp_surface_draw_async(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface, qp_surface_flush_callback_t callback, void *cb_arg);
+
+/**
+ * Checks whether an asynchronous draw of the surface is still in progress.
+ *
+ * @param surface[in] the surface to query
+ * @return whether a transfer is queued or streaming
+ */
+bool qp_surface_flush_in_progress(painter_device_t surface);
+
+/**
+ * Supplies a second buffer for the surface, so that asynchronous draws stream from a copy of the frame while drawing
+ * continues into the surface's own buffer.
+ *
+ * @param surface[in] the surface to double-buffer
+ * @param transfer_buffer[in] pointer to a preallocated buffer of the same size as the surface's own, or NULL to disable
+ * @return whether the buffer was set; false if a transfer is in progress
+ */
+bool qp_surface_set_transfer_buffer(painter_device_t surface, void *transfer_buffer);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
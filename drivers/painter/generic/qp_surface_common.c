@@ -29,24 +29,91 @@ void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport) {
     }
 }
 
+static inline uint32_t qp_surface_rect_area(const surface_dirty_rect_t *rect) {
+    return ((uint32_t)rect->r - rect->l + 1) * ((uint32_t)rect->b - rect->t + 1);
+}
+
+static inline void qp_surface_rect_union(surface_dirty_rect_t *out, const surface_dirty_rect_t *a, const surface_dirty_rect_t *b) {
+    out->l = a->l < b->l ? a->l : b->l;
+    out->t = a->t < b->t ? a->t : b->t;
+    out->r = a->r > b->r ? a->r : b->r;
+    out->b = a->b > b->b ? a->b : b->b;
+}
+
+static inline bool qp_surface_rect_contains(const surface_dirty_rect_t *rect, uint16_t x, uint16_t y) {
+    return x >= rect->l && x <= rect->r && y >= rect->t && y <= rect->b;
+}
+
+// Folds any other regions into the given one where the combined bounding box wastes few enough clean pixels
+static void qp_surface_merge_dirty(surface_dirty_data_t *dirty, uint8_t index) {
+    bool merged;
+    do {
+        merged = false;
+        for (uint8_t i = 0; i < dirty->count; ++i) {
+            if (i == index) {
+                continue;
+            }
+
+            surface_dirty_rect_t combined;
+            qp_surface_rect_union(&combined, &dirty->rects[index], &dirty->rects[i]);
+            if (qp_surface_rect_area(&combined) > qp_surface_rect_area(&dirty->rects[index]) + qp_surface_rect_area(&dirty->rects[i]) + (SURFACE_DIRTY_REGION_MERGE_PIXELS)) {
+                continue;
+            }
+
+            // Keep the combined region, and fill the gap left by the other one with the last region
+            dirty->rects[index] = combined;
+            dirty->count--;
+            if (i != dirty->count) {
+                dirty->rects[i] = dirty->rects[dirty->count];
+                if (index == dirty->count) {
+                    index = i;
+                }
+            }
+            merged = true;
+            break;
+        }
+    } while (merged);
+
+    dirty->last = index;
+}
+
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y) {
-    // Maintain dirty region
-    if (dirty->l > x) {
-        dirty->l        = x;
-        dirty->is_dirty = true;
+    // Drawing tends to stay in the same area, so check the most recently updated region first
+    if (dirty->count > 0 && qp_surface_rect_contains(&dirty->rects[dirty->last], x, y)) {
+        return;
     }
-    if (dirty->r < x) {
-        dirty->r        = x;
-        dirty->is_dirty = true;
-    }
-    if (dirty->t > y) {
-        dirty->t        = y;
-        dirty->is_dirty = true;
+
+    // Work out which region grows the least if it were to include this pixel
+    uint8_t  best      = 0;
+    uint32_t best_cost = UINT32_MAX;
+    for (uint8_t i = 0; i < dirty->count; ++i) {
+        surface_dirty_rect_t *rect = &dirty->rects[i];
+        if (qp_surface_rect_contains(rect, x, y)) {
+            dirty->last = i;
+            return;
+        }
+
+        surface_dirty_rect_t grown;
+        qp_surface_rect_union(&grown, rect, &(surface_dirty_rect_t){.l = x, .t = y, .r = x, .b = y});
+        uint32_t cost = qp_surface_rect_area(&grown) - qp_surface_rect_area(rect);
+        if (cost < best_cost) {
+            best      = i;
+            best_cost = cost;
+        }
     }
-    if (dirty->b < y) {
-        dirty->b        = y;
-        dirty->is_dirty = true;
+
+    dirty->is_dirty = true;
+
+    // Start a new region if it's cheaper than growing an existing one, and there's space for it
+    if (best_cost > (SURFACE_DIRTY_REGION_MERGE_PIXELS) && dirty->count < (SURFACE_DIRTY_REGION_COUNT)) {
+        dirty->rects[dirty->count] = (surface_dirty_rect_t){.l = x, .t = y, .r = x, .b = y};
+        dirty->last                = dirty->count++;
+        return;
     }
+
+    // Otherwise grow the cheapest region, which may now be worth combining with its neighbours
+    qp_surface_rect_union(&dirty->rects[best], &dirty->rects[best], &(surface_dirty_rect_t){.l = x, .t = y, .r = x, .b = y});
+    qp_surface_merge_dirty(dirty, best);
 }
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -57,10 +124,9 @@ bool qp_surface_init(painter_device_t device, painter_rotation_t rotation) {
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
     memset(surface->buffer, 0, SURFACE_REQUIRED_BUFFER_BYTE_SIZE(driver->panel_width, driver->panel_height, driver->native_bits_per_pixel));
 
-    surface->dirty.l        = 0;
-    surface->dirty.t        = 0;
-    surface->dirty.r        = surface->base.panel_width - 1;
-    surface->dirty.b        = surface->base.panel_height - 1;
+    surface->dirty.rects[0] = (surface_dirty_rect_t){.l = 0, .t = 0, .r = surface->base.panel_width - 1, .b = surface->base.panel_height - 1};
+    surface->dirty.count    = 1;
+    surface->dirty.last     = 0;
     surface->dirty.is_dirty = true;
 
     return true;
@@ -80,9 +146,9 @@ bool qp_surface_clear(painter_device_t device) {
 bool qp_surface_flush(painter_device_t device) {
     painter_driver_t *        driver  = (painter_driver_t *)device;
     surface_painter_device_t *surface = (surface_painter_device_t *)driver;
-    surface->dirty.l = surface->dirty.t = UINT16_MAX;
-    surface->dirty.r = surface->dirty.b = 0;
-    surface->dirty.is_dirty             = false;
+    surface->dirty.count    = 0;
+    surface->dirty.last     = 0;
+    surface->dirty.is_dirty = false;
     return true;
 }
 
@@ -105,13 +171,38 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Drawing routine to copy out the dirty region and send it to another device
 
+// Works out the regions to transfer, returning false if there's nothing to send
+static bool qp_surface_transfer_regions(surface_painter_device_t *surface_handle, bool entire_surface, surface_dirty_data_t *regions) {
+    if (entire_surface) {
+        regions->rects[0] = (surface_dirty_rect_t){.l = 0, .t = 0, .r = surface_handle->base.panel_width - 1, .b = surface_handle->base.panel_height - 1};
+        regions->count    = 1;
+        regions->last     = 0;
+        regions->is_dirty = true;
+        return true;
+    }
+
+    if (!surface_handle->dirty.is_dirty) {
+        return false;
+    }
+
+    *regions = surface_handle->dirty;
+    return true;
+}
+
 bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface) {
     painter_driver_t *        surface_driver = (painter_driver_t *)surface;
     surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
     painter_driver_t *        target_driver  = (painter_driver_t *)target;
 
+    // Don't interleave with a transfer that's already streaming
+    if (surface_handle->transfer.target) {
+        qp_dprintf("qp_surface_draw: fail (asynchronous transfer in progress)\n");
+        return false;
+    }
+
     // If we're not dirty... we're done.
-    if (!surface_handle->dirty.is_dirty) {
+    surface_dirty_data_t regions;
+    if (!qp_surface_transfer_regions(surface_handle, entire_surface, &regions)) {
         qp_dprintf("qp_surface_draw: ok (not dirty, skipping)\n");
         return true;
     }
@@ -122,16 +213,18 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
         return false;
     }
 
-    // Offload to the pixdata transfer function
+    // Offload each region to the pixdata transfer function
     surface_painter_driver_vtable_t *vtable = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
-    bool                             ok     = vtable->target_pixdata_transfer(surface_driver, target_driver, x, y, entire_surface);
-    if (!ok) {
-        qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
-        return false;
+    for (uint8_t i = 0; i < regions.count; ++i) {
+        surface_dirty_rect_t *rect = &regions.rects[i];
+        if (!vtable->target_pixdata_transfer(surface_driver, target_driver, surface_handle->buffer, x, y, rect->l, rect->t, rect->r, rect->b)) {
+            qp_dprintf("qp_surface_draw: fail (could not transfer pixel data)\n");
+            return false;
+        }
     }
 
     // Clear the dirty info for the surface
-    ok = qp_flush(surface);
+    bool ok = qp_flush(surface);
     if (!ok) {
         qp_dprintf("qp_surface_draw: fail (could not flush)\n");
         return false;
@@ -139,3 +232,136 @@ bool qp_surface_draw(painter_device_t surface, painter_device_t target, uint16_t
     qp_dprintf("qp_surface_draw: ok\n");
     return true;
 }
+
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Asynchronous transfers, streamed out from the Quantum Painter task
+
+// Surfaces with a queued transfer, in the order they were queued
+static surface_painter_device_t *pending_transfers = NULL;
+
+bool qp_surface_set_transfer_buffer(painter_device_t surface, void *transfer_buffer) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface;
+    if (surface_handle->transfer.target) {
+        qp_dprintf("qp_surface_set_transfer_buffer: fail (asynchronous transfer in progress)\n");
+        return false;
+    }
+
+    surface_handle->transfer_buffer = transfer_buffer;
+    return true;
+}
+
+bool qp_surface_flush_in_progress(painter_device_t surface) {
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface;
+    return surface_handle->transfer.target != NULL;
+}
+
+bool qp_surface_draw_async(painter_device_t surface, painter_device_t target, uint16_t x, uint16_t y, bool entire_surface, qp_surface_flush_callback_t callback, void *cb_arg) {
+    painter_driver_t *        surface_driver = (painter_driver_t *)surface;
+    surface_painter_device_t *surface_handle = (surface_painter_device_t *)surface_driver;
+    painter_driver_t *        target_driver  = (painter_driver_t *)target;
+    surface_transfer_data_t * transfer       = &surface_handle->transfer;
+
+    if (transfer->target) {
+        qp_dprintf("qp_surface_draw_async: fail (transfer already in progress)\n");
+        return false;
+    }
+
+    // If we're not dirty, there's nothing to queue -- let the caller know straight away
+    if (!qp_surface_transfer_regions(surface_handle, entire_surface, &transfer->regions)) {
+        qp_dprintf("qp_surface_draw_async: ok (not dirty, skipping)\n");
+        if (callback) {
+            callback(surface, target, true, cb_arg);
+        }
+        return true;
+    }
+
+    // If we have incompatible bit depths, drop out
+    if (surface_driver->native_bits_per_pixel != target_driver->native_bits_per_pixel) {
+        qp_dprintf("qp_surface_draw_async: fail (incompatible bpp: surface=%d, target=%d)\n", (int)surface_driver->native_bits_per_pixel, (int)target_driver->native_bits_per_pixel);
+        return false;
+    }
+
+    // Snapshot the regions into the transfer buffer, so drawing can carry on in the surface's own buffer. The byte span
+    // between the first and last pixels covers a whole region, which is good enough for a memcpy.
+    transfer->buffer = surface_handle->buffer;
+    if (surface_handle->transfer_buffer) {
+        uint8_t bpp = surface_driver->native_bits_per_pixel;
+        for (uint8_t i = 0; i < transfer->regions.count; ++i) {
+            surface_dirty_rect_t *rect  = &transfer->regions.rects[i];
+            uint32_t              first = (((uint32_t)rect->t * surface_driver->panel_width + rect->l) * bpp) / 8;
+            uint32_t              last  = ((((uint32_t)rect->b * surface_driver->panel_width + rect->r) + 1) * bpp + 7) / 8;
+            memcpy((uint8_t *)surface_handle->transfer_buffer + first, surface_handle->u8buffer + first, last - first);
+        }
+        transfer->buffer = surface_handle->transfer_buffer;
+    }
+
+    transfer->target   = target_driver;
+    transfer->x        = x;
+    transfer->y        = y;
+    transfer->region   = 0;
+    transfer->callback = callback;
+    transfer->cb_arg   = cb_arg;
+    transfer->next     = NULL;
+
+    // Anything drawn from here on belongs to the next transfer
+    if (!qp_flush(surface)) {
+        qp_dprintf("qp_surface_draw_async: fail (could not flush)\n");
+        transfer->target = NULL;
+        return false;
+    }
+
+    // Append to the queue
+    surface_painter_device_t **tail = &pending_transfers;
+    while (*tail) {
+        tail = &(*tail)->transfer.next;
+    }
+    *tail = surface_handle;
+
+    qp_dprintf("qp_surface_draw_async: ok (queued)\n");
+    return true;
+}
+
+void qp_surface_internal_tick(void) {
+    surface_painter_device_t *surface_handle = pending_transfers;
+    if (!surface_handle) {
+        return;
+    }
+
+    // Send as many whole rows of the current region as fit in the per-task budget, with a minimum of one
+    surface_transfer_data_t *transfer = &surface_handle->transfer;
+    surface_dirty_rect_t *   rect     = &transfer->regions.rects[transfer->region];
+    uint32_t                 rows     = (SURFACE_ASYNC_PIXELS_PER_TASK) / ((uint32_t)rect->r - rect->l + 1);
+    if (rows == 0) {
+        rows = 1;
+    }
+    uint16_t b = (rect->b - rect->t + 1 > rows) ? (rect->t + rows - 1) : rect->b;
+
+    // The target viewport is set for every chunk, so other drawing to the target in between is harmless
+    painter_driver_t *               surface_driver = (painter_driver_t *)surface_handle;
+    surface_painter_driver_vtable_t *vtable         = (surface_painter_driver_vtable_t *)surface_driver->driver_vtable;
+    bool                             ok             = vtable->target_pixdata_transfer(surface_driver, transfer->target, transfer->buffer, transfer->x, transfer->y, rect->l, rect->t, rect->r, b);
+    if (ok) {
+        if (b < rect->b) {
+            rect->t = b + 1;
+            return;
+        }
+        if (++transfer->region < transfer->regions.count) {
+            return;
+        }
+    }
+
+    if (!ok) {
+        qp_dprintf("qp_surface_internal_tick: fail (could not transfer pixel data)\n");
+    }
+
+    // Done, or failed -- dequeue before notifying, so the callback is free to queue the next frame
+    painter_device_t            target   = (painter_device_t)transfer->target;
+    qp_surface_flush_callback_t callback = transfer->callback;
+    void *                      cb_arg   = transfer->cb_arg;
+    pending_transfers                    = transfer->next;
+    transfer->target                     = NULL;
+    transfer->next                       = NULL;
+    if (callback) {
+        callback((painter_device_t)surface_handle, target, ok, cb_arg);
+    }
+}
@@ -13,15 +13,22 @@
 typedef struct surface_painter_driver_vtable_t {
     painter_driver_vtable_t base; // must be first, so it can be cast to/from the painter_driver_vtable_t* type
 
-    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, uint16_t x, uint16_t y, bool entire_surface);
+    // Copies the region (l,t)-(r,b) of the supplied pixel buffer to the target, with the surface's origin at (x,y)
+    bool (*target_pixdata_transfer)(painter_driver_t *surface_driver, painter_driver_t *target_driver, const void *buffer, uint16_t x, uint16_t y, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 } surface_painter_driver_vtable_t;
 
-typedef struct surface_dirty_data_t {
-    bool     is_dirty;
+typedef struct surface_dirty_rect_t {
     uint16_t l;
     uint16_t t;
     uint16_t r;
     uint16_t b;
+} surface_dirty_rect_t;
+
+typedef struct surface_dirty_data_t {
+    bool                 is_dirty;
+    uint8_t              count; // number of regions in use
+    uint8_t              last;  // region most recently added to, checked first
+    surface_dirty_rect_t rects[SURFACE_DIRTY_REGION_COUNT];
 } surface_dirty_data_t;
 
 typedef struct surface_viewport_data_t {
@@ -36,6 +43,29 @@ typedef struct surface_viewport_data_t {
     uint16_t pixdata_y;
 } surface_viewport_data_t;
 
+typedef struct surface_transfer_data_t {
+    // The device being streamed to, or NULL if no transfer is queued
+    painter_driver_t *target;
+
+    // Where the pixel data is read from -- the transfer buffer if double-buffered, otherwise the surface's own buffer
+    const void *buffer;
+
+    // The target location of the surface
+    uint16_t x;
+    uint16_t y;
+
+    // The regions left to transfer; the top of the current region moves down as rows are sent
+    surface_dirty_data_t regions;
+    uint8_t              region;
+
+    // Invoked once the transfer completes or fails
+    qp_surface_flush_callback_t callback;
+    void *                      cb_arg;
+
+    // Next surface with a queued transfer
+    struct surface_painter_device_t *next;
+} surface_transfer_data_t;
+
 // Surface struct
 typedef struct surface_painter_device_t {
     painter_driver_t base; // must be first, so it can be cast to/from the painter_device_t* type
@@ -50,8 +80,14 @@ typedef struct surface_painter_device_t {
     // Manually manage the viewport for streaming pixel data to the display
     surface_viewport_data_t viewport;
 
-    // Maintain a dirty region so we can stream only what we need
+    // Maintain a set of dirty regions so we can stream only what we need
     surface_dirty_data_t dirty;
+
+    // Optional second buffer holding the frame being transferred, so drawing can continue while it streams out
+    void *transfer_buffer;
+
+    // State of the queued asynchronous transfer, if any
+    surface_transfer_data_t transfer;
 } surface_painter_device_t;
 
 /**
@@ -90,6 +126,9 @@ bool qp_surface_viewport(painter_device_t device, uint16_t left, uint16_t top, u
 void qp_surface_increment_pixdata_location(surface_viewport_data_t *viewport);
 void qp_surface_update_dirty(surface_dirty_data_t *dirty, uint16_t x, uint16_t y);
 
+// Streams the next chunk of the queued asynchronous transfers, called from Quantum Painter's housekeeping task
+void qp_surface_internal_tick(void);
+
 #endif // QUANTUM_PAINTER_SURFACE_ENABLE
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -62,7 +62,7 @@ bool qp_oled_panel_passthru_append_pixels(painter_device_t device, uint8_t *targ
 bool qp_oled_panel_passthru_append_pixdata(painter_device_t device, uint8_t *target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte);
 
 // Helpers for flushing data from the dirty region to the correct location on the OLED
-void qp_oled_panel_page_column_flush_rot0(painter_device_t device, surface_dirty_data_t *dirty, const uint8_t *framebuffer);
-void qp_oled_panel_page_column_flush_rot90(painter_device_t device, surface_dirty_data_t *dirty, const uint8_t *framebuffer);
-void qp_oled_panel_page_column_flush_rot180(painter_device_t device, surface_dirty_data_t *dirty, const uint8_t *framebuffer);
-void qp_oled_panel_page_column_flush_rot270(painter_device_t device, surface_dirty_data_t *dirty, const uint8_t *framebuffer);
+void qp_oled_panel_page_column_flush_rot0(painter_device_t device, const surface_dirty_rect_t *dirty, const uint8_t *framebuffer);
+void qp_oled_panel_page_column_flush_rot90(painter_device_t device, const surface_dirty_rect_t *dirty, const uint8_t *framebuffer);
+void qp_oled_panel_page_column_flush_rot180(painter_device_t device, const surface_dirty_rect_t *dirty, const uint8_t *framebuffer);
+void qp_oled_panel_page_column_flush_rot270(painter_device_t device, const surface_dirty_rect_t *dirty, const uint8_t *framebuffer);
@@ -165,11 +165,12 @@ def check_typo_against_dictionary(typo: str, line_number: int, correct_words) ->
                 cli.log.warning('{fg_yellow}Warning:%d:{fg_reset} Typo "{fg_cyan}%s{fg_reset}" would falsely trigger on correctly spelled word "{fg_cyan}%s{fg_reset}".', line_number, typo, word)
 
 
-def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any]) -> List[int]:
+def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any], offset_size: int = 2) -> List[int]:
     """Serializes trie and correction data in a form readable by the C code.
   Args:
     autocorrections: List of (typo, correction) tuples.
     trie: Dict of dicts.
+    offset_size: Number of bytes of each node link, 2 or 4.
   Returns:
     List of ints in the range 0-255.
   """
@@ -220,25 +221,24 @@ def serialize_trie(autocorrections: List[Tuple[str, str]], trie: Dict[str, Any])
         else:  # Handle a branch table entry.
             data = []
             for c, link in zip(e['chars'], e['links']):
-                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link)
+                data += [TYPO_CHARS[c] | (0 if data else 64)] + encode_link(link, offset_size)
             return data + [0]
 
     byte_offset = 0
     for e in table:  # To encode links, first compute byte offset of each entry.
         e['byte_offset'] = byte_offset
         byte_offset += len(serialize(e))
-        assert 0 <= byte_offset <= 0xffff
 
     return [b for e in table for b in serialize(e)]  # Serialize final table.
 
 
-def encode_link(link: Dict[str, Any]) -> List[int]:
-    """Encodes a node link as two bytes."""
+def encode_link(link: Dict[str, Any], offset_size: int = 2) -> List[int]:
+    """Encodes a node link as `offset_size` bytes, in little endian order."""
     byte_offset = link['byte_offset']
-    if not (0 <= byte_offset <= 0xffff):
-        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds 64KB limit. Try reducing the autocorrection dict to fewer entries.')
+    if not (0 <= byte_offset < 1 << (8 * offset_size)):
+        cli.log.error('{fg_red}Error:{fg_reset} The autocorrection table is too large, a node link exceeds the %d-bit limit. Try reducing the autocorrection dict to fewer entries.', 8 * offset_size)
         maybe_exit(1)
-    return [byte_offset & 255, byte_offset >> 8]
+    return list(byte_offset.to_bytes(offset_size, 'little'))
 
 
 def typo_len(e: Tuple[str, str]) -> int:
@@ -254,11 +254,19 @@ def to_hex(b: int) -> str:
 @cli.argument('-km', '--keymap', completer=keymap_completer, help='The keymap to build a firmware for. Ignored when a configurator export is supplied.')
 @cli.argument('-o', '--output', arg_only=True, type=normpath, help='File to write to')
 @cli.argument('-q', '--quiet', arg_only=True, action='store_true', help="Quiet mode, only output error messages")
+@cli.argument('-w', '--wide-offsets', arg_only=True, action='store_true', help="Always use 32-bit node links, instead of only when the table exceeds 64KB")
 @cli.subcommand('Generate the autocorrection data file from a dictionary file.')
 def generate_autocorrect_data(cli):
     autocorrections = parse_file(cli.args.filename)
     trie = make_trie(autocorrections)
-    data = serialize_trie(autocorrections, trie)
+    offset_size = 4 if cli.args.wide_offsets else 2
+    data = serialize_trie(autocorrections, trie, offset_size)
+    if len(data) > 0xffff and offset_size == 2:
+        # Large dictionaries need 32-bit node links, which only ARM and RISC-V targets support.
+        if not cli.args.quiet:
+            cli.log.warning('{fg_yellow}Warning:{fg_reset} The autocorrection table exceeds 64KB, using 32-bit node links. It can not be used on AVR.')
+        offset_size = 4
+        data = serialize_trie(autocorrections, trie, offset_size)
 
     current_keyboard = cli.args.keyboard or cli.config.user.keyboard or cli.config.generate_autocorrect_data.keyboard
     current_keymap = cli.args.keymap or cli.config.user.keymap or cli.config.generate_autocorrect_data.keymap
@@ -281,6 +289,7 @@ def generate_autocorrect_data(cli):
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MIN_LENGTH {len(min_typo)} // "{min_typo}"')
     autocorrect_data_h_lines.append(f'#define AUTOCORRECT_MAX_LENGTH {len(max_typo)} // "{max_typo}"')
+    autocorrect_data_h_lines.append(f'#define AUTOCORRECT_OFFSET_SIZE {offset_size}')
     autocorrect_data_h_lines.append(f'#define DICTIONARY_SIZE {len(data)}')
     autocorrect_data_h_lines.append('')
     autocorrect_data_h_lines.append('static const uint8_t autocorrect_data[DICTIONARY_SIZE] PROGMEM = {')
@@ -1,3 +1,4 @@
+#include <string.h>
 #include "ws2812.h"
 #include "gpio.h"
 #include "util.h"
@@ -86,58 +87,78 @@
 #define RESET_SIZE (1000 * WS2812_TRST_US / (2 * WS2812_TIMING))
 #define PREAMBLE_SIZE 4
 
-static uint8_t txbuf[PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+#if defined(WS2812_SPI_DOUBLE_BUFFER) && defined(WS2812_SPI_USE_CIRCULAR_BUFFER)
+#    error "WS2812_SPI_DOUBLE_BUFFER cannot be used with WS2812_SPI_USE_CIRCULAR_BUFFER"
+#endif
 
-/*
- * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
- * the ws2812b protocol, we use this helper function to translate bytes into
- * 0s and 1s for the LED (with the appropriate timing).
- */
-static uint8_t get_protocol_eq(uint8_t data, int pos) {
-    uint8_t eq = 0;
-    if (data & (1 << (2 * (3 - pos))))
-        eq = 0b1110;
-    else
-        eq = 0b1000;
-    if (data & (2 << (2 * (3 - pos))))
-        eq += 0b11100000;
-    else
-        eq += 0b10000000;
-    return eq;
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+#    define WS2812_SPI_BUFFER_COUNT 2
+#else
+#    define WS2812_SPI_BUFFER_COUNT 1
+#endif
+
+static uint8_t txbuf[WS2812_SPI_BUFFER_COUNT][PREAMBLE_SIZE + DATA_SIZE + RESET_SIZE] = {0};
+// What each buffer currently holds, so that unchanged LEDs don't need encoding again
+static rgb_led_t txbuf_leds[WS2812_SPI_BUFFER_COUNT][WS2812_LED_COUNT];
+static uint8_t   txbuf_back = 0;
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+// Only touched with the system locked, the transfer completion callback clears it
+static bool               txbuf_sending = false;
+static thread_reference_t txbuf_waiter  = NULL;
+
+static void ws2812_spi_end_cb(SPIDriver* spip) {
+    (void)spip;
+    osalSysLockFromISR();
+    txbuf_sending = false;
+    osalThreadResumeI(&txbuf_waiter, MSG_OK);
+    osalSysUnlockFromISR();
 }
 
-static void set_led_color_rgb(rgb_led_t color, int pos) {
-    uint8_t* tx_start = &txbuf[PREAMBLE_SIZE];
-
-#if (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_GRB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_RGB)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.r, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.b, j);
-#elif (WS2812_BYTE_ORDER == WS2812_BYTE_ORDER_BGR)
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + j] = get_protocol_eq(color.b, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE + j] = get_protocol_eq(color.g, j);
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 2 + j] = get_protocol_eq(color.r, j);
-#endif
-#ifdef WS2812_RGBW
-    for (int j = 0; j < 4; j++)
-        tx_start[BYTES_FOR_LED * pos + BYTES_FOR_LED_BYTE * 4 + j] = get_protocol_eq(color.w, j);
+#    define WS2812_SPI_END_CB ws2812_spi_end_cb
+#else
+#    define WS2812_SPI_END_CB NULL
 #endif
+
+/*
+ * As the trick here is to use the SPI to send a huge pattern of 0 and 1 to
+ * the ws2812b protocol, each byte is translated into 0s and 1s for the LED
+ * (with the appropriate timing), two bits per SPI byte, most significant first.
+ * A 1 is sent as 0b1110 and a 0 as 0b1000.
+ */
+#define WS2812_SPI_EQ(data, pos) ((((data) & (1 << (2 * (3 - (pos))))) ? 0b00001110 : 0b00001000) | (((data) & (2 << (2 * (3 - (pos))))) ? 0b11100000 : 0b10000000))
+#define WS2812_SPI_ENCODE(data) {WS2812_SPI_EQ(data, 0), WS2812_SPI_EQ(data, 1), WS2812_SPI_EQ(data, 2), WS2812_SPI_EQ(data, 3)}
+#define WS2812_SPI_ENCODE_4(data) WS2812_SPI_ENCODE(data), WS2812_SPI_ENCODE(data + 1), WS2812_SPI_ENCODE(data + 2), WS2812_SPI_ENCODE(data + 3)
+#define WS2812_SPI_ENCODE_16(data) WS2812_SPI_ENCODE_4(data), WS2812_SPI_ENCODE_4(data + 4), WS2812_SPI_ENCODE_4(data + 8), WS2812_SPI_ENCODE_4(data + 12)
+#define WS2812_SPI_ENCODE_64(data) WS2812_SPI_ENCODE_16(data), WS2812_SPI_ENCODE_16(data + 16), WS2812_SPI_ENCODE_16(data + 32), WS2812_SPI_ENCODE_16(data + 48)
+
+static const uint8_t ws2812_spi_encoding[256][BYTES_FOR_LED_BYTE] = {
+    WS2812_SPI_ENCODE_64(0),
+    WS2812_SPI_ENCODE_64(64),
+    WS2812_SPI_ENCODE_64(128),
+    WS2812_SPI_ENCODE_64(192),
+};
+
+static void set_led_color_rgb(uint8_t* buf, rgb_led_t color, int pos) {
+    uint8_t* tx_start = &buf[PREAMBLE_SIZE + BYTES_FOR_LED * pos];
+    // The fields of rgb_led_t are already laid out in WS2812_BYTE_ORDER, with white last
+    const uint8_t* channels = (const uint8_t*)&color;
+
+    for (int c = 0; c < WS2812_CHANNELS; c++) {
+        memcpy(&tx_start[BYTES_FOR_LED_BYTE * c], ws2812_spi_encoding[channels[c]], BYTES_FOR_LED_BYTE);
+    }
 }
 
 void ws2812_init(void) {
+    // Start out with every LED off, rather than with a line held low
+    rgb_led_t off = {0};
+    for (uint8_t b = 0; b < WS2812_SPI_BUFFER_COUNT; b++) {
+        for (uint16_t i = 0; i < WS2812_LED_COUNT; i++) {
+            set_led_color_rgb(txbuf[b], off, i);
+            txbuf_leds[b][i] = off;
+        }
+    }
+
     palSetLineMode(WS2812_DI_PIN, WS2812_MOSI_OUTPUT_MODE);
 
 #ifdef WS2812_SPI_SCK_PIN
@@ -151,7 +172,7 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_CIRCULAR == TRUE
         WS2812_SPI_BUFFER_MODE,
 #    endif
-        NULL, // end_cb
+        WS2812_SPI_END_CB, // end_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
 #    if defined(WB32F3G71xx) || defined(WB32FQ95xx)
@@ -170,8 +191,8 @@ void ws2812_init(void) {
 #    if SPI_SUPPORTS_SLAVE_MODE == TRUE
         false,
 #    endif
-        NULL, // data_cb
-        NULL, // error_cb
+        WS2812_SPI_END_CB, // data_cb
+        WS2812_SPI_END_CB, // error_cb
         PAL_PORT(WS2812_DI_PIN),
         PAL_PAD(WS2812_DI_PIN),
         WS2812_SPI_DIVISOR_CR1_BR_X,
@@ -183,22 +204,42 @@ void ws2812_init(void) {
     spiStart(&WS2812_SPI_DRIVER, &spicfg); /* Setup transfer parameters.       */
     spiSelect(&WS2812_SPI_DRIVER);         /* Slave Select assertion.          */
 #ifdef WS2812_SPI_USE_CIRCULAR_BUFFER
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), txbuf[0]);
 #endif
 }
 
 void ws2812_setleds(rgb_led_t* ledarray, uint16_t leds) {
-    for (uint8_t i = 0; i < leds; i++) {
-        set_led_color_rgb(ledarray[i], i);
+    uint8_t*   buf     = txbuf[txbuf_back];
+    rgb_led_t* encoded = txbuf_leds[txbuf_back];
+
+    for (uint16_t i = 0; i < leds; i++) {
+        if (memcmp(&encoded[i], &ledarray[i], sizeof(rgb_led_t)) != 0) {
+            set_led_color_rgb(buf, ledarray[i], i);
+            encoded[i] = ledarray[i];
+        }
     }
 
     // Send async - each led takes ~0.03ms, 50 leds ~1.5ms, animations flushing faster than send will cause issues.
     // Instead spiSend can be used to send synchronously (or the thread logic can be added back).
 #ifndef WS2812_SPI_USE_CIRCULAR_BUFFER
 #    ifdef WS2812_SPI_SYNC
-    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+    spiSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), buf);
 #    else
-    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf), txbuf);
+#        ifdef WS2812_SPI_DOUBLE_BUFFER
+    // The previous frame has had the whole time spent encoding this one to go out, and
+    // its buffer is only written to again once this one has started sending
+    osalSysLock();
+    while (txbuf_sending) {
+        osalThreadSuspendS(&txbuf_waiter);
+    }
+    txbuf_sending = true;
+    osalSysUnlock();
+#        endif
+    spiStartSend(&WS2812_SPI_DRIVER, ARRAY_SIZE(txbuf[0]), buf);
 #    endif
 #endif
+
+#ifdef WS2812_SPI_DOUBLE_BUFFER
+    txbuf_back ^= 1;
+#endif
 }
@@ -1,8 +1,10 @@
 #include <limits.h>
 #include <stdint.h>
+#include <string.h>
 
 #include "keyboard.h"
 #include "action.h"
+#include "keymap_common.h"
 #include "encoder.h"
 #include "util.h"
 #include "action_layer.h"
@@ -289,6 +291,55 @@ uint8_t read_source_layers_cache(keypos_t key) {
 }
 #endif
 
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_LAYERS_CACHE)
+/** \brief effective layers cache
+ *
+ * Topmost non-transparent layer of each key and its keycode for the layers in
+ * effective_layers_cache_state. The layer is stored as layer + 1 so 0 marks
+ * entries that still need to be resolved.
+ */
+typedef struct {
+    uint16_t keycode;
+    uint8_t  layer;
+} effective_layers_cache_entry_t;
+
+static effective_layers_cache_entry_t effective_layers_cache[MATRIX_ROWS][MATRIX_COLS] = {{{0}}};
+static layer_state_t                  effective_layers_cache_state                     = 0;
+
+/** \brief clear effective layers cache
+ *
+ * Forgets all resolved keys, needs to be called whenever the keymap contents change
+ */
+void clear_effective_layers_cache(void) {
+    memset(effective_layers_cache, 0, sizeof(effective_layers_cache));
+}
+
+/** \brief update effective layers cache
+ *
+ * Forgets the keys whose resolved layer may differ in the new layer state: those
+ * resolved to a layer that was turned off, or below a layer that was turned on.
+ * Layers turned off above a resolved layer were transparent for that key, and
+ * layers below it are never reached, so the other keys are kept.
+ */
+static void update_effective_layers_cache(layer_state_t layers) {
+    const layer_state_t turned_on  = layers & ~effective_layers_cache_state;
+    const layer_state_t turned_off = effective_layers_cache_state & ~layers;
+    // entries resolved below this layer are shadowed by a newly enabled layer
+    const uint8_t shadowed_below = turned_on ? get_highest_layer(turned_on) + 1 : 0;
+
+    effective_layers_cache_state = layers;
+
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            effective_layers_cache_entry_t *entry = &effective_layers_cache[row][col];
+            if (entry->layer && (entry->layer < shadowed_below || (turned_off & ((layer_state_t)1 << (entry->layer - 1))))) {
+                entry->layer = 0;
+            }
+        }
+    }
+}
+#endif
+
 /** \brief Store or get action (FIXME: Needs better summary)
  *
  * Make sure the action triggered when the key is released is the same
@@ -305,41 +356,84 @@ action_t store_or_get_action(bool pressed, keypos_t key) {
     uint8_t layer;
 
     if (pressed) {
-        layer = layer_switch_get_layer(key);
+        uint16_t keycode = layer_switch_get_keycode(key, &layer);
         update_source_layers_cache(key, layer);
-    } else {
-        layer = read_source_layers_cache(key);
+        return action_for_keycode(keycode);
     }
+    layer = read_source_layers_cache(key);
     return action_for_key(layer, key);
 #else
     return layer_switch_get_action(key);
 #endif
 }
 
-/** \brief Layer switch get layer
+/** \brief Layer switch get keycode
  *
- * Gets the layer based on key info
+ * Gets the keycode of the key on its topmost non-transparent layer, and that
+ * layer if layer isn't NULL
  */
-uint8_t layer_switch_get_layer(keypos_t key) {
+uint16_t layer_switch_get_keycode(keypos_t key, uint8_t *layer) {
 #ifndef NO_ACTION_LAYER
-    action_t action;
-    action.code = ACTION_TRANSPARENT;
-
     layer_state_t layers = layer_state | default_layer_state;
+#    ifdef EFFECTIVE_LAYERS_CACHE
+    effective_layers_cache_entry_t *cached = NULL;
+    if (key.row < MATRIX_ROWS && key.col < MATRIX_COLS) {
+        /* layer state may also be assigned directly, e.g. on split halves, so
+         * compare against the state the cache was resolved for */
+        if (layers != effective_layers_cache_state) {
+            update_effective_layers_cache(layers);
+        }
+        cached = &effective_layers_cache[key.row][key.col];
+        if (cached->layer) {
+            if (layer) {
+                *layer = cached->layer - 1;
+            }
+            return cached->keycode;
+        }
+    }
+#    endif
+    /* fall back to layer 0 */
+    uint8_t  found   = 0;
+    uint16_t keycode = KC_NO;
+    bool     matched = false;
     /* check top layer first */
     for (int8_t i = MAX_LAYER - 1; i >= 0; i--) {
         if (layers & ((layer_state_t)1 << i)) {
-            action = action_for_key(i, key);
-            if (action.code != ACTION_TRANSPARENT) {
-                return i;
+            keycode = keymap_key_to_keycode(i, key);
+            if (action_for_keycode(keycode).code != ACTION_TRANSPARENT) {
+                found   = i;
+                matched = true;
+                break;
             }
         }
     }
-    /* fall back to layer 0 */
-    return 0;
+    if (!matched) {
+        keycode = keymap_key_to_keycode(0, key);
+    }
+#    ifdef EFFECTIVE_LAYERS_CACHE
+    if (cached) {
+        cached->keycode = keycode;
+        cached->layer   = found + 1;
+    }
+#    endif
 #else
-    return get_highest_layer(default_layer_state);
+    uint8_t  found   = get_highest_layer(default_layer_state);
+    uint16_t keycode = keymap_key_to_keycode(found, key);
 #endif
+    if (layer) {
+        *layer = found;
+    }
+    return keycode;
+}
+
+/** \brief Layer switch get layer
+ *
+ * Gets the layer based on key info
+ */
+uint8_t layer_switch_get_layer(keypos_t key) {
+    uint8_t layer;
+    layer_switch_get_keycode(key, &layer);
+    return layer;
 }
 
 /** \brief Layer switch get layer
@@ -347,7 +441,7 @@ uint8_t layer_switch_get_layer(keypos_t key) {
  * Gets action code based on key position
  */
 action_t layer_switch_get_action(keypos_t key) {
-    return action_for_key(layer_switch_get_layer(key), key);
+    return action_for_keycode(layer_switch_get_keycode(key, NULL));
 }
 
 #ifndef NO_ACTION_LAYER
@@ -163,6 +163,14 @@ uint8_t read_source_layers_cache(keypos_t key);
 #endif
 action_t store_or_get_action(bool pressed, keypos_t key);
 
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_LAYERS_CACHE)
+/* forget the resolved layer of every key, call after changing the keymap */
+void clear_effective_layers_cache(void);
+#endif
+
+/* return the keycode of key on the topmost non-transparent layer, and that layer if layer isn't NULL */
+uint16_t layer_switch_get_keycode(keypos_t key, uint8_t *layer);
+
 /* return the topmost non-transparent layer currently associated with key */
 uint8_t layer_switch_get_layer(keypos_t key);
 
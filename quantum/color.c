@@ -109,6 +109,71 @@ RGB hsv_to_rgb_nocie(HSV hsv) {
     return hsv_to_rgb_impl(hsv, false);
 }
 
+// Which of v, q, t and p goes to red, green and blue, by hue region
+static const uint8_t hsv_region_channels[7][3] PROGMEM = {
+    {0, 2, 3}, {1, 0, 3}, {3, 0, 2}, {3, 1, 0}, {2, 3, 0}, {0, 3, 1}, {0, 2, 3},
+};
+
+static void hsv_to_rgb_batch_impl(const HSV *hsv, RGB *rgb, uint16_t count, bool use_cie) {
+    for (uint16_t i = 0; i < count; i++) {
+        // Effects often hand over runs of the same color
+        if (i > 0 && hsv[i].h == hsv[i - 1].h && hsv[i].s == hsv[i - 1].s && hsv[i].v == hsv[i - 1].v) {
+            rgb[i] = rgb[i - 1];
+            continue;
+        }
+
+        uint8_t s = hsv[i].s;
+        uint8_t v = hsv[i].v;
+#ifdef USE_CIE1931_CURVE
+        if (use_cie) {
+            v = pgm_read_byte(&CIE1931_CURVE[v]);
+        }
+#endif
+
+        if (s == 0) {
+            rgb[i].r = v;
+            rgb[i].g = v;
+            rgb[i].b = v;
+            continue;
+        }
+
+        // h * 6 / 255, without the division
+        uint16_t x         = hsv[i].h * 6;
+        uint8_t  region    = (x + 1 + (x >> 8)) >> 8;
+        uint8_t  remainder = (hsv[i].h * 2 - region * 85) * 3;
+
+        uint8_t vqtp[4];
+        vqtp[0] = v;
+        vqtp[3] = (v * (255 - s)) >> 8;
+#if defined(__AVR__)
+        vqtp[1] = (v * (255 - ((s * remainder) >> 8))) >> 8;
+        vqtp[2] = (v * (255 - ((s * (255 - remainder)) >> 8))) >> 8;
+#else
+        // q and t side by side in the two 16-bit halves, neither of which can overflow into the other
+        uint32_t st = (uint32_t)s * (remainder | (uint32_t)(255 - remainder) << 16);
+        uint32_t vt = (uint32_t)v * ((255 - ((st >> 8) & 0xFF)) | (uint32_t)(255 - (st >> 24)) << 16);
+        vqtp[1]     = vt >> 8;
+        vqtp[2]     = vt >> 24;
+#endif
+
+        rgb[i].r = vqtp[pgm_read_byte(&hsv_region_channels[region][0])];
+        rgb[i].g = vqtp[pgm_read_byte(&hsv_region_channels[region][1])];
+        rgb[i].b = vqtp[pgm_read_byte(&hsv_region_channels[region][2])];
+    }
+}
+
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+#ifdef USE_CIE1931_CURVE
+    hsv_to_rgb_batch_impl(hsv, rgb, count, true);
+#else
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+#endif
+}
+
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint16_t count) {
+    hsv_to_rgb_batch_impl(hsv, rgb, count, false);
+}
+
 #ifdef WS2812_RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led) {
     // Determine lowest value in all three colors, put that into
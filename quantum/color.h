@@ -111,6 +111,9 @@ typedef struct PACKED HSV {
 
 RGB hsv_to_rgb(HSV hsv);
 RGB hsv_to_rgb_nocie(HSV hsv);
+// Convert a whole array at once, with the same results as hsv_to_rgb() and hsv_to_rgb_nocie()
+void hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint16_t count);
+void hsv_to_rgb_nocie_batch(const HSV *hsv, RGB *rgb, uint16_t count);
 #ifdef WS2812_RGBW
 void convert_rgb_to_rgbw(rgb_led_t *led);
 #endif
@@ -0,0 +1,167 @@
+/*
+Copyright 2026 QMK
+This program is free software: you can redistribute it and/or modify
+it under the terms of the GNU General Public License as published by
+the Free Software Foundation, either version 2 of the License, or
+(at your option) any later version.
+This program is distributed in the hope that it will be useful,
+but WITHOUT ANY WARRANTY; without even the implied warranty of
+MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+GNU General Public License for more details.
+You should have received a copy of the GNU General Public License
+along with this program.  If not, see <http://www.gnu.org/licenses/>.
+*/
+
+/*
+Sparse symmetric per-key algorithm, behaves like sym_defer_pk.
+Only the keys that are currently bouncing are kept in a small list together with their 8-bit counter,
+so the cost of a scan scales with the number of keys in flight rather than the size of the matrix.
+When no state changes have occured for DEBOUNCE milliseconds, we push the state.
+*/
+
+#include "debounce.h"
+#include "timer.h"
+
+#ifndef DEBOUNCE
+#    define DEBOUNCE 5
+#endif
+
+// Maximum debounce: 255ms
+#if DEBOUNCE > UINT8_MAX
+#    undef DEBOUNCE
+#    define DEBOUNCE UINT8_MAX
+#endif
+
+// Maximum number of keys debounced at the same time, further keys wait for a free slot
+#ifndef DEBOUNCE_SPARSE_MAX_KEYS
+#    define DEBOUNCE_SPARSE_MAX_KEYS 16
+#endif
+
+#if DEBOUNCE_SPARSE_MAX_KEYS > UINT8_MAX
+#    error DEBOUNCE_SPARSE_MAX_KEYS must not exceed 255
+#endif
+
+#define ROW_SHIFTER ((matrix_row_t)1)
+
+typedef uint8_t debounce_counter_t;
+
+typedef struct {
+    uint8_t            row;
+    uint8_t            col;
+    debounce_counter_t counter;
+} debounce_key_t;
+
+#if DEBOUNCE > 0
+static debounce_key_t debounce_keys[DEBOUNCE_SPARSE_MAX_KEYS];
+static uint8_t        debounce_key_count;
+static matrix_row_t   debounce_key_mask[MATRIX_ROWS];
+static fast_timer_t   last_time;
+static bool           keys_overflowed;
+static bool           cooked_changed;
+
+static void update_debounce_keys_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time);
+static void start_debounce_keys(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows);
+
+// we use num_rows rather than MATRIX_ROWS to support split keyboards
+void debounce_init(uint8_t num_rows) {
+    debounce_key_count = 0;
+    keys_overflowed    = false;
+    for (uint8_t r = 0; r < MATRIX_ROWS; r++) {
+        debounce_key_mask[r] = 0;
+    }
+}
+
+void debounce_free(void) {
+    debounce_key_count = 0;
+}
+
+bool debounce(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows, bool changed) {
+    bool updated_last = false;
+    cooked_changed    = false;
+
+    if (debounce_key_count > 0) {
+        fast_timer_t now          = timer_read_fast();
+        fast_timer_t elapsed_time = TIMER_DIFF_FAST(now, last_time);
+
+        last_time    = now;
+        updated_last = true;
+        if (elapsed_time > UINT8_MAX) {
+            elapsed_time = UINT8_MAX;
+        }
+
+        if (elapsed_time > 0) {
+            update_debounce_keys_and_transfer_if_expired(raw, cooked, elapsed_time);
+        }
+    }
+
+    // Keys that didn't fit into the list are picked up again once slots are freed
+    if (changed || keys_overflowed) {
+        if (!updated_last) {
+            last_time = timer_read_fast();
+        }
+
+        start_debounce_keys(raw, cooked, num_rows);
+    }
+
+    return cooked_changed;
+}
+
+static void update_debounce_keys_and_transfer_if_expired(matrix_row_t raw[], matrix_row_t cooked[], uint8_t elapsed_time) {
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < debounce_key_count; i++) {
+        debounce_key_t key = debounce_keys[i];
+
+        if (key.counter <= elapsed_time) {
+            matrix_row_t col_mask    = ROW_SHIFTER << key.col;
+            matrix_row_t cooked_next = (cooked[key.row] & ~col_mask) | (raw[key.row] & col_mask);
+            cooked_changed |= cooked[key.row] ^ cooked_next;
+            cooked[key.row] = cooked_next;
+            debounce_key_mask[key.row] &= ~col_mask;
+        } else {
+            key.counter -= elapsed_time;
+            debounce_keys[kept++] = key;
+        }
+    }
+    debounce_key_count = kept;
+}
+
+static void start_debounce_keys(matrix_row_t raw[], matrix_row_t cooked[], uint8_t num_rows) {
+    // Stop debouncing keys that went back to their debounced state
+    uint8_t kept = 0;
+    for (uint8_t i = 0; i < debounce_key_count; i++) {
+        debounce_key_t key      = debounce_keys[i];
+        matrix_row_t   col_mask = ROW_SHIFTER << key.col;
+
+        if ((raw[key.row] ^ cooked[key.row]) & col_mask) {
+            debounce_keys[kept++] = key;
+        } else {
+            debounce_key_mask[key.row] &= ~col_mask;
+        }
+    }
+    debounce_key_count = kept;
+    keys_overflowed    = false;
+
+    for (uint8_t row = 0; row < num_rows; row++) {
+        matrix_row_t delta = (raw[row] ^ cooked[row]) & ~debounce_key_mask[row];
+
+        while (delta) {
+            if (debounce_key_count >= DEBOUNCE_SPARSE_MAX_KEYS) {
+                keys_overflowed = true;
+                return;
+            }
+
+            uint8_t col                         = __builtin_ctzl(delta);
+            debounce_keys[debounce_key_count++] = (debounce_key_t){
+                .row     = row,
+                .col     = col,
+                .counter = DEBOUNCE,
+            };
+            debounce_key_mask[row] |= ROW_SHIFTER << col;
+            delta &= delta - 1;
+        }
+    }
+}
+
+#else
+#    include "none.c"
+#endif
@@ -0,0 +1,67 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+
+extern "C" {
+#include "debounce.h"
+#include "timer.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+/* Scan at 1kHz while one key at a time changes state and bounces, as during typing */
+TEST(DebounceBenchmark, TypingOnLargeMatrix) {
+    matrix_row_t raw[MATRIX_ROWS]    = {0};
+    matrix_row_t cooked[MATRIX_ROWS] = {0};
+    const int    scans               = 200000;
+    int          cooked_changes      = 0;
+
+    debounce_init(MATRIX_ROWS);
+    set_time(7777);
+
+    const auto start = std::chrono::steady_clock::now();
+    for (int scan = 0; scan < scans; scan++) {
+        const int  key     = (scan / 20) % (MATRIX_ROWS * MATRIX_COLS);
+        const bool changed = scan % 20 < 3;
+
+        /* Flip the key three times over three scans: change, bounce back, settle */
+        if (changed) {
+            raw[key / MATRIX_COLS] ^= (matrix_row_t)1 << (key % MATRIX_COLS);
+        }
+
+        cooked_changes += debounce(raw, cooked, MATRIX_ROWS, changed);
+        advance_time(1);
+    }
+    const std::chrono::duration<double, std::nano> elapsed = std::chrono::steady_clock::now() - start;
+
+    /* Let the last key settle */
+    for (int scan = 0; scan < 300; scan++) {
+        debounce(raw, cooked, MATRIX_ROWS, false);
+        advance_time(1);
+    }
+    debounce_free();
+
+    std::cout << "[ BENCH    ] " << DEBOUNCE_ALGORITHM << ": " << elapsed.count() / scans << " ns/scan (" << MATRIX_ROWS << "x" << MATRIX_COLS << " matrix, " << cooked_changes << " cooked changes)" << std::endl;
+
+    EXPECT_GT(cooked_changes, 0);
+    EXPECT_TRUE(std::equal(std::begin(raw), std::end(raw), std::begin(cooked)));
+}
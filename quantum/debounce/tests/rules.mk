@@ -52,3 +52,20 @@ debounce_asym_eager_defer_pk_DEFS := $(DEBOUNCE_COMMON_DEFS)
 debounce_asym_eager_defer_pk_SRC := $(DEBOUNCE_COMMON_SRC) \
 	$(QUANTUM_PATH)/debounce/asym_eager_defer_pk.c \
 	$(QUANTUM_PATH)/debounce/tests/asym_eager_defer_pk_tests.cpp
+
+debounce_sym_defer_pk_sparse_DEFS := $(DEBOUNCE_COMMON_DEFS) -DDEBOUNCE_SPARSE_MAX_KEYS=4
+debounce_sym_defer_pk_sparse_SRC := $(DEBOUNCE_COMMON_SRC) \
+	$(QUANTUM_PATH)/debounce/sym_defer_pk_sparse.c \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_tests.cpp \
+	$(QUANTUM_PATH)/debounce/tests/sym_defer_pk_sparse_tests.cpp
+
+# Timing comparison of all algorithms on a large matrix
+DEBOUNCE_BENCHMARK_ALGORITHMS := none sym_defer_g sym_defer_pk sym_defer_pr sym_eager_pk sym_eager_pr asym_eager_defer_pk sym_defer_pk_sparse
+
+define DEBOUNCE_BENCHMARK
+debounce_benchmark_$1_DEFS := -DMATRIX_ROWS=24 -DMATRIX_COLS=24 -DDEBOUNCE=5 -DDEBOUNCE_ALGORITHM=\"$1\"
+debounce_benchmark_$1_SRC := $(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/debounce/$1.c \
+	$(QUANTUM_PATH)/debounce/tests/debounce_benchmark.cpp
+endef
+$(foreach ALGORITHM,$(DEBOUNCE_BENCHMARK_ALGORITHMS),$(eval $(call DEBOUNCE_BENCHMARK,$(ALGORITHM))))
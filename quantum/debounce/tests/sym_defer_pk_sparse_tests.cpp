@@ -0,0 +1,68 @@
+/* Copyright 2026 QMK
+ *
+ * This program is free software: you can redistribute it and/or modify
+ * it under the terms of the GNU General Public License as published by
+ * the Free Software Foundation, either version 2 of the License, or
+ * (at your option) any later version.
+ *
+ * This program is distributed in the hope that it will be useful,
+ * but WITHOUT ANY WARRANTY; without even the implied warranty of
+ * MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ * GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License
+ * along with this program.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "gtest/gtest.h"
+
+#include "debounce_test_common.h"
+
+/* These tests expect DEBOUNCE_SPARSE_MAX_KEYS to be 4, the sym_defer_pk tests cover everything else */
+
+TEST_F(DebounceTest, SparseAllSlotsUsed) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}}, {}},
+
+        {5, {}, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, SparseOverflowWaitsForFreeSlots) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}, {3, 5, DOWN}, {3, 6, DOWN}}, {}},
+
+        /* Keys that didn't fit start debouncing once the first ones are done */
+        {5, {}, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}}},
+        {10, {}, {{3, 5, DOWN}, {3, 6, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, SparseOverflowKeyBouncesBack) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}, {3, 5, DOWN}}, {}},
+        /* Untracked key goes back up before a slot is free */
+        {2, {{3, 5, UP}}, {}},
+
+        {5, {}, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}}},
+    });
+    runEvents();
+}
+
+TEST_F(DebounceTest, SparseSlotFreedByBounce) {
+    addEvents({
+        /* Time, Inputs, Outputs */
+        {0, {{0, 1, DOWN}, {0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}, {3, 5, DOWN}}, {}},
+        /* Tracked key bounces back up, freeing a slot for the waiting key */
+        {2, {{0, 1, UP}}, {}},
+
+        {5, {}, {{0, 2, DOWN}, {1, 3, DOWN}, {2, 4, DOWN}}},
+        {7, {}, {{3, 5, DOWN}}},
+    });
+    runEvents();
+}
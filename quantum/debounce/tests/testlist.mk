@@ -5,4 +5,18 @@ TEST_LIST += \
 	debounce_sym_defer_pr \
 	debounce_sym_eager_pk \
 	debounce_sym_eager_pr \
-	debounce_asym_eager_defer_pk
+	debounce_asym_eager_defer_pk \
+	debounce_sym_defer_pk_sparse
+
+# Timing comparison of all algorithms, only built and run with BENCHMARK=yes
+ifeq ($(strip $(BENCHMARK)), yes)
+TEST_LIST += \
+	debounce_benchmark_none \
+	debounce_benchmark_sym_defer_g \
+	debounce_benchmark_sym_defer_pk \
+	debounce_benchmark_sym_defer_pr \
+	debounce_benchmark_sym_eager_pk \
+	debounce_benchmark_sym_eager_pr \
+	debounce_benchmark_asym_eager_defer_pk \
+	debounce_benchmark_sym_defer_pk_sparse
+endif
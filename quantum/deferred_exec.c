@@ -9,27 +9,107 @@
 #    define MAX_DEFERRED_EXECUTORS 8
 #endif
 
+_Static_assert(MAX_DEFERRED_EXECUTORS <= UINT8_MAX, "MAX_DEFERRED_EXECUTORS must be at most 255");
+
 //------------------------------------
 // Helpers
 //
+// Tables are kept as a binary min-heap on trigger time: the active executors occupy the start of the table, with the
+// earliest one first. Finding out whether anything is due is constant time, queueing and firing logarithmic in the
+// number of executors.
+//
 
 static deferred_token current_token = 0;
 
-static inline bool token_can_be_used(deferred_executor_t *table, size_t table_count, deferred_token token) {
+static inline bool trigger_before(uint32_t a, uint32_t b) {
+    return ((int32_t)TIMER_DIFF_32(a, b)) < 0;
+}
+
+// The number of active executors, which are contiguous at the start of the table
+static size_t heap_size(deferred_executor_t *table, size_t table_count) {
+    size_t lo = 0, hi = table_count;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (table[mid].token != INVALID_DEFERRED_TOKEN) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+
+static void heap_swap(deferred_executor_t *table, size_t a, size_t b) {
+    deferred_executor_t tmp = table[a];
+    table[a]                = table[b];
+    table[b]                = tmp;
+}
+
+static void heap_sift_up(deferred_executor_t *table, size_t pos) {
+    while (pos > 0) {
+        size_t parent = (pos - 1) / 2;
+        if (!trigger_before(table[pos].trigger_time, table[parent].trigger_time)) {
+            break;
+        }
+        heap_swap(table, pos, parent);
+        pos = parent;
+    }
+}
+
+static void heap_sift_down(deferred_executor_t *table, size_t size, size_t pos) {
+    while (true) {
+        size_t earliest = pos;
+        size_t left     = pos * 2 + 1;
+        size_t right    = left + 1;
+        if (left < size && trigger_before(table[left].trigger_time, table[earliest].trigger_time)) {
+            earliest = left;
+        }
+        if (right < size && trigger_before(table[right].trigger_time, table[earliest].trigger_time)) {
+            earliest = right;
+        }
+        if (earliest == pos) {
+            break;
+        }
+        heap_swap(table, pos, earliest);
+        pos = earliest;
+    }
+}
+
+static void heap_remove(deferred_executor_t *table, size_t table_count, size_t pos) {
+    size_t last = heap_size(table, table_count) - 1;
+    if (pos != last) {
+        heap_swap(table, pos, last);
+    }
+
+    table[last].token        = INVALID_DEFERRED_TOKEN;
+    table[last].trigger_time = 0;
+    table[last].callback     = NULL;
+    table[last].cb_arg       = NULL;
+
+    if (pos < last) {
+        heap_sift_down(table, last, pos);
+        heap_sift_up(table, pos);
+    }
+}
+
+// Returns the position of the executor for the token, or table_count if there is none
+static size_t heap_find(deferred_executor_t *table, size_t table_count, deferred_token token) {
     if (token == INVALID_DEFERRED_TOKEN) {
-        return false;
+        return table_count;
     }
-    for (int i = 0; i < table_count; ++i) {
-        if (table[i].token == token) {
-            return false;
+    size_t size = heap_size(table, table_count);
+    for (size_t pos = 0; pos < size; ++pos) {
+        if (table[pos].token == token) {
+            return pos;
         }
     }
-    return true;
+    return table_count;
 }
 
-static inline deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
+// Tokens cycle through every valid value, skipping those still in use
+static deferred_token allocate_token(deferred_executor_t *table, size_t table_count) {
     deferred_token first = ++current_token;
-    while (!token_can_be_used(table, table_count, current_token)) {
+    while (current_token == INVALID_DEFERRED_TOKEN || heap_find(table, table_count, current_token) != table_count) {
         ++current_token;
         if (current_token == first) {
             // If we've looped back around to the first, everything is already allocated (yikes!). Need to exit with a failure.
@@ -45,31 +125,31 @@ static inline deferred_token allocate_token(deferred_executor_t *table, size_t t
 
 deferred_token defer_exec_advanced(deferred_executor_t *table, size_t table_count, uint32_t delay_ms, deferred_exec_callback callback, void *cb_arg) {
     // Ignore queueing if the table isn't valid, it's a zero-time delay, or the token is not valid
-    if (!table || table_count == 0 || delay_ms == 0 || !callback) {
+    if (!table || table_count == 0 || table_count > UINT8_MAX || delay_ms == 0 || !callback) {
         return INVALID_DEFERRED_TOKEN;
     }
 
-    // Find an unused slot and claim it
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == INVALID_DEFERRED_TOKEN) {
-            // Work out the new token value, dropping out if none were available
-            deferred_token token = allocate_token(table, table_count);
-            if (token == INVALID_DEFERRED_TOKEN) {
-                return false;
-            }
-
-            // Set up the executor table entry
-            entry->token        = current_token;
-            entry->trigger_time = timer_read32() + delay_ms;
-            entry->callback     = callback;
-            entry->cb_arg       = cb_arg;
-            return current_token;
-        }
+    // Claim the first unused entry, dropping out if none were available
+    size_t pos = heap_size(table, table_count);
+    if (pos == table_count) {
+        return INVALID_DEFERRED_TOKEN;
+    }
+
+    // Work out the new token value, dropping out if none were available
+    deferred_token token = allocate_token(table, table_count);
+    if (token == INVALID_DEFERRED_TOKEN) {
+        return INVALID_DEFERRED_TOKEN;
     }
 
-    // None available
-    return INVALID_DEFERRED_TOKEN;
+    // Set up the executor table entry
+    deferred_executor_t *entry = &table[pos];
+    entry->token               = token;
+    entry->trigger_time        = timer_read32() + delay_ms;
+    entry->callback            = callback;
+    entry->cb_arg              = cb_arg;
+
+    heap_sift_up(table, pos);
+    return token;
 }
 
 bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token, uint32_t delay_ms) {
@@ -79,17 +159,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, extend the delay
-            entry->trigger_time = timer_read32() + delay_ms;
-            return true;
-        }
+    size_t pos = heap_find(table, table_count, token);
+    if (pos == table_count) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, extend the delay and move it to its new place in the heap
+    table[pos].trigger_time = timer_read32() + delay_ms;
+    heap_sift_down(table, heap_size(table, table_count), pos);
+    heap_sift_up(table, pos);
+    return true;
 }
 
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token) {
@@ -99,59 +178,90 @@ bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
     }
 
     // Find the entry corresponding to the token
-    for (int i = 0; i < table_count; ++i) {
-        deferred_executor_t *entry = &table[i];
-        if (entry->token == token) {
-            // Found it, cancel and clear the table entry
-            entry->token        = INVALID_DEFERRED_TOKEN;
-            entry->trigger_time = 0;
-            entry->callback     = NULL;
-            entry->cb_arg       = NULL;
-            return true;
-        }
+    size_t pos = heap_find(table, table_count, token);
+    if (pos == table_count) {
+        return false;
     }
 
-    // Not found
-    return false;
+    // Found it, cancel and clear the table entry
+    heap_remove(table, table_count, pos);
+    return true;
+}
+
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time) {
+    if (!table || table_count == 0 || table[0].token == INVALID_DEFERRED_TOKEN) {
+        return false;
+    }
+    *trigger_time = table[0].trigger_time;
+    return true;
+}
+
+// Returns the position of the earliest executor due at `now` that hasn't fired yet in this pass, or table_count
+static size_t next_due(deferred_executor_t *table, size_t table_count, uint32_t now, const uint8_t *fired) {
+    size_t size     = heap_size(table, table_count);
+    size_t earliest = table_count;
+    for (size_t pos = 0; pos < size; ++pos) {
+        deferred_token token = table[pos].token;
+        if (((int32_t)TIMER_DIFF_32(table[pos].trigger_time, now)) > 0 || (fired[token / 8] & (1 << (token % 8)))) {
+            continue;
+        }
+        if (earliest == table_count || trigger_before(table[pos].trigger_time, table[earliest].trigger_time)) {
+            earliest = pos;
+        }
+    }
+    return earliest;
 }
 
 void deferred_exec_advanced_task(deferred_executor_t *table, size_t table_count, uint32_t *last_execution_time) {
+    // Ignore the request if the table isn't valid
+    if (!table || table_count == 0) {
+        return;
+    }
+
     uint32_t now = timer_read32();
 
     // Throttle only once per millisecond
-    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) > 0) {
-        *last_execution_time = now;
-
-        // Run through each of the executors
-        for (int i = 0; i < table_count; ++i) {
-            deferred_executor_t *entry      = &table[i];
-            deferred_token       curr_token = entry->token;
-
-            // Check if we're supposed to execute this entry
-            if (curr_token != INVALID_DEFERRED_TOKEN && ((int32_t)TIMER_DIFF_32(entry->trigger_time, now)) <= 0) {
-                // Invoke the callback and work work out if we should be requeued
-                uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
-
-                // If the token has changed, then the callback has canceled and re-queued. Skip further processing.
-                if (entry->token != curr_token) {
-                    continue;
-                }
-
-                // Update the trigger time if we have to repeat, otherwise clear it out
-                if (delay_ms > 0) {
-                    // Intentionally add just the delay to the existing trigger time -- this ensures the next
-                    // invocation is with respect to the previous trigger, rather than when it got to execution. Under
-                    // normal circumstances this won't cause issue, but if another executor is invoked that takes a
-                    // considerable length of time, then this ensures best-effort timing between invocations.
-                    entry->trigger_time += delay_ms;
-                } else {
-                    // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
-                    entry->token        = INVALID_DEFERRED_TOKEN;
-                    entry->trigger_time = 0;
-                    entry->callback     = NULL;
-                    entry->cb_arg       = NULL;
-                }
-            }
+    if (((int32_t)TIMER_DIFF_32(now, (*last_execution_time))) <= 0) {
+        return;
+    }
+    *last_execution_time = now;
+
+    // Nothing due, the earliest executor is at the top of the heap
+    if (table[0].token == INVALID_DEFERRED_TOKEN || ((int32_t)TIMER_DIFF_32(table[0].trigger_time, now)) > 0) {
+        return;
+    }
+
+    // Run through the due executors, earliest first. Each one fires at most once per pass, even when repeating with a
+    // delay shorter than the time since its last trigger, so that it catches up over the following passes instead of
+    // holding up the main loop.
+    uint8_t fired[(UINT8_MAX + 1) / 8] = {0};
+    size_t  pos;
+    while ((pos = next_due(table, table_count, now, fired)) != table_count) {
+        deferred_executor_t *entry = &table[pos];
+
+        // Invoke the callback and work work out if we should be requeued
+        deferred_token curr_token = entry->token;
+        fired[curr_token / 8] |= 1 << (curr_token % 8);
+        uint32_t delay_ms = entry->callback(entry->trigger_time, entry->cb_arg);
+
+        // The callback may have queued, extended or cancelled executors, moving this one. If it can't be found, it
+        // was cancelled by the callback. Skip further processing.
+        pos = heap_find(table, table_count, curr_token);
+        if (pos == table_count) {
+            continue;
+        }
+
+        // Update the trigger time if we have to repeat, otherwise clear it out
+        if (delay_ms > 0) {
+            // Intentionally add just the delay to the existing trigger time -- this ensures the next
+            // invocation is with respect to the previous trigger, rather than when it got to execution. Under
+            // normal circumstances this won't cause issue, but if another executor is invoked that takes a
+            // considerable length of time, then this ensures best-effort timing between invocations.
+            table[pos].trigger_time += delay_ms;
+            heap_sift_down(table, heap_size(table, table_count), pos);
+        } else {
+            // If it was zero, then the callback is cancelling repeated execution. Free up the slot.
+            heap_remove(table, table_count, pos);
         }
     }
 }
@@ -172,6 +282,9 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms) {
 bool cancel_deferred_exec(deferred_token token) {
     return cancel_deferred_exec_advanced(basic_executors, MAX_DEFERRED_EXECUTORS, token);
 }
+bool deferred_exec_next_trigger(uint32_t *trigger_time) {
+    return deferred_exec_advanced_next_trigger(basic_executors, MAX_DEFERRED_EXECUTORS, trigger_time);
+}
 void deferred_exec_task(void) {
     deferred_exec_advanced_task(basic_executors, MAX_DEFERRED_EXECUTORS, &last_deferred_exec_check);
 }
@@ -60,6 +60,14 @@ bool extend_deferred_exec(deferred_token token, uint32_t delay_ms);
  */
 bool cancel_deferred_exec(deferred_token token);
 
+/**
+ * Retrieves the time the next deferred execution is due at, allowing for the main loop to skip or sleep until then.
+ *
+ * @param trigger_time[out] the time the earliest deferred execution is due at -- equivalent time-space as timer_read32()
+ * @return true if any deferred execution is queued, otherwise false
+ */
+bool deferred_exec_next_trigger(uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any deferred executors. Should not be invoked by keyboard/user code.
  */
@@ -70,7 +78,7 @@ void deferred_exec_task(void);
 //------------------------------------
 
 /**
- * @struct Structure for containing self-hosted deferred executor tables.
+ * @struct Structure for containing self-hosted deferred executor tables, of up to 255 entries.
  * @brief Core-side code can use this to create their own tables without impacting on the use of users' ability to add deferred execution.
  *        Code outside deferred_exec.c should not worry about internals of this struct, and should just allocate the required number in an array.
  */
@@ -110,6 +118,16 @@ bool extend_deferred_exec_advanced(deferred_executor_t *table, size_t table_coun
  */
 bool cancel_deferred_exec_advanced(deferred_executor_t *table, size_t table_count, deferred_token token);
 
+/**
+ * Retrieves the time the next deferred execution is due at.
+ *
+ * @param table[in] the custom table used for storage
+ * @param table_count[in] the number of available items in the table
+ * @param trigger_time[out] the time the earliest deferred execution is due at -- equivalent time-space as timer_read32()
+ * @return true if any deferred execution is queued, otherwise false
+ */
+bool deferred_exec_advanced_next_trigger(deferred_executor_t *table, size_t table_count, uint32_t *trigger_time);
+
 /**
  * Forward declaration for the main loop in order to execute any custom table deferred executors. Should not be invoked by keyboard/user code.
  * Needed for any custom-allocated deferred execution tables. Any core tasks should add appropriate invocation to quantum/main.c.
@@ -14,13 +14,16 @@
  * along with this program.  If not, see <http://www.gnu.org/licenses/>.
  */
 
+#include <string.h>
 #include "dynamic_keymap.h"
 #include "keymap_introspection.h"
 #include "action.h"
+#include "action_layer.h"
 #include "eeprom.h"
 #include "progmem.h"
 #include "send_string.h"
 #include "keycodes.h"
+#include "timer.h"
 
 #ifdef VIA_ENABLE
 #    include "via.h"
@@ -101,6 +104,46 @@ _Static_assert((DYNAMIC_KEYMAP_EEPROM_MAX_ADDR) - (DYNAMIC_KEYMAP_MACRO_EEPROM_A
 #    define DYNAMIC_KEYMAP_MACRO_DELAY TAP_CODE_DELAY
 #endif
 
+#define DYNAMIC_KEYMAP_EEPROM_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+// Time without further changes after which the keymap is written back to EEPROM
+#    ifndef DYNAMIC_KEYMAP_WRITE_BACK_DELAY
+#        define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 1000
+#    endif
+
+// Copy of the keymap as stored in EEPROM, big endian keycodes ordered by layer/row/column
+static uint8_t  dynamic_keymap_cache[DYNAMIC_KEYMAP_EEPROM_SIZE];
+static bool     dynamic_keymap_cache_loaded = false;
+static uint16_t dynamic_keymap_dirty_start  = DYNAMIC_KEYMAP_EEPROM_SIZE;
+static uint16_t dynamic_keymap_dirty_end    = 0;
+static uint16_t dynamic_keymap_dirty_timer  = 0;
+
+// Offsets of the macro strings within the macro buffer
+static uint16_t dynamic_keymap_macro_offsets[DYNAMIC_KEYMAP_MACRO_COUNT];
+static uint8_t  dynamic_keymap_macro_offsets_count = 0;
+static bool     dynamic_keymap_macro_offsets_valid = false;
+
+static void dynamic_keymap_cache_load(void) {
+    if (!dynamic_keymap_cache_loaded) {
+        eeprom_read_block(dynamic_keymap_cache, (void *)DYNAMIC_KEYMAP_EEPROM_ADDR, DYNAMIC_KEYMAP_EEPROM_SIZE);
+        dynamic_keymap_cache_loaded = true;
+    }
+}
+
+// Changed bytes are always written back, even if the cache already held the value,
+// as the EEPROM may have been erased underneath the cache
+static void dynamic_keymap_cache_mark_dirty(uint16_t start, uint16_t end) {
+    if (start < dynamic_keymap_dirty_start) {
+        dynamic_keymap_dirty_start = start;
+    }
+    if (end > dynamic_keymap_dirty_end) {
+        dynamic_keymap_dirty_end = end;
+    }
+    dynamic_keymap_dirty_timer = timer_read();
+}
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
+
 uint8_t dynamic_keymap_get_layer_count(void) {
     return DYNAMIC_KEYMAP_LAYER_COUNT;
 }
@@ -112,19 +155,36 @@ void *dynamic_keymap_key_to_eeprom_address(uint8_t layer, uint8_t row, uint8_t c
 
 uint16_t dynamic_keymap_get_keycode(uint8_t layer, uint8_t row, uint8_t column) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return KC_NO;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_load();
+    const uint8_t *cached = &dynamic_keymap_cache[(layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2)];
+    return (cached[0] << 8) | cached[1];
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     uint16_t keycode = eeprom_read_byte(address) << 8;
     keycode |= eeprom_read_byte(address + 1);
     return keycode;
+#endif
 }
 
 void dynamic_keymap_set_keycode(uint8_t layer, uint8_t row, uint8_t column, uint16_t keycode) {
     if (layer >= DYNAMIC_KEYMAP_LAYER_COUNT || row >= MATRIX_ROWS || column >= MATRIX_COLS) return;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_load();
+    uint16_t offset                  = (layer * MATRIX_ROWS * MATRIX_COLS * 2) + (row * MATRIX_COLS * 2) + (column * 2);
+    dynamic_keymap_cache[offset]     = (uint8_t)(keycode >> 8);
+    dynamic_keymap_cache[offset + 1] = (uint8_t)(keycode & 0xFF);
+    dynamic_keymap_cache_mark_dirty(offset, offset + 2);
+#else
     void *address = dynamic_keymap_key_to_eeprom_address(layer, row, column);
     // Big endian, so we can read/write EEPROM directly from host if we want
     eeprom_update_byte(address, (uint8_t)(keycode >> 8));
     eeprom_update_byte(address + 1, (uint8_t)(keycode & 0xFF));
+#endif
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_LAYERS_CACHE)
+    clear_effective_layers_cache();
+#endif
 }
 
 #ifdef ENCODER_MAP_ENABLE
@@ -165,14 +225,23 @@ void dynamic_keymap_reset(void) {
         }
 #endif // ENCODER_MAP_ENABLE
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // The caller may mark the EEPROM valid right after this, so don't leave the write pending
+    dynamic_keymap_flush();
+#endif
 }
 
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   source                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *target                     = data;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_cache_load();
+    for (uint16_t i = 0; i < size; i++) {
+        data[i] = offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE ? dynamic_keymap_cache[offset + i] : 0x00;
+    }
+#else
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
             *target = eeprom_read_byte(source);
         } else {
             *target = 0x00;
@@ -180,19 +249,50 @@ void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
         source++;
         target++;
     }
+#endif
 }
 
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    uint16_t dynamic_keymap_eeprom_size = DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2;
-    void *   target                     = (void *)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
-    uint8_t *source                     = data;
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (offset < DYNAMIC_KEYMAP_EEPROM_SIZE && size > 0) {
+        uint16_t end = offset + size < DYNAMIC_KEYMAP_EEPROM_SIZE ? offset + size : DYNAMIC_KEYMAP_EEPROM_SIZE;
+        dynamic_keymap_cache_load();
+        memcpy(&dynamic_keymap_cache[offset], data, end - offset);
+        dynamic_keymap_cache_mark_dirty(offset, end);
+    }
+#else
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + offset);
+    uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
-        if (offset + i < dynamic_keymap_eeprom_size) {
+        if (offset + i < DYNAMIC_KEYMAP_EEPROM_SIZE) {
             eeprom_update_byte(target, *source);
         }
         source++;
         target++;
     }
+#endif
+#if !defined(NO_ACTION_LAYER) && defined(EFFECTIVE_LAYERS_CACHE)
+    clear_effective_layers_cache();
+#endif
+}
+
+void dynamic_keymap_flush(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (dynamic_keymap_dirty_start < dynamic_keymap_dirty_end) {
+        eeprom_update_block(&dynamic_keymap_cache[dynamic_keymap_dirty_start], (void *)(uintptr_t)(DYNAMIC_KEYMAP_EEPROM_ADDR + dynamic_keymap_dirty_start), dynamic_keymap_dirty_end - dynamic_keymap_dirty_start);
+        dynamic_keymap_dirty_start = DYNAMIC_KEYMAP_EEPROM_SIZE;
+        dynamic_keymap_dirty_end   = 0;
+    }
+#endif
+}
+
+void dynamic_keymap_task(void) {
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Wait until the host is done editing, so a batch of changes becomes a single write
+    if (dynamic_keymap_dirty_start < dynamic_keymap_dirty_end && timer_elapsed(dynamic_keymap_dirty_timer) >= DYNAMIC_KEYMAP_WRITE_BACK_DELAY) {
+        dynamic_keymap_flush();
+    }
+#endif
 }
 
 uint16_t keycode_at_keymap_location(uint8_t layer_num, uint8_t row, uint8_t column) {
@@ -220,7 +320,7 @@ uint16_t dynamic_keymap_macro_get_buffer_size(void) {
 }
 
 void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   source = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   source = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *target = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -234,7 +334,7 @@ void dynamic_keymap_macro_get_buffer(uint16_t offset, uint16_t size, uint8_t *da
 }
 
 void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *data) {
-    void *   target = (void *)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
+    void *   target = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset);
     uint8_t *source = data;
     for (uint16_t i = 0; i < size; i++) {
         if (offset + i < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
@@ -243,6 +343,9 @@ void dynamic_keymap_macro_set_buffer(uint16_t offset, uint16_t size, uint8_t *da
         source++;
         target++;
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_macro_offsets_valid = false;
+#endif
 }
 
 void dynamic_keymap_macro_reset(void) {
@@ -252,13 +355,46 @@ void dynamic_keymap_macro_reset(void) {
         eeprom_update_byte(p, 0);
         ++p;
     }
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    dynamic_keymap_macro_offsets_valid = false;
+#endif
+}
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+static void dynamic_keymap_macro_build_offsets(void) {
+    dynamic_keymap_macro_offsets_count = 0;
+    dynamic_keymap_macro_offsets_valid = true;
+
+    // Same as when sending, a buffer in the middle of being written has no macros
+    if (eeprom_read_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE - 1)) != 0) {
+        return;
+    }
+
+    uint16_t offset = 0;
+    while (dynamic_keymap_macro_offsets_count < DYNAMIC_KEYMAP_MACRO_COUNT && offset < DYNAMIC_KEYMAP_MACRO_EEPROM_SIZE) {
+        dynamic_keymap_macro_offsets[dynamic_keymap_macro_offsets_count++] = offset;
+        // The last byte of the buffer is a null, so this cannot go past the end
+        while (eeprom_read_byte((void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + offset++)) != 0) {
+        }
+    }
 }
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
 
 void dynamic_keymap_macro_send(uint8_t id) {
     if (id >= DYNAMIC_KEYMAP_MACRO_COUNT) {
         return;
     }
 
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    if (!dynamic_keymap_macro_offsets_valid) {
+        dynamic_keymap_macro_build_offsets();
+    }
+    // A missing macro, or the buffer is being written
+    if (id >= dynamic_keymap_macro_offsets_count) {
+        return;
+    }
+    void *p = (void *)(uintptr_t)(DYNAMIC_KEYMAP_MACRO_EEPROM_ADDR + dynamic_keymap_macro_offsets[id]);
+#else
     // Check the last byte of the buffer.
     // If it's not zero, then we are in the middle
     // of buffer writing, possibly an aborted buffer
@@ -283,6 +419,7 @@ void dynamic_keymap_macro_send(uint8_t id) {
         }
         ++p;
     }
+#endif // DYNAMIC_KEYMAP_RAM_CACHE
 
     // Send the macro string by making a temporary string.
     char data[8] = {0};
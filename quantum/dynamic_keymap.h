@@ -38,6 +38,12 @@ void dynamic_keymap_reset(void);
 void dynamic_keymap_get_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 void dynamic_keymap_set_buffer(uint16_t offset, uint16_t size, uint8_t *data);
 
+// With DYNAMIC_KEYMAP_RAM_CACHE the keymap is served from RAM and changes are
+// written back to EEPROM by dynamic_keymap_task() once they have settled.
+// dynamic_keymap_flush() writes any pending changes immediately.
+void dynamic_keymap_flush(void);
+void dynamic_keymap_task(void);
+
 // This overrides the one in quantum/keymap_common.c
 // uint16_t keymap_key_to_keycode(uint8_t layer, keypos_t key);
 
@@ -32,6 +32,9 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include "sendchar.h"
 #include "eeconfig.h"
 #include "action_layer.h"
+#include "tracing.h"
+#include "task_scheduler.h"
+#include "progmem.h"
 #ifdef BOOTMAGIC_ENABLE
 #    include "bootmagic.h"
 #endif
@@ -101,9 +104,15 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #ifdef ST7565_ENABLE
 #    include "st7565.h"
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+#    include "send_string.h"
+#endif
 #ifdef VIA_ENABLE
 #    include "via.h"
 #endif
+#ifdef DYNAMIC_KEYMAP_ENABLE
+#    include "dynamic_keymap.h"
+#endif
 #ifdef DIP_SWITCH_ENABLE
 #    include "dip_switch.h"
 #endif
@@ -405,6 +414,8 @@ void quantum_init(void) {
  *
  * FIXME: needs doc
  */
+static void keyboard_task_scheduler_init(void);
+
 void keyboard_init(void) {
     timer_init();
     sync_timer_init();
@@ -485,6 +496,13 @@ void keyboard_init(void) {
 #ifdef HAPTIC_ENABLE
     haptic_init();
 #endif
+#ifdef COMBO_ENABLE
+    combo_init();
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    key_override_init();
+#endif
+    keyboard_task_scheduler_init();
 
 #if defined(DEBUG_MATRIX_SCAN_RATE) && defined(CONSOLE_ENABLE)
     debug_enable = true;
@@ -520,10 +538,42 @@ static inline void generate_tick_event(void) {
     }
 }
 
+/**
+ * @brief Returns the column index of the lowest changed key in a matrix row.
+ */
+static inline uint8_t matrix_row_lowest_col(matrix_row_t row_changes) {
+    return __builtin_ctzl(row_changes);
+}
+
+#define MATRIX_DIRTY_ROWS_SIZE ((MATRIX_ROWS + 7) / 8)
+
+static uint8_t matrix_dirty_rows[MATRIX_DIRTY_ROWS_SIZE];
+static bool    matrix_dirty_rows_tracked = false;
+
+/**
+ * @brief Marks rows of the matrix as changed since the last scan.
+ *
+ * Once the matrix implementation marks the rows it changes, matrix_task() only
+ * looks at the marked rows instead of comparing every row against its previous
+ * state. Implementations that never call this keep the full comparison.
+ */
+void matrix_mark_rows_dirty(uint8_t row, uint8_t count) {
+    matrix_dirty_rows_tracked = true;
+    for (; count > 0; count--, row++) {
+        matrix_dirty_rows[row / 8] |= 1 << (row % 8);
+    }
+}
+
 /**
  * @brief This task scans the keyboards matrix and processes any key presses
  * that occur.
  *
+ * Change detection and event generation are done in a single pass over the
+ * rows, and only the changed columns of a row are visited, so the cost of a
+ * scan is proportional to the number of changed keys rather than the size of
+ * the matrix. When the matrix implementation marks dirty rows, only those rows
+ * are visited.
+ *
  * @return true Matrix did change
  * @return false Matrix didn't change
  */
@@ -536,47 +586,67 @@ static bool matrix_task(void) {
     static matrix_row_t matrix_previous[MATRIX_ROWS];
 
     matrix_scan();
-    bool matrix_changed = false;
-    for (uint8_t row = 0; row < MATRIX_ROWS && !matrix_changed; row++) {
-        matrix_changed |= matrix_previous[row] ^ matrix_get_row(row);
-    }
-
     matrix_scan_perf_task();
 
-    // Short-circuit the complete matrix processing if it is not necessary
-    if (!matrix_changed) {
-        generate_tick_event();
-        return matrix_changed;
-    }
+    bool matrix_changed   = false;
+    bool process_keypress = false;
 
-    if (debug_config.matrix) {
-        matrix_print();
-    }
+    for (uint8_t block = 0; block < MATRIX_DIRTY_ROWS_SIZE; block++) {
+        // Without dirty row tracking every row is checked for changes
+        uint8_t dirty            = matrix_dirty_rows_tracked ? matrix_dirty_rows[block] : 0xFF;
+        matrix_dirty_rows[block] = 0;
 
-    const bool process_keypress = should_process_keypress();
+        while (dirty) {
+            const uint8_t row = block * 8 + __builtin_ctz(dirty);
+            dirty &= dirty - 1;
+            if (row >= MATRIX_ROWS) {
+                break;
+            }
 
-    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
-        const matrix_row_t current_row = matrix_get_row(row);
-        const matrix_row_t row_changes = current_row ^ matrix_previous[row];
+            const matrix_row_t current_row = matrix_get_row(row);
+            matrix_row_t       row_changes = current_row ^ matrix_previous[row];
 
-        if (!row_changes || has_ghost_in_row(row, current_row)) {
-            continue;
-        }
+            if (!row_changes) {
+                continue;
+            }
+
+            if (!matrix_changed) {
+                matrix_changed = true;
+
+                if (debug_config.matrix) {
+                    matrix_print();
+                }
+
+                process_keypress = should_process_keypress();
+            }
+
+            if (has_ghost_in_row(row, current_row)) {
+                // Check the row again on the next scan, the ghost may be gone by then
+                matrix_dirty_rows[block] |= 1 << (row % 8);
+                continue;
+            }
 
-        matrix_row_t col_mask = 1;
-        for (uint8_t col = 0; col < MATRIX_COLS; col++, col_mask <<= 1) {
-            if (row_changes & col_mask) {
-                const bool key_pressed = current_row & col_mask;
+            // Walk the changed columns in ascending order, clearing the lowest set bit each time
+            while (row_changes) {
+                const uint8_t col         = matrix_row_lowest_col(row_changes);
+                const bool    key_pressed = current_row & ((matrix_row_t)1 << col);
 
                 if (process_keypress) {
                     action_exec(MAKE_KEYEVENT(row, col, key_pressed));
                 }
 
                 switch_events(row, col, key_pressed);
+
+                row_changes &= row_changes - 1;
             }
+
+            matrix_previous[row] = current_row;
         }
+    }
 
-        matrix_previous[row] = current_row;
+    // No key events were generated, so keep the internal state machine ticking
+    if (!matrix_changed) {
+        generate_tick_event();
     }
 
     return matrix_changed;
@@ -655,97 +725,191 @@ void quantum_task(void) {
 #ifdef SECURE_ENABLE
     secure_task();
 #endif
-}
 
-/** \brief Main task that is repeatedly called as fast as possible. */
-void keyboard_task(void) {
-    __attribute__((unused)) bool activity_has_occurred = false;
-    if (matrix_task()) {
-        last_matrix_activity_trigger();
-        activity_has_occurred = true;
-    }
-
-    quantum_task();
-
-#if defined(SPLIT_WATCHDOG_ENABLE)
-    split_watchdog_task();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_task();
 #endif
 
-#if defined(RGBLIGHT_ENABLE)
-    rgblight_task();
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
 #endif
+}
 
-#ifdef LED_MATRIX_ENABLE
-    led_matrix_task();
+#ifndef TASK_SCHEDULER_BUDGET_US
+#    define TASK_SCHEDULER_BUDGET_US 0
 #endif
-#ifdef RGB_MATRIX_ENABLE
-    rgb_matrix_task();
+
+#ifndef TASK_SCHEDULER_REGISTERED_TASKS
+#    define TASK_SCHEDULER_REGISTERED_TASKS 4
 #endif
 
-#if defined(BACKLIGHT_ENABLE)
-#    if defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS)
-    backlight_task();
-#    endif
+#if defined(BACKLIGHT_ENABLE) && (defined(BACKLIGHT_PIN) || defined(BACKLIGHT_PINS))
+#    define BACKLIGHT_TASK_ENABLE
 #endif
 
+// Set by the tasks reading inputs, to wake up the displays
+static bool activity_has_occurred = false;
+
 #ifdef ENCODER_ENABLE
+static void encoder_scheduled_task(void) {
     if (encoder_task()) {
         last_encoder_activity_trigger();
         activity_has_occurred = true;
     }
+}
 #endif
 
 #ifdef POINTING_DEVICE_ENABLE
+static void pointing_device_scheduled_task(void) {
     if (pointing_device_task()) {
         last_pointing_device_activity_trigger();
         activity_has_occurred = true;
     }
+}
 #endif
 
+// Wake up displays if user is using those fabulous keys or spinning those encoders!
+#if defined(OLED_ENABLE) && OLED_TIMEOUT > 0
+static void oled_wake_task(void) {
+    if (activity_has_occurred) oled_on();
+}
+#endif
+
+#if defined(ST7565_ENABLE) && ST7565_TIMEOUT > 0
+static void st7565_wake_task(void) {
+    if (activity_has_occurred) st7565_on();
+}
+#endif
+
+#define SCHEDULED_TASK(fn, period, prio, trace) \
+    { .task = (fn), .period_ms = (period), .priority = (prio), .trace_id = (trace) }
+
+/*
+ * The tasks run after the matrix scan, in the order keyboard_task() has always run them. Lighting and displays are
+ * background tasks, deferred once TASK_SCHEDULER_BUDGET_US is spent.
+ */
+static const scheduled_task_t keyboard_tasks[] PROGMEM = {
+#ifdef RGBLIGHT_ENABLE
+    SCHEDULED_TASK(rgblight_task, 0, TASK_PRIORITY_BACKGROUND, TRACE_RGBLIGHT_TASK),
+#endif
+#ifdef LED_MATRIX_ENABLE
+    SCHEDULED_TASK(led_matrix_task, 0, TASK_PRIORITY_BACKGROUND, TRACE_LED_MATRIX_TASK),
+#endif
+#ifdef RGB_MATRIX_ENABLE
+    SCHEDULED_TASK(rgb_matrix_task, 0, TASK_PRIORITY_BACKGROUND, TRACE_RGB_MATRIX_TASK),
+#endif
+#ifdef BACKLIGHT_TASK_ENABLE
+    SCHEDULED_TASK(backlight_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_BACKLIGHT_TASK),
+#endif
+#ifdef ENCODER_ENABLE
+    SCHEDULED_TASK(encoder_scheduled_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_ENCODER_TASK),
+#endif
+#ifdef POINTING_DEVICE_ENABLE
+    SCHEDULED_TASK(pointing_device_scheduled_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_POINTING_DEVICE_TASK),
+#endif
 #ifdef OLED_ENABLE
-    oled_task();
+    SCHEDULED_TASK(oled_task, 0, TASK_PRIORITY_BACKGROUND, TRACE_OLED_TASK),
 #    if OLED_TIMEOUT > 0
-    // Wake up oled if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) oled_on();
+    SCHEDULED_TASK(oled_wake_task, 0, TASK_PRIORITY_FOREGROUND, SCHEDULED_TASK_NO_TRACE),
 #    endif
 #endif
-
 #ifdef ST7565_ENABLE
-    st7565_task();
+    SCHEDULED_TASK(st7565_task, 0, TASK_PRIORITY_BACKGROUND, TRACE_ST7565_TASK),
 #    if ST7565_TIMEOUT > 0
-    // Wake up display if user is using those fabulous keys or spinning those encoders!
-    if (activity_has_occurred) st7565_on();
+    SCHEDULED_TASK(st7565_wake_task, 0, TASK_PRIORITY_FOREGROUND, SCHEDULED_TASK_NO_TRACE),
 #    endif
 #endif
-
 #ifdef MOUSEKEY_ENABLE
     // mousekey repeat & acceleration
-    mousekey_task();
+    SCHEDULED_TASK(mousekey_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_MOUSEKEY_TASK),
 #endif
-
 #ifdef PS2_MOUSE_ENABLE
-    ps2_mouse_task();
+    SCHEDULED_TASK(ps2_mouse_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_PS2_MOUSE_TASK),
 #endif
-
 #ifdef MIDI_ENABLE
-    midi_task();
+    SCHEDULED_TASK(midi_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_MIDI_TASK),
 #endif
-
 #ifdef JOYSTICK_ENABLE
-    joystick_task();
+    SCHEDULED_TASK(joystick_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_JOYSTICK_TASK),
 #endif
-
 #ifdef BLUETOOTH_ENABLE
-    bluetooth_task();
+    SCHEDULED_TASK(bluetooth_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_BLUETOOTH_TASK),
 #endif
-
 #ifdef HAPTIC_ENABLE
-    haptic_task();
+    // Solenoid dwell times are in milliseconds
+    SCHEDULED_TASK(haptic_task, 1, TASK_PRIORITY_FOREGROUND, TRACE_HAPTIC_TASK),
+#endif
+    // The host sends its LED state at most once per USB frame
+    SCHEDULED_TASK(led_task, 1, TASK_PRIORITY_FOREGROUND, TRACE_LED_TASK),
+#ifdef OS_DETECTION_ENABLE
+    // Only acts once the USB state settled for OS_DETECTION_DEBOUNCE
+    SCHEDULED_TASK(os_detection_task, 10, TASK_PRIORITY_FOREGROUND, TRACE_OS_DETECTION_TASK),
 #endif
+#ifdef SEND_STRING_ASYNC_ENABLE
+    SCHEDULED_TASK(send_string_async_task, 0, TASK_PRIORITY_FOREGROUND, TRACE_SEND_STRING_TASK),
+#endif
+};
 
-    led_task();
+static scheduled_task_t       keyboard_registered_tasks[TASK_SCHEDULER_REGISTERED_TASKS];
+static scheduled_task_state_t keyboard_task_state[ARRAY_SIZE(keyboard_tasks) + TASK_SCHEDULER_REGISTERED_TASKS];
 
-#ifdef OS_DETECTION_ENABLE
-    os_detection_task();
+static task_scheduler_t keyboard_task_scheduler = {
+    .tasks           = keyboard_tasks,
+    .count           = ARRAY_SIZE(keyboard_tasks),
+    .registered      = keyboard_registered_tasks,
+    .registered_size = TASK_SCHEDULER_REGISTERED_TASKS,
+    .state           = keyboard_task_state,
+};
+
+static void keyboard_task_scheduler_init(void) {
+    task_scheduler_set_budget(&keyboard_task_scheduler, TASK_SCHEDULER_BUDGET_US);
+}
+
+/** \brief Adds a task to be run by keyboard_task(), after the built-in ones.
+ *
+ * Up to TASK_SCHEDULER_REGISTERED_TASKS tasks can be added, returns false once they are all taken.
+ */
+bool keyboard_task_register(scheduled_task_fn_t task, uint16_t period_ms, uint8_t priority) {
+    return task_scheduler_register(&keyboard_task_scheduler, task, period_ms, priority);
+}
+
+/** \brief Diagnostics of a task run by keyboard_task(), such as `rgb_matrix_task`.
+ *
+ * Returns NULL if the task isn't scheduled by keyboard_task().
+ */
+const scheduled_task_state_t *keyboard_task_get_state(scheduled_task_fn_t task) {
+    return task_scheduler_get_state(&keyboard_task_scheduler, task);
+}
+
+/** \brief Resets the diagnostics of the tasks run by keyboard_task().
+ */
+void keyboard_task_clear_stats(void) {
+    task_scheduler_clear_stats(&keyboard_task_scheduler);
+}
+
+/** \brief Main task that is repeatedly called as fast as possible.
+ *
+ * The matrix is always scanned first, the remaining tasks go through the scheduler.
+ */
+void keyboard_task(void) {
+    uint32_t loop_start   = task_scheduler_clock();
+    activity_has_occurred = false;
+    TRACE_BEGIN(TRACE_KEYBOARD_TASK);
+
+    TRACE_BEGIN(TRACE_MATRIX_TASK);
+    if (matrix_task()) {
+        last_matrix_activity_trigger();
+        activity_has_occurred = true;
+    }
+    TRACE_END(TRACE_MATRIX_TASK);
+
+    TRACE_SPAN(TRACE_QUANTUM_TASK, quantum_task());
+
+#if defined(SPLIT_WATCHDOG_ENABLE)
+    split_watchdog_task();
 #endif
+
+    task_scheduler_run(&keyboard_task_scheduler, loop_start);
+
+    TRACE_END(TRACE_KEYBOARD_TASK);
 }
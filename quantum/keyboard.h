@@ -21,6 +21,7 @@ along with this program.  If not, see <http://www.gnu.org/licenses/>.
 #include <stdint.h>
 
 #include "timer.h"
+#include "task_scheduler.h"
 
 #ifdef __cplusplus
 extern "C" {
@@ -109,6 +110,11 @@ void keyboard_setup(void);
 void keyboard_init(void);
 /* it runs repeatedly in main loop */
 void keyboard_task(void);
+/* adds a task to be run by keyboard_task, see task_scheduler.h */
+bool keyboard_task_register(scheduled_task_fn_t task, uint16_t period_ms, uint8_t priority);
+/* diagnostics of the tasks scheduled by keyboard_task, e.g. keyboard_task_get_state(rgb_matrix_task) */
+const scheduled_task_state_t *keyboard_task_get_state(scheduled_task_fn_t task);
+void                          keyboard_task_clear_stats(void);
 /* it runs whenever code has to behave differently on a slave */
 bool is_keyboard_master(void);
 /* it runs whenever code has to behave differently on left vs right split */
@@ -15,6 +15,7 @@
  */
 
 #include "keyboard.h"
+#include "tracing.h"
 
 void platform_setup(void);
 
@@ -63,7 +64,7 @@ int main(void) {
 #ifdef QUANTUM_PAINTER_ENABLE
         // Run Quantum Painter task
         void qp_internal_task(void);
-        qp_internal_task();
+        TRACE_SPAN(TRACE_PAINTER_TASK, qp_internal_task());
 #endif
 
 #ifdef DEFERRED_EXEC_ENABLE
@@ -72,6 +73,12 @@ int main(void) {
         deferred_exec_task();
 #endif // DEFERRED_EXEC_ENABLE
 
+#ifdef TRACING_ENABLE
+        // Drain recorded trace spans
+        void tracing_task(void);
+        tracing_task();
+#endif // TRACING_ENABLE
+
         housekeeping_task();
     }
 }
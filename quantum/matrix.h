@@ -59,6 +59,8 @@ bool matrix_is_on(uint8_t row, uint8_t col);
 matrix_row_t matrix_get_row(uint8_t row);
 /* print matrix for debug */
 void matrix_print(void);
+/* mark rows changed by a scan, so only those are checked for key events */
+void matrix_mark_rows_dirty(uint8_t row, uint8_t count);
 /* delay between changing matrix pin state and reading values */
 void matrix_output_select_delay(void);
 void matrix_output_unselect_delay(uint8_t line, bool key_pressed);
@@ -169,9 +169,17 @@ __attribute__((weak)) uint8_t matrix_scan(void) {
     bool changed = matrix_scan_custom(raw_matrix);
 
 #ifdef SPLIT_KEYBOARD
-    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed) | matrix_post_scan();
+    changed = debounce(raw_matrix, matrix + thisHand, ROWS_PER_HAND, changed);
+    if (changed) matrix_mark_rows_dirty(thisHand, ROWS_PER_HAND);
+    if (matrix_post_scan()) {
+        matrix_mark_rows_dirty(thatHand, ROWS_PER_HAND);
+        changed = true;
+    }
+    // The slave doesn't know whether the master's half it mirrors has changed
+    if (!is_keyboard_master()) matrix_mark_rows_dirty(thatHand, ROWS_PER_HAND);
 #else
     changed = debounce(raw_matrix, matrix, ROWS_PER_HAND, changed);
+    if (changed) matrix_mark_rows_dirty(0, ROWS_PER_HAND);
     matrix_scan_kb();
 #endif
 
@@ -56,6 +56,23 @@
 #    define QUANTUM_PAINTER_LOAD_FONTS_TO_RAM FALSE
 #endif
 
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES
+/**
+ * @def This controls the number of rendered glyphs that are kept in RAM, already converted to the display's native
+ *      pixel format. Redrawing cached glyphs with the same colors skips decoding entirely, at the cost of
+ *      \ref QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE bytes of RAM per entry. Defaults to 0, disabling the cache.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 0
+#endif
+
+#ifndef QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE
+/**
+ * @def This controls the number of bytes of native pixel data each glyph cache entry can hold. Glyphs requiring more
+ *      than this are drawn without being cached.
+ */
+#    define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 256
+#endif
+
 #ifndef QUANTUM_PAINTER_CONCURRENT_ANIMATIONS
 /**
  * @def This controls the maximum number of animations that Quantum Painter can play simultaneously. Increasing this
@@ -72,6 +89,14 @@
 #    define QUANTUM_PAINTER_PIXDATA_BUFFER_SIZE 1024
 #endif
 
+#ifndef QUANTUM_PAINTER_DECODE_SPAN_SIZE
+/**
+ * @def This controls the maximum number of pixels decoded from an image or font at a time, before being converted
+ *      into the pixel data buffer in a single pass. Held on the stack while drawing; must be a multiple of 8.
+ */
+#    define QUANTUM_PAINTER_DECODE_SPAN_SIZE 64
+#endif
+
 #ifndef QUANTUM_PAINTER_SUPPORTS_256_PALETTE
 /**
  * @def This controls whether 256-color palettes are supported. This has relatively hefty requirements on RAM -- at
@@ -27,14 +27,8 @@ bool qp_internal_setpixel_impl(painter_device_t device, uint16_t x, uint16_t y);
 // qp_rect internal implementation, but uses the global pixdata buffer with pre-converted native pixels.
 bool qp_internal_fillrect_helper_impl(painter_device_t device, uint16_t l, uint16_t t, uint16_t r, uint16_t b);
 
-// Convert from input pixel data + palette to equivalent pixels
+// Pulls the next decoded byte of input pixel data
 typedef int16_t (*qp_internal_byte_input_callback)(void* cb_arg);
-typedef bool (*qp_internal_pixel_output_callback)(qp_pixel_t* palette, uint8_t index, void* cb_arg);
-typedef bool (*qp_internal_byte_output_callback)(uint8_t byte, void* cb_arg);
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg);
-bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg);
 
 // Global variable used for interpolated pixel lookup table.
 #if QUANTUM_PAINTER_SUPPORTS_256_PALETTE
@@ -82,19 +76,18 @@ typedef struct qp_internal_pixel_output_state_t {
     uint32_t         max_pixels;
 } qp_internal_pixel_output_state_t;
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg);
-
 typedef struct qp_internal_byte_output_state_t {
     painter_device_t device;
     uint32_t         byte_write_pos;
     uint32_t         max_bytes;
 } qp_internal_byte_output_state_t;
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg);
-
-// Helper shared between image and font rendering, sends pixels to the display using:
-//     - qp_internal_decode_palette + qp_internal_pixel_appender (bpp <= 8)
-//     - qp_internal_send_bytes                                  (bpp > 8)
+// Helper shared between image and font rendering, decodes spans of pixels and sends them to the display:
+//     - converted through the palette, a span at a time with append_pixels (bpp <= 8)
+//     - copied verbatim into the pixdata buffer                            (bpp > 8)
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state);
 
+// Decodes pixels into the supplied buffer in the display's native format, without transmitting them. The buffer needs to be large enough for all of them.
+bool qp_internal_decode_to_buffer(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* target_buffer);
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression);
@@ -2,6 +2,8 @@
 // Copyright 2023 Pablo Martinez (@elpekenin) <elpekenin@elpekenin.dev>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
+
 #include "qp_internal.h"
 #include "qp_draw.h"
 #include "qp_comms.h"
@@ -9,78 +11,23 @@
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Palette / Monochrome-format decoder
 
-static const qp_pixel_t qp_pixel_white = {.hsv888 = {.h = 0, .s = 0, .v = 255}};
-static const qp_pixel_t qp_pixel_black = {.hsv888 = {.h = 0, .s = 0, .v = 0}};
-
 bool qp_internal_bpp_capable(uint8_t bits_per_pixel) {
 #if !(QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS)
 #    if !(QUANTUM_PAINTER_SUPPORTS_256_PALETTE)
     if (bits_per_pixel > 4) {
-        qp_dprintf("qp_internal_decode_palette: image bpp greater than 4\n");
+        qp_dprintf("qp_internal_bpp_capable: image bpp greater than 4\n");
         return false;
     }
 #    endif
 
     if (bits_per_pixel > 8) {
-        qp_dprintf("qp_internal_decode_palette: image bpp greater than 8\n");
+        qp_dprintf("qp_internal_bpp_capable: image bpp greater than 8\n");
         return false;
     }
 #endif
     return true;
 }
 
-bool qp_internal_decode_palette(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t* palette, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
-    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
-    uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
-    while (remaining_pixels > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
-            return false;
-        }
-        uint8_t loop_pixels = remaining_pixels < pixels_per_byte ? remaining_pixels : pixels_per_byte;
-        for (uint8_t q = 0; q < loop_pixels; ++q) {
-            if (!output_callback(palette, byteval & pixel_bitmask, output_arg)) {
-                return false;
-            }
-            byteval >>= bits_per_pixel;
-        }
-        remaining_pixels -= loop_pixels;
-    }
-    return true;
-}
-
-bool qp_internal_decode_grayscale(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    return qp_internal_decode_recolor(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_pixel_white, qp_pixel_black, output_callback, output_arg);
-}
-
-bool qp_internal_decode_recolor(painter_device_t device, uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, void* input_arg, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, qp_internal_pixel_output_callback output_callback, void* output_arg) {
-    painter_driver_t* driver = (painter_driver_t*)device;
-    int16_t           steps  = 1 << bits_per_pixel; // number of items we need to interpolate
-    if (qp_internal_interpolate_palette(fg_hsv888, bg_hsv888, steps)) {
-        if (!driver->driver_vtable->palette_convert(device, steps, qp_internal_global_pixel_lookup_table)) {
-            return false;
-        }
-    }
-
-    return qp_internal_decode_palette(device, pixel_count, bits_per_pixel, input_callback, input_arg, qp_internal_global_pixel_lookup_table, output_callback, output_arg);
-}
-
-bool qp_internal_send_bytes(painter_device_t device, uint32_t byte_count, qp_internal_byte_input_callback input_callback, void* input_arg, qp_internal_byte_output_callback output_callback, void* output_arg) {
-    uint32_t remaining_bytes = byte_count;
-    while (remaining_bytes > 0) {
-        int16_t byteval = input_callback(input_arg);
-        if (byteval < 0) {
-            return false;
-        }
-        if (!output_callback(byteval, output_arg)) {
-            return false;
-        }
-        remaining_bytes -= 1;
-    }
-    return true;
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Progressive pull of bytes, push of pixels
 
@@ -126,46 +73,174 @@ static inline int16_t qp_drawimage_byte_rle_decoder(void* cb_arg) {
     return c;
 }
 
-bool qp_internal_pixel_appender(qp_pixel_t* palette, uint8_t index, void* cb_arg) {
-    qp_internal_pixel_output_state_t* state  = (qp_internal_pixel_output_state_t*)cb_arg;
-    painter_driver_t*                 driver = (painter_driver_t*)state->device;
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Span-based decode, used when rendering images and fonts
 
-    if (!driver->driver_vtable->append_pixels(state->device, qp_internal_global_pixdata_buffer, palette, state->pixel_write_pos++, 1, &index)) {
-        return false;
+_Static_assert((QUANTUM_PAINTER_DECODE_SPAN_SIZE) % 8 == 0, "QUANTUM_PAINTER_DECODE_SPAN_SIZE must be a multiple of 8");
+
+// Pulls the next span of up to max_bytes decoded bytes. Literal spans are copied into the buffer, repeated spans only
+// write the first byte and set `repeated`. Returns the number of bytes in the span, or 0 on failure.
+static uint32_t qp_internal_read_span(qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* state, uint8_t* buffer, uint32_t max_bytes, bool* repeated) {
+    *repeated = false;
+
+    if (input_callback == qp_drawimage_byte_uncompressed_decoder) {
+        return qp_stream_read(buffer, 1, max_bytes, state->src_stream);
     }
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->pixel_write_pos == state->max_pixels) {
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->pixel_write_pos)) {
-            return false;
+    if (input_callback == qp_drawimage_byte_rle_decoder) {
+        // Work out if we're parsing the initial marker byte
+        if (state->rle.mode == MARKER_BYTE) {
+            int16_t c = qp_stream_get(state->src_stream);
+            if (c < 0) {
+                return 0;
+            }
+            if (c >= 128) {
+                state->rle.mode   = NON_REPEATING_RUN; // non-repeated run
+                state->rle.remain = c - 127;
+            } else {
+                state->rle.mode   = REPEATING_RUN; // repeated run
+                state->rle.remain = c;
+                state->curr       = qp_stream_get(state->src_stream);
+                if (state->curr < 0) {
+                    return 0;
+                }
+            }
         }
-        state->pixel_write_pos = 0;
+
+        uint32_t span_bytes = state->rle.remain < max_bytes ? state->rle.remain : max_bytes;
+        if (state->rle.mode == REPEATING_RUN) {
+            buffer[0] = state->curr;
+            *repeated = true;
+        } else if (qp_stream_read(buffer, 1, span_bytes, state->src_stream) != span_bytes) {
+            return 0;
+        }
+
+        // Swap back to querying the marker byte mode once the run is exhausted
+        state->rle.remain -= span_bytes;
+        if (state->rle.remain == 0) {
+            state->rle.mode = MARKER_BYTE;
+        }
+        return span_bytes;
     }
 
-    return true;
+    // Unknown decoder, fall back to a byte at a time
+    int16_t byteval = input_callback(state);
+    if (byteval < 0) {
+        return 0;
+    }
+    buffer[0] = byteval;
+    return 1;
 }
 
-bool qp_internal_byte_appender(uint8_t byteval, void* cb_arg) {
-    qp_internal_byte_output_state_t* state  = (qp_internal_byte_output_state_t*)cb_arg;
-    painter_driver_t*                driver = (painter_driver_t*)state->device;
+// Appends a run of palette indices to the target buffer, transmitting it whenever it fills up
+static bool qp_internal_append_pixel_span(qp_internal_pixel_output_state_t* state, uint8_t* target_buffer, qp_pixel_t* palette, uint8_t* palette_indices, uint32_t pixel_count) {
+    painter_driver_t* driver = (painter_driver_t*)state->device;
+    while (pixel_count > 0) {
+        uint32_t room       = state->max_pixels - state->pixel_write_pos;
+        uint32_t span_count = pixel_count < room ? pixel_count : room;
+        if (!driver->driver_vtable->append_pixels(state->device, target_buffer, palette, state->pixel_write_pos, span_count, palette_indices)) {
+            return false;
+        }
+        state->pixel_write_pos += span_count;
+        palette_indices += span_count;
+        pixel_count -= span_count;
 
-    if (!driver->driver_vtable->append_pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos++, byteval)) {
-        return false;
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (state->pixel_write_pos == state->max_pixels) {
+            if (!driver->driver_vtable->pixdata(state->device, target_buffer, state->pixel_write_pos)) {
+                return false;
+            }
+            state->pixel_write_pos = 0;
+        }
     }
+    return true;
+}
 
-    // If we've hit the transmit limit, send out the entire buffer and reset the write position
-    if (state->byte_write_pos == state->max_bytes) {
-        painter_driver_t* driver = (painter_driver_t*)state->device;
-        if (!driver->driver_vtable->pixdata(state->device, qp_internal_global_pixdata_buffer, state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+// Converts palette-indexed pixel data through the palette, a whole span of pixels at a time
+static bool qp_internal_decode_palette_spans(uint32_t pixel_count, uint8_t bits_per_pixel, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* input_state, qp_pixel_t* palette, qp_internal_pixel_output_state_t* output_state, uint8_t* target_buffer) {
+    const uint8_t pixel_bitmask    = (1 << bits_per_pixel) - 1;
+    const uint8_t pixels_per_byte  = 8 / bits_per_pixel;
+    uint8_t       palette_indices[QUANTUM_PAINTER_DECODE_SPAN_SIZE];
+    uint32_t      remaining_pixels = pixel_count; // don't try to derive from byte_count, we may not use an entire byte
+    while (remaining_pixels > 0) {
+        uint32_t span_pixels = remaining_pixels < sizeof(palette_indices) ? remaining_pixels : sizeof(palette_indices);
+        uint32_t max_bytes   = (span_pixels + pixels_per_byte - 1) / pixels_per_byte;
+
+        // Encoded bytes land at the end of the buffer, so unpacking front-to-back never overwrites a byte not yet read
+        uint8_t* bytes = &palette_indices[sizeof(palette_indices) - max_bytes];
+        bool     repeated;
+        uint32_t span_bytes = qp_internal_read_span(input_callback, input_state, bytes, max_bytes, &repeated);
+        if (span_bytes == 0) {
             return false;
         }
-        state->byte_write_pos = 0;
+        if (span_bytes * pixels_per_byte < span_pixels) {
+            span_pixels = span_bytes * pixels_per_byte;
+        }
+
+        uint8_t* span = palette_indices;
+        if (repeated) {
+            // Lay out the byte's pixels once, then double them up until the span is filled
+            uint8_t byteval = bytes[0];
+            for (uint8_t q = 0; q < pixels_per_byte; ++q) {
+                palette_indices[q] = byteval & pixel_bitmask;
+                byteval >>= bits_per_pixel;
+            }
+            for (uint32_t filled = pixels_per_byte; filled < span_pixels; filled *= 2) {
+                memcpy(&palette_indices[filled], palette_indices, (filled * 2 <= span_pixels) ? filled : span_pixels - filled);
+            }
+        } else if (pixels_per_byte == 1) {
+            // 8bpp pixels are their own palette indices
+            span = bytes;
+        } else {
+            uint32_t pixel = 0;
+            for (uint32_t i = 0; i < span_bytes; ++i) {
+                uint8_t byteval = bytes[i];
+                for (uint8_t q = 0; q < pixels_per_byte && pixel < span_pixels; ++q) {
+                    palette_indices[pixel++] = byteval & pixel_bitmask;
+                    byteval >>= bits_per_pixel;
+                }
+            }
+        }
+
+        if (!qp_internal_append_pixel_span(output_state, target_buffer, palette, span, span_pixels)) {
+            return false;
+        }
+        remaining_pixels -= span_pixels;
     }
+    return true;
+}
+
+// Decodes native pixdata straight into the target buffer, a whole span of bytes at a time
+static bool qp_internal_send_byte_spans(uint32_t byte_count, qp_internal_byte_input_callback input_callback, qp_internal_byte_input_state_t* input_state, qp_internal_byte_output_state_t* output_state, uint8_t* target_buffer) {
+    painter_driver_t* driver          = (painter_driver_t*)output_state->device;
+    uint32_t          remaining_bytes = byte_count;
+    while (remaining_bytes > 0) {
+        uint32_t room      = output_state->max_bytes - output_state->byte_write_pos;
+        uint32_t max_bytes = remaining_bytes < room ? remaining_bytes : room;
+        uint8_t* target    = &target_buffer[output_state->byte_write_pos];
+        bool     repeated;
+        uint32_t span_bytes = qp_internal_read_span(input_callback, input_state, target, max_bytes, &repeated);
+        if (span_bytes == 0) {
+            return false;
+        }
+        if (repeated) {
+            memset(target, target[0], span_bytes);
+        }
+        output_state->byte_write_pos += span_bytes;
+        remaining_bytes -= span_bytes;
 
+        // If we've hit the transmit limit, send out the entire buffer and reset the write position
+        if (output_state->byte_write_pos == output_state->max_bytes) {
+            if (!driver->driver_vtable->pixdata(output_state->device, target_buffer, output_state->byte_write_pos * 8 / driver->native_bits_per_pixel)) {
+                return false;
+            }
+            output_state->byte_write_pos = 0;
+        }
+    }
     return true;
 }
 
-// Helper shared between image and font rendering -- uses either (qp_internal_decode_palette + qp_internal_pixel_appender) or (qp_internal_send_bytes) to send data data to the display based on the asset's native-ness
+// Helper shared between image and font rendering -- decodes spans of pixels, either converting them through the palette or copying them verbatim based on the asset's native-ness
 bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state) {
     painter_driver_t* driver = (painter_driver_t*)device;
 
@@ -177,7 +252,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
         qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
         // Decode the pixel data and stream to the display
-        ret = qp_internal_decode_palette(device, pixel_count, bpp, input_callback, input_state, qp_internal_global_pixel_lookup_table, qp_internal_pixel_appender, &output_state);
+        ret = qp_internal_decode_palette_spans(pixel_count, bpp, input_callback, (qp_internal_byte_input_state_t*)input_state, qp_internal_global_pixel_lookup_table, &output_state, qp_internal_global_pixdata_buffer);
         // Any leftovers need transmission as well.
         if (ret && output_state.pixel_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.pixel_write_pos);
@@ -194,7 +269,7 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
 
         // Stream the raw pixel data to the display
         uint32_t byte_count = pixel_count * bpp / 8;
-        ret                 = qp_internal_send_bytes(device, byte_count, input_callback, input_state, qp_internal_byte_appender, &output_state);
+        ret                 = qp_internal_send_byte_spans(byte_count, input_callback, (qp_internal_byte_input_state_t*)input_state, &output_state, qp_internal_global_pixdata_buffer);
         // Any leftovers need transmission as well.
         if (ret && output_state.byte_write_pos > 0) {
             ret &= driver->driver_vtable->pixdata(device, qp_internal_global_pixdata_buffer, output_state.byte_write_pos * 8 / driver->native_bits_per_pixel);
@@ -204,6 +279,26 @@ bool qp_internal_appender(painter_device_t device, uint8_t bpp, uint32_t pixel_c
     return ret;
 }
 
+// Decodes pixels into the supplied buffer in the display's native format, without transmitting them
+bool qp_internal_decode_to_buffer(painter_device_t device, uint8_t bpp, uint32_t pixel_count, qp_internal_byte_input_callback input_callback, void* input_state, uint8_t* target_buffer) {
+    painter_driver_t* driver = (painter_driver_t*)device;
+
+    // Non-native pixel format
+    if (bpp <= 8) {
+        // The buffer never fills up, so nothing gets transmitted
+        qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = UINT32_MAX};
+        return qp_internal_decode_palette_spans(pixel_count, bpp, input_callback, (qp_internal_byte_input_state_t*)input_state, qp_internal_global_pixel_lookup_table, &output_state, target_buffer);
+    }
+
+    // Native pixel format
+    if (bpp != driver->native_bits_per_pixel) {
+        qp_dprintf("Asset's bpp (%d) doesn't match the target display's native_bits_per_pixel (%d)\n", bpp, driver->native_bits_per_pixel);
+        return false;
+    }
+    qp_internal_byte_output_state_t output_state = {.device = device, .byte_write_pos = 0, .max_bytes = UINT32_MAX};
+    return qp_internal_send_byte_spans(pixel_count * bpp / 8, input_callback, (qp_internal_byte_input_state_t*)input_state, &output_state, target_buffer);
+}
+
 qp_internal_byte_input_callback qp_internal_prepare_input_state(qp_internal_byte_input_state_t* input_state, painter_compression_t compression) {
     switch (compression) {
         case IMAGE_UNCOMPRESSED:
@@ -36,6 +36,68 @@ typedef struct qff_font_handle_t {
 
 static qff_font_handle_t font_descriptors[QUANTUM_PAINTER_NUM_FONTS] = {0};
 
+////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
+// Glyph cache
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+typedef struct qp_glyph_cache_entry_t {
+    painter_device_t         device;
+    const qff_font_handle_t *font; // NULL if the entry is unused
+    uint32_t                 code_point;
+    qp_pixel_t               fg_hsv888;
+    qp_pixel_t               bg_hsv888;
+    uint32_t                 last_used;
+    uint8_t                  width;
+    uint8_t                  pixdata[QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE];
+} qp_glyph_cache_entry_t;
+
+static qp_glyph_cache_entry_t glyph_cache[QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES] = {0};
+static uint32_t               glyph_cache_clock                                = 0;
+
+static qp_glyph_cache_entry_t *qp_glyph_cache_find(painter_device_t device, const qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        qp_glyph_cache_entry_t *entry = &glyph_cache[i];
+        if (entry->font == qff_font && entry->code_point == code_point && entry->device == device && memcmp(&entry->fg_hsv888.hsv888, &fg_hsv888.hsv888, sizeof(fg_hsv888.hsv888)) == 0 && memcmp(&entry->bg_hsv888.hsv888, &bg_hsv888.hsv888, sizeof(bg_hsv888.hsv888)) == 0) {
+            entry->last_used = ++glyph_cache_clock;
+            return entry;
+        }
+    }
+    return NULL;
+}
+
+// Claims an unused entry, or evicts the least recently used one
+static qp_glyph_cache_entry_t *qp_glyph_cache_insert(painter_device_t device, const qff_font_handle_t *qff_font, uint32_t code_point, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888) {
+    qp_glyph_cache_entry_t *entry = &glyph_cache[0];
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (!glyph_cache[i].font) {
+            entry = &glyph_cache[i];
+            break;
+        }
+        if (glyph_cache[i].last_used < entry->last_used) {
+            entry = &glyph_cache[i];
+        }
+    }
+
+    entry->device     = device;
+    entry->font       = qff_font;
+    entry->code_point = code_point;
+    entry->fg_hsv888  = fg_hsv888;
+    entry->bg_hsv888  = bg_hsv888;
+    entry->last_used  = ++glyph_cache_clock;
+    return entry;
+}
+
+static void qp_glyph_cache_invalidate_font(const qff_font_handle_t *qff_font) {
+    for (int i = 0; i < QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES; ++i) {
+        if (glyph_cache[i].font == qff_font) {
+            glyph_cache[i].font = NULL;
+        }
+    }
+}
+
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Helper: load font from stream
 
@@ -151,6 +213,11 @@ bool qp_close_font(painter_font_handle_t font) {
     }
 #endif // QUANTUM_PAINTER_LOAD_FONTS_TO_RAM
 
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Drop any glyphs rendered from this font, the slot may be reused by another
+    qp_glyph_cache_invalidate_font(qff_font);
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Free up this font for use elsewhere.
     qp_stream_close(&qff_font->stream);
     qff_font->validate_ok = false;
@@ -161,7 +228,7 @@ bool qp_close_font(painter_font_handle_t font) {
 // Helpers
 
 // Callback to be invoked for each codepoint detected in the UTF8 input string
-typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg);
+typedef bool (*code_point_handler)(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg);
 
 // Helper that sets up the palette (if required) and returns the offset in the stream that the data starts
 static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device, qff_font_handle_t *qff_font, qp_pixel_t fg_hsv888, qp_pixel_t bg_hsv888, uint32_t *data_offset) {
@@ -214,6 +281,18 @@ static inline bool qp_drawtext_prepare_font_for_render(painter_device_t device,
     return true;
 }
 
+// Helper that positions the stream at the start of a glyph's pixel data
+static inline bool qp_drawtext_seek_to_glyph_data(qff_font_handle_t *qff_font, uint32_t glyph_offset) {
+    uint32_t data_offset = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
+                           + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
+                           + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
+                           + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
+                           + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
+                           + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
+
+    return qp_stream_setpos(&qff_font->stream, data_offset) >= 0;
+}
+
 static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t *width) {
     if (code_point >= 0x20 && code_point < 0x7F && qff_font->has_ascii_table) {
         // Do ascii table
@@ -231,21 +310,12 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
             return false;
         }
 
-        uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-        uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-        uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                               + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                               + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                               + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                               + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                               + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-        if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
+        if (!qp_drawtext_seek_to_glyph_data(qff_font, (glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS)) {
             qp_dprintf("Failed to set stream position while preparing ascii glyph data\n");
             return false;
         }
 
-        *width = glyph_width;
+        *width = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
         return true;
     } else {
         // Do unicode table, which may include singular ascii glyphs if full ascii table isn't specified
@@ -253,36 +323,37 @@ static inline bool qp_drawtext_prepare_glyph_for_render(qff_font_handle_t *qff_f
                                      + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0) // Skip the ascii table
                                      + sizeof(qgf_block_header_v1_t);                                       // Skip the unicode block header
 
-        if (qp_stream_setpos(&qff_font->stream, glyph_info_offset) < 0) {
-            qp_dprintf("Failed to set stream position while preparing glyph data\n");
-            return false;
-        }
-
+        // The unicode table is sorted by code point, so binary search it
         qff_unicode_glyph_v1_t glyph_info;
-        for (uint16_t i = 0; i < qff_font->num_unicode_glyphs; ++i) {
+        uint16_t               lower = 0;
+        uint16_t               upper = qff_font->num_unicode_glyphs;
+        while (lower < upper) {
+            uint16_t middle = lower + (upper - lower) / 2;
+            if (qp_stream_setpos(&qff_font->stream, glyph_info_offset + middle * sizeof(qff_unicode_glyph_v1_t)) < 0) {
+                qp_dprintf("Failed to set stream position while preparing glyph data\n");
+                return false;
+            }
+
             if (qp_stream_read(&glyph_info, sizeof(qff_unicode_glyph_v1_t), 1, &qff_font->stream) != 1) {
                 qp_dprintf("Failed to set stream position while reading unicode glyph info\n");
                 return false;
             }
 
             if (glyph_info.code_point == code_point) {
-                uint8_t  glyph_width  = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
-                uint32_t glyph_offset = ((glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS);
-                uint32_t data_offset  = sizeof(qff_font_descriptor_v1_t)                                                                                                                   // Skip the font descriptor
-                                       + (qff_font->has_ascii_table ? sizeof(qff_ascii_glyph_table_v1_t) : 0)                                                                              // Skip the ascii table
-                                       + (qff_font->num_unicode_glyphs > 0 ? (sizeof(qff_unicode_glyph_table_v1_t) + (qff_font->num_unicode_glyphs * sizeof(qff_unicode_glyph_v1_t))) : 0) // Skip the unicode table
-                                       + (qff_font->has_palette ? (sizeof(qgf_palette_v1_t) + ((1 << qff_font->bpp) * sizeof(qgf_palette_entry_v1_t))) : 0)                                // Skip the palette
-                                       + sizeof(qgf_block_header_v1_t)                                                                                                                     // Skip the data block header
-                                       + glyph_offset;                                                                                                                                     // Jump to the specified glyph offset
-
-                if (qp_stream_setpos(&qff_font->stream, data_offset) < 0) {
+                if (!qp_drawtext_seek_to_glyph_data(qff_font, (glyph_info.value & QFF_GLYPH_OFFSET_MASK) >> QFF_GLYPH_WIDTH_BITS)) {
                     qp_dprintf("Failed to set stream position while preparing unicode glyph data\n");
                     return false;
                 }
 
-                *width = glyph_width;
+                *width = (uint8_t)(glyph_info.value & QFF_GLYPH_WIDTH_MASK);
                 return true;
             }
+
+            if (glyph_info.code_point < code_point) {
+                lower = middle + 1;
+            } else {
+                upper = middle;
+            }
         }
 
         // Not found
@@ -302,13 +373,7 @@ static inline bool qp_iterate_code_points(qff_font_handle_t *qff_font, const cha
             return false;
         }
 
-        uint8_t width;
-        if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
-            qp_dprintf("Failed to prepare glyph for rendering.\n");
-            return false;
-        }
-
-        if (!handler(qff_font, code_point, width, qff_font->base.line_height, cb_arg)) {
+        if (!handler(qff_font, code_point, cb_arg)) {
             qp_dprintf("Failed to execute glyph handler.\n");
             return false;
         }
@@ -325,9 +390,15 @@ typedef struct code_point_iter_calcwidth_state_t {
 } code_point_iter_calcwidth_state_t;
 
 // Codepoint handler callback: width calc
-static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_calcwidth(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_calcwidth_state_t *state = (code_point_iter_calcwidth_state_t *)cb_arg;
 
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
+
     // Increment the overall width by this glyph's width
     state->width += width;
 
@@ -342,19 +413,75 @@ typedef struct code_point_iter_drawglyph_state_t {
     painter_device_t                  device;
     int16_t                           xpos;
     int16_t                           ypos;
+    qp_pixel_t                        fg_hsv888;
+    qp_pixel_t                        bg_hsv888;
+    bool                              font_prepared;
     qp_internal_byte_input_callback   input_callback;
     qp_internal_byte_input_state_t *  input_state;
     qp_internal_pixel_output_state_t *output_state;
 } code_point_iter_drawglyph_state_t;
 
+// Sends a glyph's worth of native pixel data to the display, advancing the x-position for the next glyph
+static inline bool qp_drawtext_send_glyph_pixdata(code_point_iter_drawglyph_state_t *state, const uint8_t *pixdata, uint8_t width, uint8_t height) {
+    painter_driver_t *driver = (painter_driver_t *)state->device;
+
+    // Configure where we're going to be rendering to
+    driver->driver_vtable->viewport(state->device, state->xpos, state->ypos, state->xpos + width - 1, state->ypos + height - 1);
+
+    // Move the x-position for the next glyph
+    state->xpos += width;
+
+    return driver->driver_vtable->pixdata(state->device, pixdata, ((uint32_t)width) * height);
+}
+
 // Codepoint handler callback: drawing
-static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, uint8_t width, uint8_t height, void *cb_arg) {
+static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_font, uint32_t code_point, void *cb_arg) {
     code_point_iter_drawglyph_state_t *state  = (code_point_iter_drawglyph_state_t *)cb_arg;
     painter_driver_t *                 driver = (painter_driver_t *)state->device;
+    uint8_t                            height = qff_font->base.line_height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Previously rendered glyphs with the same colors skip straight to transmission
+    qp_glyph_cache_entry_t *entry = qp_glyph_cache_find(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+    if (entry) {
+        return qp_drawtext_send_glyph_pixdata(state, entry->pixdata, entry->width, height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
+    // The palette is only needed once a glyph actually needs decoding
+    if (!state->font_prepared) {
+        uint32_t data_offset;
+        if (!qp_drawtext_prepare_font_for_render(state->device, qff_font, state->fg_hsv888, state->bg_hsv888, &data_offset)) {
+            qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
+            return false;
+        }
+        state->font_prepared = true;
+    }
+
+    uint8_t width;
+    if (!qp_drawtext_prepare_glyph_for_render(qff_font, code_point, &width)) {
+        qp_dprintf("Failed to prepare glyph for rendering.\n");
+        return false;
+    }
 
-    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_iterate_code_points()
+    // Reset the input state's RLE mode -- the stream should already be correctly positioned by qp_drawtext_prepare_glyph_for_render()
     state->input_state->rle.mode = MARKER_BYTE; // ignored if not using RLE
 
+    uint32_t pixel_count = ((uint32_t)width) * height;
+
+#if QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+    // Decode into the cache if the glyph fits, then send it from there
+    if ((pixel_count * driver->native_bits_per_pixel + 7) / 8 <= QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE) {
+        entry = qp_glyph_cache_insert(state->device, qff_font, code_point, state->fg_hsv888, state->bg_hsv888);
+        if (!qp_internal_decode_to_buffer(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state, entry->pixdata)) {
+            entry->font = NULL;
+            return false;
+        }
+        entry->width = width;
+        return qp_drawtext_send_glyph_pixdata(state, entry->pixdata, width, height);
+    }
+#endif // QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES > 0
+
     // Reset the output state
     state->output_state->pixel_write_pos = 0;
 
@@ -365,7 +492,6 @@ static inline bool qp_font_code_point_handler_drawglyph(qff_font_handle_t *qff_f
     state->xpos += width;
 
     // Decode the pixel data for the glyph, and stream it
-    uint32_t pixel_count = ((uint32_t)width) * height;
     return qp_internal_appender(state->device, qff_font->bpp, pixel_count, state->input_callback, state->input_state);
 }
 
@@ -428,26 +554,27 @@ int16_t qp_drawtext_recolor(painter_device_t device, uint16_t x, uint16_t y, pai
     // Set up the pixel output state
     qp_internal_pixel_output_state_t output_state = {.device = device, .pixel_write_pos = 0, .max_pixels = qp_internal_num_pixels_in_buffer(device)};
 
-    // Set up the codepoint iteration state
+    // Fonts with a palette ignore the requested colors, so don't let them split up cached glyphs
+    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
+    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
+    if (qff_font->has_palette) {
+        fg_hsv888 = bg_hsv888 = (qp_pixel_t){.hsv888 = {.h = 0, .s = 0, .v = 0}};
+    }
+
+    // Set up the codepoint iteration state, the font is prepared for rendering on the first glyph that isn't cached
     code_point_iter_drawglyph_state_t state = {// Common
-                                               .device = device,
-                                               .xpos   = x,
-                                               .ypos   = y,
+                                               .device        = device,
+                                               .xpos          = x,
+                                               .ypos          = y,
+                                               .fg_hsv888     = fg_hsv888,
+                                               .bg_hsv888     = bg_hsv888,
+                                               .font_prepared = false,
                                                // Input
                                                .input_callback = input_callback,
                                                .input_state    = &input_state,
                                                // Output
                                                .output_state = &output_state};
 
-    qp_pixel_t fg_hsv888 = {.hsv888 = {.h = hue_fg, .s = sat_fg, .v = val_fg}};
-    qp_pixel_t bg_hsv888 = {.hsv888 = {.h = hue_bg, .s = sat_bg, .v = val_bg}};
-    uint32_t   data_offset;
-    if (!qp_drawtext_prepare_font_for_render(driver, qff_font, fg_hsv888, bg_hsv888, &data_offset)) {
-        qp_dprintf("qp_drawtext_recolor: fail (failed to prepare font for rendering)\n");
-        qp_comms_stop(device);
-        return false;
-    }
-
     // Iterate the codepoints with the drawglyph callback
     bool ret = qp_iterate_code_points(qff_font, str, qp_font_code_point_handler_drawglyph, &state);
 
@@ -3,6 +3,10 @@
 
 #include "qp_internal.h"
 
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+#    include "qp_surface_internal.h"
+#endif
+
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
 // Quantum Painter Core API: device registration
 
@@ -90,6 +94,11 @@ void qp_internal_task(void) {
     qp_lvgl_internal_tick();
 #endif
 
+#ifdef QUANTUM_PAINTER_SURFACE_ENABLE
+    // Stream out queued surface transfers
+    qp_surface_internal_tick();
+#endif
+
     // Flush (render) dirty regions to corresponding displays
 #if !defined(QUANTUM_PAINTER_DEBUG_ENABLE_FLUSH_TASK_OUTPUT)
     bool old_debug_state = debug_enable;
@@ -1,6 +1,8 @@
 // Copyright 2021 Nick Brassel (@tzarc)
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <string.h>
+
 #include "qp_stream.h"
 
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -9,6 +11,10 @@
 uint32_t qp_stream_read_impl(void *output_buf, uint32_t member_size, uint32_t num_members, qp_stream_t *stream) {
     uint8_t *output_ptr = (uint8_t *)output_buf;
 
+    if (stream->read) {
+        return stream->read(stream, output_buf, num_members * member_size) / member_size;
+    }
+
     uint32_t i;
     for (i = 0; i < (num_members * member_size); ++i) {
         int16_t c = qp_stream_get(stream);
@@ -47,6 +53,18 @@ static inline int16_t mem_get(qp_stream_t *stream) {
     return s->buffer[s->position++];
 }
 
+static inline uint32_t mem_read(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_memory_stream_t *s         = (qp_memory_stream_t *)stream;
+    int32_t             available = s->length - s->position;
+    if (available < 0 || length > (uint32_t)available) {
+        length    = available < 0 ? 0 : available;
+        s->is_eof = true;
+    }
+    memcpy(output_buf, &s->buffer[s->position], length);
+    s->position += length;
+    return length;
+}
+
 static inline bool mem_put(qp_stream_t *stream, uint8_t c) {
     qp_memory_stream_t *s = (qp_memory_stream_t *)stream;
     if (s->position >= s->length) {
@@ -111,7 +129,7 @@ static inline void mem_close(qp_stream_t *stream) {
 
 qp_memory_stream_t qp_make_memory_stream(void *buffer, int32_t length) {
     qp_memory_stream_t stream = {
-        .base     = {.get = mem_get, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
+        .base     = {.get = mem_get, .read = mem_read, .put = mem_put, .seek = mem_seek, .tell = mem_tell, .is_eof = mem_is_eof, .close = mem_close},
         .buffer   = (uint8_t *)buffer,
         .length   = length,
         .position = 0,
@@ -131,6 +149,11 @@ static inline int16_t file_get(qp_stream_t *stream) {
     return (uint16_t)c;
 }
 
+static inline uint32_t file_read(qp_stream_t *stream, void *output_buf, uint32_t length) {
+    qp_file_stream_t *s = (qp_file_stream_t *)stream;
+    return (uint32_t)fread(output_buf, 1, length, s->file);
+}
+
 static inline bool file_put(qp_stream_t *stream, uint8_t c) {
     qp_file_stream_t *s = (qp_file_stream_t *)stream;
     return fputc(c, s->file) == c;
@@ -158,7 +181,7 @@ static inline void file_close(qp_stream_t *stream) {
 
 qp_file_stream_t qp_make_file_stream(FILE *f) {
     qp_file_stream_t stream = {
-        .base = {.get = file_get, .put = file_put, .seek = file_seek, .tell = file_tell, .is_eof = file_is_eof, .close = file_close},
+        .base = {.get = file_get, .read = file_read, .put = file_put, .seek = file_seek, .tell = file_tell, .is_eof = file_is_eof, .close = file_close},
         .file = f,
     };
     return stream;
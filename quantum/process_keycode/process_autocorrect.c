@@ -19,9 +19,32 @@
 #    include "autocorrect_data_default.h"
 #endif
 
+#ifndef AUTOCORRECT_OFFSET_SIZE
+#    define AUTOCORRECT_OFFSET_SIZE 2
+#endif
+
+#if AUTOCORRECT_OFFSET_SIZE == 2
+typedef uint16_t autocorrect_offset_t;
+#elif AUTOCORRECT_OFFSET_SIZE == 4
+#    ifdef __AVR__
+#        error "Autocorrect dictionaries with 32-bit offsets are not supported on AVR, reduce the dictionary to fewer entries"
+#    endif
+typedef uint32_t autocorrect_offset_t;
+#else
+#    error "AUTOCORRECT_OFFSET_SIZE must be 2 or 4"
+#endif
+
+// Circular buffer of the latest keys, `typo_buffer_head` being the newest
 static uint8_t typo_buffer[AUTOCORRECT_MAX_LENGTH] = {KC_SPC};
+static uint8_t typo_buffer_head                    = 0;
 static uint8_t typo_buffer_size                    = 1;
 
+// Children of the root node for each key that can be in the typo buffer: KC_A to KC_Z, KC_SPC and KC_QUOTE
+#define AUTOCORRECT_ROOT_KEYS 28
+
+static autocorrect_offset_t root_cache[AUTOCORRECT_ROOT_KEYS];
+static bool                 root_cache_valid = false;
+
 /**
  * @brief function for querying the enabled state of autocorrect
  *
@@ -188,6 +211,90 @@ __attribute__((weak)) bool apply_autocorrect(uint8_t backspaces, const char *str
     return true;
 }
 
+/**
+ * @brief Gets a key from the typo buffer
+ *
+ * @param i position of the key, 0 being the oldest
+ * @return the keycode
+ */
+static inline uint8_t typo_buffer_get(uint8_t i) {
+    uint8_t pos = typo_buffer_head + 1 + i + (AUTOCORRECT_MAX_LENGTH - typo_buffer_size);
+    return typo_buffer[pos >= AUTOCORRECT_MAX_LENGTH ? pos - AUTOCORRECT_MAX_LENGTH : pos];
+}
+
+/**
+ * @brief Reads a node link from the trie
+ *
+ * @param offset position of the link in `autocorrect_data`
+ * @return the offset of the linked node
+ */
+static inline autocorrect_offset_t autocorrect_read_link(autocorrect_offset_t offset) {
+    autocorrect_offset_t link = 0;
+    for (uint8_t i = AUTOCORRECT_OFFSET_SIZE; i > 0; --i) {
+        link = (link << 8) | pgm_read_byte(autocorrect_data + offset + i - 1);
+    }
+    return link;
+}
+
+/**
+ * @brief Follows the trie from a chain or branching node
+ *
+ * @param state offset of the node in `autocorrect_data`
+ * @param key keycode to follow
+ * @return the offset of the child node, or 0 if there is no child for `key`
+ */
+static autocorrect_offset_t autocorrect_next_state(autocorrect_offset_t state, uint8_t key) {
+    uint8_t code = pgm_read_byte(autocorrect_data + state);
+
+    if (code & 64) { // Check for match in node with multiple children.
+        code &= 63;
+        for (; code != key; code = pgm_read_byte(autocorrect_data + (state += 1 + AUTOCORRECT_OFFSET_SIZE))) {
+            if (!code) return 0;
+        }
+        // Follow link to child node.
+        return autocorrect_read_link(state + 1);
+    }
+
+    // Check for match in node with single child.
+    if (code != key) {
+        return 0;
+    }
+    if (!pgm_read_byte(autocorrect_data + (++state))) {
+        ++state;
+    }
+    return state;
+}
+
+/**
+ * @brief Gets the root cache entry of a key from the typo buffer
+ *
+ * @param key KC_A to KC_Z, KC_SPC or KC_QUOTE
+ * @return index into `root_cache`
+ */
+static inline uint8_t autocorrect_root_index(uint8_t key) {
+    switch (key) {
+        case KC_SPC:
+            return 26;
+        case KC_QUOTE:
+            return 27;
+        default:
+            return key - KC_A;
+    }
+}
+
+/**
+ * @brief Resolves the children of the root node once, so that the widest node
+ *        of the trie isn't searched on every keypress
+ */
+static void autocorrect_fill_root_cache(void) {
+    for (uint8_t key = KC_A; key <= KC_Z; ++key) {
+        root_cache[autocorrect_root_index(key)] = autocorrect_next_state(0, key);
+    }
+    root_cache[autocorrect_root_index(KC_SPC)]   = autocorrect_next_state(0, KC_SPC);
+    root_cache[autocorrect_root_index(KC_QUOTE)] = autocorrect_next_state(0, KC_QUOTE);
+    root_cache_valid                             = true;
+}
+
 /**
  * @brief Process handler for autocorrect feature
  *
@@ -251,6 +358,7 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             // Remove last character from the buffer.
             if (typo_buffer_size > 0) {
                 --typo_buffer_size;
+                typo_buffer_head = (typo_buffer_head ? typo_buffer_head : AUTOCORRECT_MAX_LENGTH) - 1;
             }
             return true;
         case KC_QUOTE:
@@ -265,46 +373,35 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             return true;
     }
 
-    // Rotate oldest character if buffer is full.
-    if (typo_buffer_size >= AUTOCORRECT_MAX_LENGTH) {
-        memmove(typo_buffer, typo_buffer + 1, AUTOCORRECT_MAX_LENGTH - 1);
-        typo_buffer_size = AUTOCORRECT_MAX_LENGTH - 1;
+    // Append `keycode` to buffer, overwriting the oldest character if it is full.
+    if (++typo_buffer_head >= AUTOCORRECT_MAX_LENGTH) {
+        typo_buffer_head = 0;
+    }
+    typo_buffer[typo_buffer_head] = keycode;
+    if (typo_buffer_size < AUTOCORRECT_MAX_LENGTH) {
+        ++typo_buffer_size;
     }
-
-    // Append `keycode` to buffer.
-    typo_buffer[typo_buffer_size++] = keycode;
     // Return if buffer is smaller than the shortest word.
     if (typo_buffer_size < AUTOCORRECT_MIN_LENGTH) {
         return true;
     }
 
-    // Check for typo in buffer using a trie stored in `autocorrect_data`.
-    uint16_t state = 0;
-    uint8_t  code  = pgm_read_byte(autocorrect_data + state);
-    for (int8_t i = typo_buffer_size - 1; i >= 0; --i) {
-        uint8_t const key_i = typo_buffer[i];
-
-        if (code & 64) { // Check for match in node with multiple children.
-            code &= 63;
-            for (; code != key_i; code = pgm_read_byte(autocorrect_data + (state += 3))) {
-                if (!code) return true;
-            }
-            // Follow link to child node.
-            state = (pgm_read_byte(autocorrect_data + state + 1) | pgm_read_byte(autocorrect_data + state + 2) << 8);
-            // Check for match in node with single child.
-        } else if (code != key_i) {
-            return true;
-        } else if (!(code = pgm_read_byte(autocorrect_data + (++state)))) {
-            ++state;
-        }
-
-        // Stop if `state` becomes an invalid index. This should not normally
-        // happen, it is a safeguard in case of a bug, data corruption, etc.
-        if (state >= DICTIONARY_SIZE) {
+    // Check for typo in buffer using a trie stored in `autocorrect_data`,
+    // walking back from the newest key. The first level comes from the cache.
+    if (!root_cache_valid) {
+        autocorrect_fill_root_cache();
+    }
+    uint8_t              pos   = typo_buffer_head;
+    autocorrect_offset_t state = root_cache[autocorrect_root_index(keycode)];
+    for (uint8_t depth = 1;; ++depth) {
+        // Stop if there is no match, or if `state` becomes an invalid index.
+        // The latter should not normally happen, it is a safeguard in case of
+        // a bug, data corruption, etc.
+        if (!state || state >= DICTIONARY_SIZE) {
             return true;
         }
 
-        code = pgm_read_byte(autocorrect_data + state);
+        uint8_t code = pgm_read_byte(autocorrect_data + state);
 
         if (code & 128) { // A typo was found! Apply autocorrect.
             const uint8_t backspaces = (code & 63) + !record->event.pressed;
@@ -319,10 +416,10 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
 
             uint8_t typo_len   = 0;
             uint8_t typo_start = 0;
-            bool    space_last = typo_buffer[typo_buffer_size - 1] == KC_SPC;
+            bool    space_last = keycode == KC_SPC;
             for (uint8_t i = typo_buffer_size; i > 0; --i) {
                 // stop counting after finding space (unless it is the last thing)
-                if (typo_buffer[i - 1] == KC_SPC && i != typo_buffer_size) {
+                if (typo_buffer_get(i - 1) == KC_SPC && i != typo_buffer_size) {
                     typo_start = i;
                     break;
                 }
@@ -337,7 +434,7 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
 
             // convert buffer of keycodes into a string
             for (uint8_t i = 0; i < typo_len; ++i) {
-                typo[i] = typo_buffer[typo_start + i] - KC_A + 'a';
+                typo[i] = typo_buffer_get(typo_start + i) - KC_A + 'a';
             }
 
             /* Gather the corrected word
@@ -362,7 +459,7 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
             }
 
             if (keycode == KC_SPC) {
-                typo_buffer[0]   = KC_SPC;
+                // The newest key is the space, keep it as the start of the next word
                 typo_buffer_size = 1;
                 return true;
             } else {
@@ -370,6 +467,11 @@ bool process_autocorrect(uint16_t keycode, keyrecord_t *record) {
                 return false;
             }
         }
+
+        if (depth >= typo_buffer_size) {
+            return true;
+        }
+        pos   = (pos ? pos : AUTOCORRECT_MAX_LENGTH) - 1;
+        state = autocorrect_next_state(state, typo_buffer[pos]);
     }
-    return true;
 }
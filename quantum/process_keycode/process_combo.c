@@ -16,6 +16,7 @@
 
 #include "process_combo.h"
 #include <stddef.h>
+#include <string.h>
 #include "process_auto_shift.h"
 #include "caps_word.h"
 #include "timer.h"
@@ -94,6 +95,19 @@ static queued_combo_t combo_buffer[COMBO_BUFFER_LENGTH];
 
 #define INCREMENT_MOD(i) i = (i + 1) % COMBO_BUFFER_LENGTH
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+/* Inverted index from keycode to the combos containing it, sorted by keycode
+ * and then by combo index so that candidates are visited in combo order. */
+typedef struct {
+    uint16_t keycode;
+    uint16_t combo_index;
+} combo_key_index_t;
+static uint16_t          combo_key_index_size  = 0;
+static bool              combo_key_index_ready = false;
+static bool              combo_key_index_full  = false;
+static combo_key_index_t combo_key_index[COMBO_KEY_INDEX_LENGTH];
+#endif
+
 #ifndef EXTRA_SHORT_COMBOS
 /* flags are their own elements in combo_t struct. */
 #    define COMBO_ACTIVE(combo) (combo->active)
@@ -269,6 +283,71 @@ static inline void dump_key_buffer(void) {
         state &= ~(1 << key_index);    \
     } while (0)
 
+#ifdef COMBO_KEY_INDEX_LENGTH
+static void combo_key_index_build(void) {
+    combo_key_index_size  = 0;
+    combo_key_index_full  = false;
+    combo_key_index_ready = true;
+
+    for (uint16_t combo_index = 0; combo_index < combo_count(); ++combo_index) {
+        combo_t *combo = combo_get(combo_index);
+        uint16_t key;
+
+        for (uint8_t key_i = 0; (key = pgm_read_word(&combo->keys[key_i])) != COMBO_END; ++key_i) {
+            /* Insertion sort, combos are visited in ascending order so equal
+             * keycodes stay sorted by combo index. */
+            uint16_t pos = combo_key_index_size;
+            while (pos > 0 && combo_key_index[pos - 1].keycode > key) {
+                pos--;
+            }
+
+            if (pos > 0 && combo_key_index[pos - 1].keycode == key && combo_key_index[pos - 1].combo_index == combo_index) {
+                // key is listed more than once in this combo
+                continue;
+            }
+
+            if (combo_key_index_size >= COMBO_KEY_INDEX_LENGTH) {
+                // index can't hold all combo keys, fall back to a linear search
+                combo_key_index_full = true;
+                return;
+            }
+
+            memmove(&combo_key_index[pos + 1], &combo_key_index[pos], (combo_key_index_size - pos) * sizeof(combo_key_index_t));
+            combo_key_index[pos] = (combo_key_index_t){
+                .keycode     = key,
+                .combo_index = combo_index,
+            };
+            combo_key_index_size++;
+        }
+    }
+}
+
+/* Returns the position of the first index entry for keycode, or the position
+ * it would be inserted at if no combo contains keycode. */
+static uint16_t combo_key_index_find(uint16_t keycode) {
+    uint16_t lo = 0, hi = combo_key_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (combo_key_index[mid].keycode < keycode) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
+void combo_init(void) {
+    combo_rebuild_index();
+}
+
+void combo_rebuild_index(void) {
+#ifdef COMBO_KEY_INDEX_LENGTH
+    combo_key_index_build();
+#endif
+}
+
 static inline void _find_key_index_and_count(const uint16_t *keys, uint16_t keycode, uint16_t *key_index, uint8_t *key_count) {
     while (true) {
         uint16_t key = pgm_read_word(&keys[*key_count]);
@@ -535,8 +614,7 @@ static bool process_single_combo(combo_t *combo, uint16_t keycode, keyrecord_t *
 }
 
 bool process_combo(uint16_t keycode, keyrecord_t *record) {
-    bool is_combo_key          = false;
-    bool no_combo_keys_pressed = true;
+    bool is_combo_key = false;
 
     if (keycode == QK_COMBO_ON && record->event.pressed) {
         combo_enable();
@@ -564,10 +642,21 @@ bool process_combo(uint16_t keycode, keyrecord_t *record) {
     }
 #endif
 
-    for (uint16_t idx = 0; idx < combo_count(); ++idx) {
-        combo_t *combo = combo_get(idx);
-        is_combo_key |= process_single_combo(combo, keycode, record, idx);
-        no_combo_keys_pressed = no_combo_keys_pressed && (NO_COMBO_KEYS_ARE_DOWN || COMBO_ACTIVE(combo) || COMBO_DISABLED(combo));
+#ifdef COMBO_KEY_INDEX_LENGTH
+    if (combo_key_index_ready && !combo_key_index_full) {
+        /* Only visit the combos that contain this keycode, the others would
+         * ignore it anyway. */
+        for (uint16_t i = combo_key_index_find(keycode); i < combo_key_index_size && combo_key_index[i].keycode == keycode; ++i) {
+            uint16_t idx = combo_key_index[i].combo_index;
+            is_combo_key |= process_single_combo(combo_get(idx), keycode, record, idx);
+        }
+    } else
+#endif
+    {
+        for (uint16_t idx = 0; idx < combo_count(); ++idx) {
+            combo_t *combo = combo_get(idx);
+            is_combo_key |= process_single_combo(combo, keycode, record, idx);
+        }
     }
 
     if (record->event.pressed && is_combo_key) {
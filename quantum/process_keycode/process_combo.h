@@ -77,6 +77,9 @@ bool process_combo(uint16_t keycode, keyrecord_t *record);
 void combo_task(void);
 void process_combo_event(uint16_t combo_index, bool pressed);
 
+void combo_init(void);
+void combo_rebuild_index(void);
+
 void combo_enable(void);
 void combo_disable(void);
 void combo_toggle(void);
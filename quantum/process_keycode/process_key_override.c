@@ -16,6 +16,7 @@
  */
 
 #include "process_key_override.h"
+#include <string.h>
 #include "report.h"
 #include "timer.h"
 #include "debug.h"
@@ -84,6 +85,18 @@ static uint16_t deferred_register = 0;
 // TODO: in future maybe save in EEPROM?
 static bool enabled = true;
 
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+// Index from trigger keycode to the overrides it triggers, sorted by trigger and then by override index so that candidates are visited in array order. Overrides triggered by modifiers only (KC_NO) sort first.
+typedef struct {
+    uint16_t trigger;
+    uint16_t override_index;
+} key_override_index_t;
+static uint16_t             key_override_index_size  = 0;
+static bool                 key_override_index_ready = false;
+static bool                 key_override_index_full  = false;
+static key_override_index_t key_override_index[KEY_OVERRIDE_INDEX_LENGTH];
+#endif
+
 // Forward decls
 static const key_override_t *clear_active_override(const bool allow_reregister);
 
@@ -243,147 +256,251 @@ static bool check_activation_event(const key_override_t *override, const bool ke
     }
 }
 
-/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
-static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
-    if (key_override_count() == 0) {
-        return true;
+/** Checks if the provided override should activate on this key event, given the active mods and the last non-mod key that was pressed down. Has no side effects. */
+static bool override_should_activate(const key_override_t *override, const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
+    if (active_mods == 0 && override->trigger_mods != 0) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
     }
 
-    for (uint8_t i = 0; i < key_override_count(); i++) {
-        const key_override_t *const override = key_override_get(i);
-
-        // End of array
-        if (override == NULL) {
-            break;
-        }
+    // Check layer
+    if ((override->layers & (1 << layer)) == 0) {
+        key_override_printf("Not activating override: Not set to activate on pressed layer\n");
+        return false;
+    }
 
-        // Fast, but not full mods check. Most key presses will not have any mods down, and most overrides will require mods. Hence here we filter overrides that require mods to be down while no mods are down
-        if (active_mods == 0 && override->trigger_mods != 0) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // Check allowed activation events
+    if (!check_activation_event(override, key_down, is_mod)) {
+        key_override_printf("Not activating override: Activation event not allowed\n");
+        return false;
+    }
 
-        // Check layer
-        if ((override->layers & (1 << layer)) == 0) {
-            key_override_printf("Not activating override: Not set to activate on pressed layer\n");
-            continue;
-        }
+    const bool is_trigger = override->trigger == keycode;
 
-        // Check allowed activation events
-        if (!check_activation_event(override, key_down, is_mod)) {
-            key_override_printf("Not activating override: Activation event not allowed\n");
-            continue;
-        }
+    // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
+    if (is_trigger && !key_down) {
+        key_override_printf("Not activating override: Trigger lifted\n");
+        return false;
+    }
 
-        const bool is_trigger = override->trigger == keycode;
+    // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
+    const bool no_trigger = override->trigger == KC_NO;
 
-        // Check if trigger lifted. This is a small optimization in order to skip the remaining checks
-        if (is_trigger && !key_down) {
-            key_override_printf("Not activating override: Trigger lifted\n");
-            continue;
-        }
+    // Check if aleady active
+    if (override == active_override) {
+        key_override_printf("Not activating override: Alerady actived\n");
+        return false;
+    }
 
-        // If the trigger is KC_NO it means 'no key', so only the required modifiers need to be down.
-        const bool no_trigger = override->trigger == KC_NO;
+    // Check if enabled
+    if (override->enabled != NULL && !((*(override->enabled) & 1))) {
+        key_override_printf("Not activating override: Not enabled\n");
+        return false;
+    }
 
-        // Check if aleady active
-        if (override == active_override) {
-            key_override_printf("Not activating override: Alerady actived\n");
-            continue;
-        }
+    // Check mods precisely
+    if (!key_override_matches_active_modifiers(override, active_mods)) {
+        key_override_printf("Not activating override: Modifiers don't match\n");
+        return false;
+    }
 
-        // Check if enabled
-        if (override->enabled != NULL && !((*(override->enabled) & 1))) {
-            key_override_printf("Not activating override: Not enabled\n");
-            continue;
-        }
+    // Check if trigger key is down.
+    const bool trigger_down = is_trigger && key_down;
 
-        // Check mods precisely
-        if (!key_override_matches_active_modifiers(override, active_mods)) {
-            key_override_printf("Not activating override: Modifiers don't match\n");
-            continue;
-        }
+    // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
+    // If no trigger key is required, yes.
+    // If the trigger was just pressed, yes.
+    // If the last non-mod key that was pressed down is the trigger key, yes.
+    bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
 
-        // Check if trigger key is down.
-        const bool trigger_down = is_trigger && key_down;
+    if (!should_activate) {
+        key_override_printf("Not activating override. Trigger not down\n");
+        return false;
+    }
 
-        // At this point, all requirements for activation are checked, except whether the trigger key is pressed. Now we check if the required trigger is down
-        // If no trigger key is required, yes.
-        // If the trigger was just pressed, yes.
-        // If the last non-mod key that was pressed down is the trigger key, yes.
-        bool should_activate = no_trigger || trigger_down || last_key_down == override->trigger;
+    return true;
+}
 
-        if (!should_activate) {
-            key_override_printf("Not activating override. Trigger not down\n");
-            continue;
-        }
+/** Activates the provided override, which override_should_activate() accepted for this key event. Returns true if the key action for `keycode` should be sent */
+static bool activate_override(const key_override_t *override, const uint16_t keycode, const bool key_down, const bool is_mod, const uint8_t active_mods) {
+    const bool no_trigger   = override->trigger == KC_NO;
+    const bool trigger_down = override->trigger == keycode && key_down;
 
-        key_override_printf("Activating override\n");
+    key_override_printf("Activating override\n");
 
-        clear_active_override(false);
+    clear_active_override(false);
 
 #ifdef DUMMY_MOD_NEUTRALIZER_KEYCODE
-        // Send a dummy keycode before unregistering the modifier(s)
-        // so that suppressing the modifier(s) doesn't falsely get interpreted
-        // by the host OS as a tap of a modifier key.
-        // For example, unintended activations of the start menu on Windows when
-        // using a GUI+<kc> key override with suppressed mods.
-        neutralize_flashing_modifiers(active_mods);
+    // Send a dummy keycode before unregistering the modifier(s)
+    // so that suppressing the modifier(s) doesn't falsely get interpreted
+    // by the host OS as a tap of a modifier key.
+    // For example, unintended activations of the start menu on Windows when
+    // using a GUI+<kc> key override with suppressed mods.
+    neutralize_flashing_modifiers(active_mods);
 #endif
 
-        active_override                 = override;
-        active_override_trigger_is_down = true;
+    active_override                 = override;
+    active_override_trigger_is_down = true;
 
-        set_suppressed_override_mods(override->suppressed_mods);
+    set_suppressed_override_mods(override->suppressed_mods);
 
-        if (!trigger_down && !no_trigger) {
-            // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
-            if (IS_BASIC_KEYCODE(override->trigger)) {
-                del_key(override->trigger);
+    if (!trigger_down && !no_trigger) {
+        // When activating a key override the trigger is is always unregistered. In the case where the key that newly pressed is not the trigger key, we have to explicitly remove the trigger key from the keyboard report. If the trigger was just pressed down we simply suppress the event which also has the effect of the trigger key not being registered in the keyboard report.
+        if (IS_BASIC_KEYCODE(override->trigger)) {
+            del_key(override->trigger);
+        } else {
+            unregister_code(override->trigger);
+        }
+    }
+
+    const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+
+    bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
+                                mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+
+    // Try firing the custom handler
+    if (override->custom_action != NULL) {
+        register_replacement &= override->custom_action(true, override->context);
+    }
+
+    if (register_replacement) {
+        const uint8_t override_mods = extract_mod_bits(override->replacement);
+        set_weak_override_mods(override_mods);
+
+        // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
+        if (is_mod) {
+            key_override_printf("Deferring register replacement key\n");
+            schedule_deferred_register(mod_free_replacement);
+            send_keyboard_report();
+        } else {
+            if (IS_BASIC_KEYCODE(mod_free_replacement)) {
+                add_key(mod_free_replacement);
             } else {
-                unregister_code(override->trigger);
+                key_override_printf("NOT KEY 2\n");
+                send_keyboard_report();
+                // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
+                wait_ms(10);
+                register_code(mod_free_replacement);
             }
         }
+    } else {
+        // If not registering the replacement key send keyboard report to update the unregistered keys.
+        send_keyboard_report();
+    }
 
-        const uint16_t mod_free_replacement = clear_mods_from(override->replacement);
+    // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
+    return !trigger_down;
+}
 
-        bool register_replacement = mod_free_replacement != KC_NO &&   // KC_NO is never registered
-                                    mod_free_replacement < SAFE_RANGE; // Custom keycodes are never registered
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+static void key_override_index_build(void) {
+    key_override_index_size  = 0;
+    key_override_index_full  = false;
+    key_override_index_ready = true;
 
-        // Try firing the custom handler
-        if (override->custom_action != NULL) {
-            register_replacement &= override->custom_action(true, override->context);
+    for (uint16_t i = 0; i < key_override_count(); i++) {
+        const key_override_t *const override = key_override_get(i);
+
+        // End of array
+        if (override == NULL) {
+            break;
         }
 
-        if (register_replacement) {
-            const uint8_t override_mods = extract_mod_bits(override->replacement);
-            set_weak_override_mods(override_mods);
+        if (key_override_index_size >= KEY_OVERRIDE_INDEX_LENGTH) {
+            // Index can't hold all overrides, fall back to a linear search
+            key_override_index_full = true;
+            return;
+        }
 
-            // If this is a modifier event that activates the key override we _always_ defer the actual full activation of the override
-            if (is_mod) {
-                key_override_printf("Deferring register replacement key\n");
-                schedule_deferred_register(mod_free_replacement);
-                send_keyboard_report();
-            } else {
-                if (IS_BASIC_KEYCODE(mod_free_replacement)) {
-                    add_key(mod_free_replacement);
-                } else {
-                    key_override_printf("NOT KEY 2\n");
-                    send_keyboard_report();
-                    // On macOS there seems to be a race condition when it comes to the keyboard report and consumer keycodes. It seems the OS may recognize a consumer keycode before an updated keyboard report, even if the keyboard report is actually sent before the consumer key. I assume it is some sort of race condition because it happens infrequently and very irregularly. Waiting for about at least 10ms between sending the keyboard report and sending the consumer code has shown to fix this.
-                    wait_ms(10);
-                    register_code(mod_free_replacement);
+        // Insertion sort, overrides are visited in ascending order so equal triggers stay sorted by override index
+        uint16_t pos = key_override_index_size;
+        while (pos > 0 && key_override_index[pos - 1].trigger > override->trigger) {
+            pos--;
+        }
+        memmove(&key_override_index[pos + 1], &key_override_index[pos], (key_override_index_size - pos) * sizeof(key_override_index_t));
+        key_override_index[pos] = (key_override_index_t){
+            .trigger        = override->trigger,
+            .override_index = i,
+        };
+        key_override_index_size++;
+    }
+}
+
+/** Returns the position of the first index entry for trigger, or the position it would be inserted at if no override has that trigger. */
+static uint16_t key_override_index_find(uint16_t trigger) {
+    uint16_t lo = 0, hi = key_override_index_size;
+    while (lo < hi) {
+        uint16_t mid = lo + (hi - lo) / 2;
+        if (key_override_index[mid].trigger < trigger) {
+            lo = mid + 1;
+        } else {
+            hi = mid;
+        }
+    }
+    return lo;
+}
+#endif
+
+void key_override_init(void) {
+    key_override_rebuild_index();
+}
+
+void key_override_rebuild_index(void) {
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+    key_override_index_build();
+#endif
+}
+
+/** Iterates through the list of key overrides and tries activating each, until it finds one that activates or reaches the end of overrides. Returns true if the key action for `keycode` should be sent */
+static bool try_activating_override(const uint16_t keycode, const uint8_t layer, const bool key_down, const bool is_mod, const uint8_t active_mods, bool *activated) {
+    if (key_override_count() == 0) {
+        return true;
+    }
+
+#ifdef KEY_OVERRIDE_INDEX_LENGTH
+    if (key_override_index_ready && !key_override_index_full) {
+        // Only overrides without a trigger, triggered by this key or by the last non-mod key that was pressed down can activate. Look up the first one of each that would activate, and activate the one earliest in the array.
+        const uint16_t triggers[] = {KC_NO, keycode, last_key_down};
+        uint16_t       first      = UINT16_MAX;
+
+        for (uint8_t t = 0; t < ARRAY_SIZE(triggers); t++) {
+            if ((t > 0 && triggers[t] == triggers[0]) || (t > 1 && triggers[t] == triggers[1])) {
+                continue;
+            }
+
+            // Overrides without a trigger sort first, no need to search for them
+            for (uint16_t i = t == 0 ? 0 : key_override_index_find(triggers[t]); i < key_override_index_size && key_override_index[i].trigger == triggers[t] && key_override_index[i].override_index < first; i++) {
+                const key_override_t *const override = key_override_get(key_override_index[i].override_index);
+                if (override != NULL && override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+                    first = key_override_index[i].override_index;
+                    break;
                 }
             }
-        } else {
-            // If not registering the replacement key send keyboard report to update the unregistered keys.
-            send_keyboard_report();
         }
 
-        *activated = true;
+        if (first != UINT16_MAX) {
+            *activated = true;
+            return activate_override(key_override_get(first), keycode, key_down, is_mod, active_mods);
+        }
 
-        // If the trigger is down, suppress the event so that it does not get added to the keyboard report.
-        return !trigger_down;
+        *activated = false;
+        return true;
+    }
+#endif
+
+    for (uint16_t i = 0; i < key_override_count(); i++) {
+        const key_override_t *const override = key_override_get(i);
+
+        // End of array
+        if (override == NULL) {
+            break;
+        }
+
+        if (override_should_activate(override, keycode, layer, key_down, is_mod, active_mods)) {
+            *activated = true;
+            return activate_override(override, keycode, key_down, is_mod, active_mods);
+        }
     }
 
     *activated = false;
@@ -105,6 +105,12 @@ bool process_key_override(const uint16_t keycode, const keyrecord_t *const recor
 /** Perform any deferred keys */
 void key_override_task(void);
 
+/** Builds the trigger index used with KEY_OVERRIDE_INDEX_LENGTH, called by keyboard_init() */
+void key_override_init(void);
+
+/** Rebuilds the trigger index used with KEY_OVERRIDE_INDEX_LENGTH, call it whenever key_override_count() or key_override_get() change */
+void key_override_rebuild_index(void);
+
 /**
  *  Preferrably use these macros to create key overrides. They fix many of the options to a standard setting that should satisfy most basic use-cases. Only directly create a key_override_t struct when you really need to.
  */
@@ -72,6 +72,10 @@
 #    include "process_unicode_common.h"
 #endif
 
+#ifdef EEPROM_DRIVER
+#    include "eeprom_driver.h"
+#endif
+
 #ifdef AUDIO_ENABLE
 #    ifndef GOODBYE_SONG
 #        define GOODBYE_SONG SONG(GOODBYE_SOUND)
@@ -178,6 +182,12 @@ __attribute__((weak)) void post_process_record_user(uint16_t keycode, keyrecord_
 
 void shutdown_quantum(bool jump_to_bootloader) {
     clear_keyboard();
+#ifdef DYNAMIC_KEYMAP_ENABLE
+    dynamic_keymap_flush();
+#endif
+#ifdef EEPROM_DRIVER
+    eeprom_driver_flush();
+#endif
 #if defined(MIDI_ENABLE) && defined(MIDI_BASIC)
     process_midi_all_notes_off();
 #endif
@@ -233,15 +243,15 @@ uint16_t get_event_keycode(keyevent_t event, bool update_layer_cache) {
         uint8_t layer;
 
         if (event.pressed && update_layer_cache) {
-            layer = layer_switch_get_layer(event.key);
+            uint16_t keycode = layer_switch_get_keycode(event.key, &layer);
             update_source_layers_cache(event.key, layer);
-        } else {
-            layer = read_source_layers_cache(event.key);
+            return keycode;
         }
+        layer = read_source_layers_cache(event.key);
         return keymap_key_to_keycode(layer, event.key);
     } else
 #endif
-        return keymap_key_to_keycode(layer_switch_get_layer(event.key), event.key);
+        return layer_switch_get_keycode(event.key, NULL);
 }
 
 /* Get keycode, and then process pre tapping functionality */
@@ -260,6 +270,162 @@ void post_process_record_quantum(keyrecord_t *record) {
     post_process_record_kb(keycode, record);
 }
 
+#ifndef PROCESS_RECORD_LEGACY_DISPATCH
+#    define PROCESS_RECORD_PRESSED (1 << 0)
+#    define PROCESS_RECORD_RELEASED (1 << 1)
+#    define PROCESS_RECORD_ALL_EVENTS (PROCESS_RECORD_PRESSED | PROCESS_RECORD_RELEASED)
+
+#    define PROCESS_RECORD_HANDLER(func, first, last, event_mask) \
+        { .handler = (func), .min = (first), .max = (last), .events = (event_mask) }
+#    define PROCESS_RECORD_ANY_KEYCODE(func) PROCESS_RECORD_HANDLER(func, 0x0000, 0xFFFF, PROCESS_RECORD_ALL_EVENTS)
+
+typedef struct {
+    bool (*handler)(uint16_t keycode, keyrecord_t *record);
+    uint16_t min;
+    uint16_t max;
+    uint8_t  events;
+} process_record_handler_t;
+
+#    ifdef KEY_OVERRIDE_ENABLE
+static bool process_key_override_record(uint16_t keycode, keyrecord_t *record) {
+    return process_key_override(keycode, record);
+}
+#    endif
+
+#    if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+static bool process_rgb_record(uint16_t keycode, keyrecord_t *record) {
+    return process_rgb(keycode, record);
+}
+#    endif
+
+/* Handlers called for each record, in order, until one of them returns false.
+ * Handlers that only act on their own keycodes declare that range, along with
+ * the events they act on, and are skipped for everything else -- they would
+ * have returned true without doing anything anyway.
+ */
+static const process_record_handler_t process_record_handlers[] PROGMEM = {
+#    if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
+    // Must run asap to ensure all keypresses are recorded.
+    PROCESS_RECORD_ANY_KEYCODE(process_dynamic_macro),
+#    endif
+#    ifdef REPEAT_KEY_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_last_key),
+    PROCESS_RECORD_ANY_KEYCODE(process_repeat_key),
+#    endif
+#    if defined(AUDIO_ENABLE) && defined(AUDIO_CLICKY)
+    PROCESS_RECORD_ANY_KEYCODE(process_clicky),
+#    endif
+#    ifdef HAPTIC_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_haptic),
+#    endif
+#    if defined(VIA_ENABLE)
+    PROCESS_RECORD_HANDLER(process_record_via, QK_MACRO, QK_MACRO_MAX, PROCESS_RECORD_PRESSED),
+#    endif
+#    if defined(POINTING_DEVICE_ENABLE) && defined(POINTING_DEVICE_AUTO_MOUSE_ENABLE)
+    PROCESS_RECORD_ANY_KEYCODE(process_auto_mouse),
+#    endif
+    PROCESS_RECORD_ANY_KEYCODE(process_record_kb),
+#    if defined(SECURE_ENABLE)
+    PROCESS_RECORD_ANY_KEYCODE(process_secure),
+#    endif
+#    if defined(SEQUENCER_ENABLE)
+    PROCESS_RECORD_HANDLER(process_sequencer, QK_SEQUENCER, QK_SEQUENCER_MAX, PROCESS_RECORD_PRESSED),
+#    endif
+#    if defined(MIDI_ENABLE) && defined(MIDI_ADVANCED)
+    PROCESS_RECORD_HANDLER(process_midi, QK_MIDI, QK_MIDI_MAX, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+#    ifdef AUDIO_ENABLE
+    PROCESS_RECORD_HANDLER(process_audio, QK_AUDIO, QK_AUDIO_MAX, PROCESS_RECORD_PRESSED),
+#    endif
+#    if defined(BACKLIGHT_ENABLE)
+    PROCESS_RECORD_HANDLER(process_backlight, QK_BACKLIGHT_ON, QK_BACKLIGHT_TOGGLE_BREATHING, PROCESS_RECORD_PRESSED),
+#    endif
+#    if defined(LED_MATRIX_ENABLE)
+    // Also handles the backlight keycodes
+    PROCESS_RECORD_HANDLER(process_led_matrix, QK_BACKLIGHT_ON, QK_LED_MATRIX_SPEED_DOWN, PROCESS_RECORD_PRESSED),
+#    endif
+#    ifdef STENO_ENABLE
+    PROCESS_RECORD_HANDLER(process_steno, QK_STENO, QK_STENO_MAX, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+#    if (defined(AUDIO_ENABLE) || (defined(MIDI_ENABLE) && defined(MIDI_BASIC))) && !defined(NO_MUSIC_MODE)
+    PROCESS_RECORD_ANY_KEYCODE(process_music),
+#    endif
+#    ifdef CAPS_WORD_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_caps_word),
+#    endif
+#    ifdef KEY_OVERRIDE_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_key_override_record),
+#    endif
+#    ifdef TAP_DANCE_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_tap_dance),
+#    endif
+#    if defined(UNICODE_COMMON_ENABLE)
+#        ifdef UCIS_ENABLE
+    // UCIS captures every key while an input is in progress
+    PROCESS_RECORD_ANY_KEYCODE(process_unicode_common),
+#        else
+    // The input mode keycodes, followed by the Unicode and Unicode Map ranges
+    PROCESS_RECORD_HANDLER(process_unicode_common, QK_UNICODE_MODE_NEXT, QK_UNICODE_MAX, PROCESS_RECORD_PRESSED),
+#        endif
+#    endif
+#    ifdef LEADER_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_leader),
+#    endif
+#    ifdef AUTO_SHIFT_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_auto_shift),
+#    endif
+#    ifdef DYNAMIC_TAPPING_TERM_ENABLE
+    PROCESS_RECORD_HANDLER(process_dynamic_tapping_term, QK_DYNAMIC_TAPPING_TERM_PRINT, QK_DYNAMIC_TAPPING_TERM_DOWN, PROCESS_RECORD_PRESSED),
+#    endif
+#    ifdef SPACE_CADET_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_space_cadet),
+#    endif
+#    ifdef MAGIC_ENABLE
+    PROCESS_RECORD_HANDLER(process_magic, QK_MAGIC, QK_MAGIC_MAX, PROCESS_RECORD_PRESSED),
+#    endif
+#    ifdef GRAVE_ESC_ENABLE
+    PROCESS_RECORD_HANDLER(process_grave_esc, QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+#    if defined(RGBLIGHT_ENABLE) || defined(RGB_MATRIX_ENABLE)
+#        ifdef RGB_TRIGGER_ON_KEYDOWN
+    PROCESS_RECORD_HANDLER(process_rgb_record, QK_UNDERGLOW_TOGGLE, RGB_MODE_TWINKLE, PROCESS_RECORD_PRESSED),
+#        else
+    PROCESS_RECORD_HANDLER(process_rgb_record, QK_UNDERGLOW_TOGGLE, RGB_MODE_TWINKLE, PROCESS_RECORD_RELEASED),
+#        endif
+#    endif
+#    ifdef JOYSTICK_ENABLE
+    PROCESS_RECORD_HANDLER(process_joystick, QK_JOYSTICK, QK_JOYSTICK_MAX, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+#    ifdef PROGRAMMABLE_BUTTON_ENABLE
+    PROCESS_RECORD_HANDLER(process_programmable_button, QK_PROGRAMMABLE_BUTTON, QK_PROGRAMMABLE_BUTTON_MAX, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+#    ifdef AUTOCORRECT_ENABLE
+    PROCESS_RECORD_ANY_KEYCODE(process_autocorrect),
+#    endif
+#    ifdef TRI_LAYER_ENABLE
+    PROCESS_RECORD_HANDLER(process_tri_layer, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_UPPER, PROCESS_RECORD_ALL_EVENTS),
+#    endif
+};
+
+static bool process_record_dispatch(uint16_t keycode, keyrecord_t *record) {
+    const uint8_t event = record->event.pressed ? PROCESS_RECORD_PRESSED : PROCESS_RECORD_RELEASED;
+
+    for (uint8_t i = 0; i < ARRAY_SIZE(process_record_handlers); i++) {
+        const process_record_handler_t *entry = &process_record_handlers[i];
+        if (keycode < pgm_read_word(&entry->min) || keycode > pgm_read_word(&entry->max) || !(pgm_read_byte(&entry->events) & event)) {
+            continue;
+        }
+
+        bool (*handler)(uint16_t, keyrecord_t *) = pgm_read_ptr(&entry->handler);
+        if (!handler(keycode, record)) {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif
+
 /* Core keycode function, hands off handling to other functions,
     then processes internal quantum keycodes, and then processes
     ACTIONs.                                                      */
@@ -300,11 +466,15 @@ bool process_record_quantum(keyrecord_t *record) {
     }
 #endif
 
-    if (!(
 #if defined(KEY_LOCK_ENABLE)
-            // Must run first to be able to mask key_up events.
-            process_key_lock(&keycode, record) &&
+    // Must run first to be able to mask key_up events.
+    if (!process_key_lock(&keycode, record)) {
+        return false;
+    }
 #endif
+
+#ifdef PROCESS_RECORD_LEGACY_DISPATCH
+    if (!(
 #if defined(DYNAMIC_MACRO_ENABLE) && !defined(DYNAMIC_MACRO_USER_CALL)
             // Must run asap to ensure all keypresses are recorded.
             process_dynamic_macro(keycode, record) &&
@@ -397,6 +567,11 @@ bool process_record_quantum(keyrecord_t *record) {
             true)) {
         return false;
     }
+#else
+    if (!process_record_dispatch(keycode, record)) {
+        return false;
+    }
+#endif
 
     if (record->event.pressed) {
         switch (keycode) {
@@ -0,0 +1,23 @@
+#pragma once
+
+typedef HSV (*angle_f)(HSV hsv, uint8_t angle, uint8_t time);
+
+RGB_MATRIX_RUNNER bool effect_runner_angle(effect_params_t* params, angle_f effect_func) {
+    RGB_MATRIX_USE_LIMITS(led_min, led_max);
+
+    uint8_t time = scale16by8(g_rgb_timer, rgb_matrix_config.speed / 2);
+    RGB_MATRIX_HSV_SCANLINE();
+    for (uint8_t i = led_min; i < led_max; i++) {
+        RGB_MATRIX_TEST_LED_FLAGS();
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+        uint8_t angle = g_led_geometry[i].angle;
+#else
+        int16_t dx    = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy    = g_led_config.point[i].y - k_rgb_matrix_center.y;
+        uint8_t angle = atan2_8(dy, dx);
+#endif
+        RGB_MATRIX_SET_HSV(i, effect_func(rgb_matrix_config.hsv, angle, time));
+    }
+    RGB_MATRIX_FLUSH_HSV();
+    return rgb_matrix_check_finished_leds(led_max);
+}
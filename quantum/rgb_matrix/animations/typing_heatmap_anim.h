@@ -16,6 +16,84 @@ RGB_MATRIX_EFFECT(TYPING_HEATMAP)
 #        ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
 #            define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
 #        endif
+
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH
+#            if defined(__AVR__)
+#                define RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH 0
+#            else
+#                define RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH (RGB_MATRIX_LED_COUNT * 16)
+#            endif
+#        endif
+#        ifndef RGB_MATRIX_TYPING_HEATMAP_SLIM
+// How much a press of the key at row/col heats up the key at i_row/i_col, 0 if it is out of reach
+static uint8_t typing_heatmap_amount(uint8_t row, uint8_t col, uint8_t i_row, uint8_t i_col) {
+    if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
+        return 0;
+    }
+    if (i_row == row && i_col == col) {
+        return RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP;
+    }
+#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+    uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
+#            undef LED_DISTANCE
+    if (distance > RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+        return 0;
+    }
+    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+    }
+    return amount;
+}
+
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH > 0
+typedef struct PACKED {
+    uint8_t row;
+    uint8_t col;
+    uint8_t amount;
+} typing_heatmap_neighbor_t;
+
+// The keys each key heats up, the neighbors of the key at row/col are found between
+// typing_heatmap_neighbors_start[row * MATRIX_COLS + col] and the start of the next key.
+// Only the keys before typing_heatmap_neighbors_keys fit in the table
+static typing_heatmap_neighbor_t typing_heatmap_neighbors[RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH];
+static uint16_t                  typing_heatmap_neighbors_start[MATRIX_ROWS * MATRIX_COLS + 1];
+static uint16_t                  typing_heatmap_neighbors_keys;
+
+static uint16_t typing_heatmap_build_neighbors(void) {
+    uint16_t count = 0;
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t key                        = row * MATRIX_COLS + col;
+            typing_heatmap_neighbors_start[key] = count;
+            if (g_led_config.matrix_co[row][col] == NO_LED) {
+                continue;
+            }
+            for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+                for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+                    uint8_t amount = typing_heatmap_amount(row, col, i_row, i_col);
+                    if (amount == 0) {
+                        continue;
+                    }
+                    if (count >= RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH) {
+                        // This key and the ones after it keep scanning the matrix
+                        return key;
+                    }
+                    typing_heatmap_neighbors[count++] = (typing_heatmap_neighbor_t){
+                        .row    = i_row,
+                        .col    = i_col,
+                        .amount = amount,
+                    };
+                }
+            }
+        }
+    }
+    typing_heatmap_neighbors_start[MATRIX_ROWS * MATRIX_COLS] = count;
+    return MATRIX_ROWS * MATRIX_COLS;
+}
+#            endif // RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH > 0
+#        endif     // RGB_MATRIX_TYPING_HEATMAP_SLIM
+
 void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
 #        ifdef RGB_MATRIX_TYPING_HEATMAP_SLIM
     // Limit effect to pressed keys
@@ -24,24 +102,21 @@ void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col) {
     if (g_led_config.matrix_co[row][col] == NO_LED) { // skip as pressed key doesn't have an led position
         return;
     }
+#            if RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH > 0
+    uint16_t key = row * MATRIX_COLS + col;
+    if (key < typing_heatmap_neighbors_keys) {
+        for (uint16_t i = typing_heatmap_neighbors_start[key]; i < typing_heatmap_neighbors_start[key + 1]; i++) {
+            typing_heatmap_neighbor_t neighbor             = typing_heatmap_neighbors[i];
+            g_rgb_frame_buffer[neighbor.row][neighbor.col] = qadd8(g_rgb_frame_buffer[neighbor.row][neighbor.col], neighbor.amount);
+        }
+        return;
+    }
+#            endif // RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH > 0
     for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
         for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
-            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) { // skip as target key doesn't have an led position
-                continue;
-            }
-            if (i_row == row && i_col == col) {
-                g_rgb_frame_buffer[row][col] = qadd8(g_rgb_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
-            } else {
-#            define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
-                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
-#            undef LED_DISTANCE
-                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
-                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
-                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
-                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
-                    }
-                    g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
-                }
+            uint8_t amount = typing_heatmap_amount(row, col, i_row, i_col);
+            if (amount > 0) {
+                g_rgb_frame_buffer[i_row][i_col] = qadd8(g_rgb_frame_buffer[i_row][i_col], amount);
             }
         }
     }
@@ -59,6 +134,12 @@ bool TYPING_HEATMAP(effect_params_t* params) {
     if (params->init) {
         rgb_matrix_set_color_all(0, 0, 0);
         memset(g_rgb_frame_buffer, 0, sizeof g_rgb_frame_buffer);
+#        if !defined(RGB_MATRIX_TYPING_HEATMAP_SLIM) && RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH > 0
+        // Built once per effect start, picking up any changes to g_led_config. Until then, keypresses scan the matrix
+        if (params->iter == 0) {
+            typing_heatmap_neighbors_keys = typing_heatmap_build_neighbors();
+        }
+#        endif
     }
 
     // The heatmap animation might run in several iterations depending on
@@ -39,6 +39,23 @@ __attribute__((weak)) RGB rgb_matrix_hsv_to_rgb(HSV hsv) {
     return hsv_to_rgb(hsv);
 }
 
+#ifdef RGB_MATRIX_HSV_BATCH
+// Keyboards that override rgb_matrix_hsv_to_rgb() need to override this as well
+__attribute__((weak)) void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count) {
+    hsv_to_rgb_batch(hsv, rgb, count);
+}
+
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch) {
+    RGB rgb[RGB_MATRIX_HSV_BATCH_SIZE];
+
+    rgb_matrix_hsv_to_rgb_batch(batch->hsv, rgb, batch->count);
+    for (uint8_t i = 0; i < batch->count; i++) {
+        rgb_matrix_set_color(batch->index[i], rgb[i].r, rgb[i].g, rgb[i].b);
+    }
+    batch->count = 0;
+}
+#endif // RGB_MATRIX_HSV_BATCH
+
 // Generic effect runners
 #include "rgb_matrix_runners.inc"
 
@@ -69,6 +86,9 @@ uint8_t g_rgb_frame_buffer[MATRIX_ROWS][MATRIX_COLS] = {{0}};
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 last_hit_t g_last_hit_tracker;
 #endif // RGB_MATRIX_KEYREACTIVE_ENABLED
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif // RGB_MATRIX_GEOMETRY_CACHE
 
 // internals
 static bool            suspend_state     = false;
@@ -445,9 +465,29 @@ __attribute__((weak)) bool rgb_matrix_indicators_advanced_user(uint8_t led_min,
     return true;
 }
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        g_led_geometry[i] = (led_geometry_t){
+            .dx    = dx,
+            .dy    = dy,
+            .dist  = sqrt16(dx * dx + dy * dy),
+            .angle = atan2_8(dy, dx),
+        };
+    }
+}
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 void rgb_matrix_init(void) {
     rgb_matrix_driver.init();
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+    rgb_matrix_update_geometry();
+#endif // RGB_MATRIX_GEOMETRY_CACHE
+
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
     g_last_hit_tracker.count = 0;
     for (uint8_t i = 0; i < LED_HITS_TO_REMEMBER; ++i) {
@@ -114,6 +114,47 @@ struct rgb_matrix_limits_t rgb_matrix_get_limits(uint8_t iter);
 #define RGB_MATRIX_TEST_LED_FLAGS() \
     if (!HAS_ANY_FLAGS(g_led_config.flags[i], params->flags)) continue
 
+RGB rgb_matrix_hsv_to_rgb(HSV hsv);
+
+#ifdef RGB_MATRIX_HSV_BATCH
+#    ifndef RGB_MATRIX_HSV_BATCH_SIZE
+#        define RGB_MATRIX_HSV_BATCH_SIZE 16
+#    endif
+
+typedef struct {
+    uint8_t count;
+    uint8_t index[RGB_MATRIX_HSV_BATCH_SIZE];
+    HSV     hsv[RGB_MATRIX_HSV_BATCH_SIZE];
+} rgb_matrix_hsv_batch_t;
+
+void rgb_matrix_hsv_to_rgb_batch(const HSV *hsv, RGB *rgb, uint8_t count);
+void rgb_matrix_hsv_batch_flush(rgb_matrix_hsv_batch_t *batch);
+
+// Effects queue up the colors of a scanline, which are converted to RGB together
+#    define RGB_MATRIX_HSV_SCANLINE() rgb_matrix_hsv_batch_t hsv_batch = {.count = 0}
+#    define RGB_MATRIX_SET_HSV(i, color)                          \
+        do {                                                      \
+            hsv_batch.index[hsv_batch.count] = i;                 \
+            hsv_batch.hsv[hsv_batch.count]   = color;             \
+            if (++hsv_batch.count == RGB_MATRIX_HSV_BATCH_SIZE) { \
+                rgb_matrix_hsv_batch_flush(&hsv_batch);           \
+            }                                                     \
+        } while (0)
+#    define RGB_MATRIX_FLUSH_HSV() rgb_matrix_hsv_batch_flush(&hsv_batch)
+#else
+#    define RGB_MATRIX_HSV_SCANLINE() \
+        do {                          \
+        } while (0)
+#    define RGB_MATRIX_SET_HSV(i, color)                              \
+        do {                                                          \
+            RGB hsv_rgb = rgb_matrix_hsv_to_rgb(color);               \
+            rgb_matrix_set_color(i, hsv_rgb.r, hsv_rgb.g, hsv_rgb.b); \
+        } while (0)
+#    define RGB_MATRIX_FLUSH_HSV() \
+        do {                       \
+        } while (0)
+#endif
+
 enum rgb_matrix_effects {
     RGB_MATRIX_NONE = 0,
 
@@ -163,6 +204,9 @@ bool rgb_matrix_indicators_advanced_kb(uint8_t led_min, uint8_t led_max);
 bool rgb_matrix_indicators_advanced_user(uint8_t led_min, uint8_t led_max);
 
 void rgb_matrix_init(void);
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+void rgb_matrix_update_geometry(void);
+#endif
 
 void rgb_matrix_reload_from_eeprom(void);
 
@@ -271,6 +315,9 @@ extern rgb_config_t rgb_matrix_config;
 
 extern uint32_t     g_rgb_timer;
 extern led_config_t g_led_config;
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+extern led_geometry_t g_led_geometry[RGB_MATRIX_LED_COUNT];
+#endif
 #ifdef RGB_MATRIX_KEYREACTIVE_ENABLED
 extern last_hit_t g_last_hit_tracker;
 #endif
@@ -55,6 +55,16 @@ typedef struct PACKED {
     uint8_t y;
 } led_point_t;
 
+#ifdef RGB_MATRIX_GEOMETRY_CACHE
+// Position of an LED relative to the matrix center, derived once from g_led_config
+typedef struct PACKED {
+    int16_t dx;
+    int16_t dy;
+    uint8_t dist;
+    uint8_t angle;
+} led_geometry_t;
+#endif
+
 #define HAS_FLAGS(bits, flags) ((bits & flags) == flags)
 #define HAS_ANY_FLAGS(bits, flags) ((bits & flags) != 0x00)
 
@@ -143,14 +143,15 @@ __attribute__((weak)) const uint8_t ascii_to_keycode_lut[128] PROGMEM = {
 
 // clang-format on
 
-// Note: we bit-pack in "reverse" order to optimize loading
-#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
-
 void send_string(const char *string) {
     send_string_with_delay(string, TAP_CODE_DELAY);
 }
 
 void send_string_with_delay(const char *string, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_enqueue(string, interval, false);
+    return;
+#endif
     while (1) {
         char ascii_code = *string;
         if (!ascii_code) break;
@@ -197,6 +198,11 @@ void send_char(char ascii_code) {
 }
 
 void send_char_with_delay(char ascii_code, uint8_t interval) {
+#ifdef SEND_STRING_ASYNC_ENABLE
+    const char string[] = {ascii_code, 0};
+    send_string_async_enqueue(string, interval, false);
+    return;
+#endif
 #if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
     if (ascii_code == '\a') { // BEL
         PLAY_SONG(bell_song);
@@ -298,6 +304,10 @@ void send_string_P(const char *string) {
 }
 
 void send_string_with_delay_P(const char *string, uint8_t interval) {
+#    ifdef SEND_STRING_ASYNC_ENABLE
+    send_string_async_enqueue(string, interval, true);
+    return;
+#    endif
     while (1) {
         char ascii_code = pgm_read_byte(string);
         if (!ascii_code) break;
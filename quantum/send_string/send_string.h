@@ -23,6 +23,7 @@
  * \{
  */
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include "progmem.h"
@@ -46,6 +47,9 @@ extern const uint8_t ascii_to_keycode_lut[128];
     | ((h) ? 1 : 0) << 7 )
 // clang-format on
 
+// Note: we bit-pack in "reverse" order to optimize loading
+#define PGM_LOADBIT(mem, pos) ((pgm_read_byte(&((mem)[(pos) / 8])) >> ((pos) % 8)) & 0x01)
+
 /**
  * \brief Type out a string of ASCII characters.
  *
@@ -161,4 +165,38 @@ void send_string_with_delay_P(const char *string, uint8_t interval);
  */
 #define SEND_STRING_DELAY(string, interval) send_string_with_delay_P(PSTR(string), interval)
 
+#if defined(SEND_STRING_ASYNC_ENABLE) || defined(__DOXYGEN__)
+/**
+ * \brief Queue a string to be typed out from the main loop, rather than waiting for it to be typed.
+ *
+ * With `SEND_STRING_ASYNC_ENABLE = yes`, `send_string()`, `send_char()` and friends queue their strings through this.
+ * If the queue is full, this types out what's queued until there is room.
+ *
+ * \param string The string to type out.
+ * \param interval The minimum time, in milliseconds, between the reports sent for the string.
+ * \param progmem Whether the string is in PROGMEM.
+ */
+void send_string_async_enqueue(const char *string, uint8_t interval, bool progmem);
+
+/**
+ * \brief Whether any queued string is yet to be typed out.
+ */
+bool send_string_async_busy(void);
+
+/**
+ * \brief Type out everything queued before returning, for code that needs to send keys after a string.
+ */
+void send_string_async_wait(void);
+
+/**
+ * \brief Drop everything queued, and release any keys held for it.
+ */
+void send_string_async_cancel(void);
+
+/**
+ * \brief Types out the next step of the queued strings. Called by `keyboard_task()`, should not be invoked by keyboard/user code.
+ */
+void send_string_async_task(void);
+#endif
+
 /** \} */
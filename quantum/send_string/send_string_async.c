@@ -0,0 +1,389 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "send_string.h"
+
+#include <ctype.h>
+
+#include "keycode.h"
+#include "action.h"
+#include "action_util.h"
+#include "timer.h"
+#include "wait.h"
+
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+#    include "audio.h"
+extern float bell_song[][2];
+#endif
+
+#ifndef SEND_STRING_ASYNC_BUFFER_SIZE
+#    define SEND_STRING_ASYNC_BUFFER_SIZE 128
+#endif
+
+#ifndef SEND_STRING_ASYNC_INTERVAL
+#    define SEND_STRING_ASYNC_INTERVAL 1
+#endif
+
+// Free running 8-bit indices are used, so their difference always gives the fill level
+_Static_assert(SEND_STRING_ASYNC_BUFFER_SIZE >= 8 && SEND_STRING_ASYNC_BUFFER_SIZE <= 128 && (SEND_STRING_ASYNC_BUFFER_SIZE & (SEND_STRING_ASYNC_BUFFER_SIZE - 1)) == 0, "SEND_STRING_ASYNC_BUFFER_SIZE must be a power of two, from 8 to 128");
+
+#define SEND_STRING_ASYNC_BUFFER_MASK (SEND_STRING_ASYNC_BUFFER_SIZE - 1)
+
+// Queued strings are normalised on the way in: characters as-is, SS_TAP/SS_DOWN/SS_UP as their three bytes, delays
+// as the prefix, SS_DELAY_CODE and the 16-bit delay. A prefix followed by a zero, which can't occur in a string,
+// marks a change of interval for the strings queued after it.
+#define SS_INTERVAL_CODE 0
+
+// The largest normalised token
+#define SS_ASYNC_MAX_TOKEN 4
+
+static uint8_t queue[SEND_STRING_ASYNC_BUFFER_SIZE];
+static uint8_t queue_head = 0;
+static uint8_t queue_tail = 0;
+
+// The interval of the last string queued, and the one in effect for the strings being typed
+static uint8_t queued_interval  = 0;
+static uint8_t current_interval = 0;
+
+static uint32_t last_step = 0;
+static uint32_t step_wait = 0;
+
+#define CHAR_MODS_SHIFT MOD_BIT(KC_LEFT_SHIFT)
+#define CHAR_MODS_ALTGR MOD_BIT(KC_RIGHT_ALT)
+
+// A character expands to a handful of steps, each of which changes the report
+typedef enum {
+    STEP_SET_MODS, // Changes the modifiers held for characters
+    STEP_PRESS,
+    STEP_RELEASE,
+    STEP_REGISTER, // SS_DOWN, through register_code()
+    STEP_UNREGISTER,
+    STEP_DELAY,
+    STEP_BELL,
+} step_type_t;
+
+typedef struct {
+    uint8_t  type;
+    uint8_t  keycode;
+    uint16_t arg;
+} step_t;
+
+#define MAX_STEPS 8
+
+static step_t  steps[MAX_STEPS];
+static uint8_t steps_head  = 0;
+static uint8_t steps_count = 0;
+
+// What's being held for the characters typed
+static uint8_t char_mods = 0;
+static uint8_t char_key  = KC_NO;
+
+static inline uint8_t queue_used(void) {
+    return (uint8_t)(queue_head - queue_tail);
+}
+
+static inline uint8_t queue_peek(uint8_t offset) {
+    return queue[(uint8_t)(queue_tail + offset) & SEND_STRING_ASYNC_BUFFER_MASK];
+}
+
+static inline void queue_push(uint8_t byte) {
+    queue[queue_head & SEND_STRING_ASYNC_BUFFER_MASK] = byte;
+    queue_head++;
+}
+
+static void steps_push(uint8_t type, uint8_t keycode, uint16_t arg) {
+    steps[(steps_head + steps_count) % MAX_STEPS] = (step_t){.type = type, .keycode = keycode, .arg = arg};
+    steps_count++;
+}
+
+static const step_t *steps_peek(void) {
+    return steps_count ? &steps[steps_head] : NULL;
+}
+
+static void steps_pop(void) {
+    steps_head = (steps_head + 1) % MAX_STEPS;
+    steps_count--;
+}
+
+static void set_char_mods(uint8_t mods) {
+    del_mods(char_mods & ~mods);
+    add_mods(mods & ~char_mods);
+    char_mods = mods;
+}
+
+#ifndef SEND_STRING_ASYNC_NO_PACKING
+// Releasing a key may share a report with the press of another key, or a change of modifiers, without the host
+// seeing anything typed differently. Modifier changes have to land before the next key press though.
+static bool step_can_share_report(const step_t *released, const step_t *next) {
+    return next && (next->type == STEP_SET_MODS || (next->type == STEP_PRESS && next->keycode != released->keycode));
+}
+#endif
+
+// Expands a character into steps, in the order send_char_with_delay() would have sent them
+static void expand_char(uint8_t ascii_code) {
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+    if (ascii_code == '\a') {
+        steps_push(STEP_BELL, 0, 0);
+        return;
+    }
+#endif
+    if (ascii_code >= 128) {
+        return;
+    }
+
+    uint8_t keycode = pgm_read_byte(&ascii_to_keycode_lut[ascii_code]);
+    if (keycode == KC_NO) {
+        return;
+    }
+
+    uint8_t mods = 0;
+    if (PGM_LOADBIT(ascii_to_shift_lut, ascii_code)) {
+        mods |= CHAR_MODS_SHIFT;
+    }
+    if (PGM_LOADBIT(ascii_to_altgr_lut, ascii_code)) {
+        mods |= CHAR_MODS_ALTGR;
+    }
+    bool is_dead = PGM_LOADBIT(ascii_to_dead_lut, ascii_code);
+
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+    if (mods & CHAR_MODS_SHIFT) {
+        steps_push(STEP_SET_MODS, 0, CHAR_MODS_SHIFT);
+    }
+    if (mods & CHAR_MODS_ALTGR) {
+        steps_push(STEP_SET_MODS, 0, mods);
+    }
+    steps_push(STEP_PRESS, keycode, 0);
+    steps_push(STEP_RELEASE, keycode, 0);
+    if (mods & CHAR_MODS_ALTGR) {
+        steps_push(STEP_SET_MODS, 0, mods & ~CHAR_MODS_ALTGR);
+    }
+    if (mods & CHAR_MODS_SHIFT) {
+        steps_push(STEP_SET_MODS, 0, 0);
+    }
+#else
+    // Modifiers are left held for as long as the following characters need them
+    if (mods != char_mods) {
+        steps_push(STEP_SET_MODS, 0, mods);
+    }
+    steps_push(STEP_PRESS, keycode, 0);
+    steps_push(STEP_RELEASE, keycode, 0);
+    if (is_dead && mods) {
+        steps_push(STEP_SET_MODS, 0, 0);
+    }
+#endif
+
+    if (is_dead) {
+        steps_push(STEP_PRESS, KC_SPACE, 0);
+        steps_push(STEP_RELEASE, KC_SPACE, 0);
+    }
+}
+
+// Turns the next queued token into steps, returning false when there is nothing left to do
+static bool expand_next(void) {
+    while (queue_used() > 0) {
+        uint8_t byte = queue_peek(0);
+        if (byte != SS_QMK_PREFIX) {
+            queue_tail++;
+            expand_char(byte);
+        } else {
+            uint8_t code = queue_peek(1);
+            if (code == SS_INTERVAL_CODE) {
+                current_interval = queue_peek(2);
+                queue_tail += 3;
+                continue;
+            }
+
+            // Characters' modifiers must not leak into keycodes sent explicitly
+            if (char_mods) {
+                steps_push(STEP_SET_MODS, 0, 0);
+                return true;
+            }
+
+            uint8_t keycode = queue_peek(2);
+            switch (code) {
+                case SS_TAP_CODE:
+                    steps_push(STEP_REGISTER, keycode, 0);
+                    steps_push(STEP_UNREGISTER, keycode, 0);
+                    queue_tail += 3;
+                    break;
+                case SS_DOWN_CODE:
+                    steps_push(STEP_REGISTER, keycode, 0);
+                    queue_tail += 3;
+                    break;
+                case SS_UP_CODE:
+                    steps_push(STEP_UNREGISTER, keycode, 0);
+                    queue_tail += 3;
+                    break;
+                case SS_DELAY_CODE:
+                    steps_push(STEP_DELAY, 0, keycode | (queue_peek(3) << 8));
+                    queue_tail += 4;
+                    break;
+            }
+        }
+
+        if (steps_count > 0) {
+            return true;
+        }
+    }
+
+    // Nothing left, let go of any modifiers
+    if (char_mods) {
+        steps_push(STEP_SET_MODS, 0, 0);
+        return true;
+    }
+    return false;
+}
+
+bool send_string_async_busy(void) {
+    return queue_used() > 0 || steps_count > 0 || char_mods != 0;
+}
+
+static void wait_for(uint32_t ms) {
+    last_step = timer_read32();
+    step_wait = ms;
+}
+
+void send_string_async_task(void) {
+    if (!send_string_async_busy() || timer_elapsed32(last_step) < step_wait) {
+        return;
+    }
+
+    while (steps_count > 0 || expand_next()) {
+        step_t step = *steps_peek();
+        steps_pop();
+
+        switch (step.type) {
+            case STEP_BELL:
+#if defined(AUDIO_ENABLE) && defined(SENDSTRING_BELL)
+                PLAY_SONG(bell_song);
+#endif
+                continue;
+            case STEP_DELAY:
+                wait_for(step.arg);
+                return;
+            case STEP_REGISTER:
+                register_code(step.keycode);
+                break;
+            case STEP_UNREGISTER:
+                unregister_code(step.keycode);
+                break;
+            case STEP_SET_MODS:
+                set_char_mods(step.arg);
+                send_keyboard_report();
+                break;
+            case STEP_PRESS:
+                add_key(step.keycode);
+                char_key = step.keycode;
+                send_keyboard_report();
+                break;
+            case STEP_RELEASE:
+                del_key(step.keycode);
+                char_key = KC_NO;
+#ifndef SEND_STRING_ASYNC_NO_PACKING
+                if (steps_count > 0 || expand_next()) {
+                    const step_t *next = steps_peek();
+                    if (step_can_share_report(&step, next)) {
+                        if (next->type == STEP_SET_MODS) {
+                            set_char_mods(next->arg);
+                        } else {
+                            add_key(next->keycode);
+                            char_key = next->keycode;
+                        }
+                        steps_pop();
+                    }
+                }
+#endif
+                send_keyboard_report();
+                break;
+        }
+
+        wait_for(current_interval > SEND_STRING_ASYNC_INTERVAL ? current_interval : SEND_STRING_ASYNC_INTERVAL);
+        return;
+    }
+}
+
+void send_string_async_wait(void) {
+    while (send_string_async_busy()) {
+        send_string_async_task();
+        wait_ms(1);
+    }
+}
+
+void send_string_async_cancel(void) {
+    queue_tail  = queue_head;
+    steps_count = 0;
+    if (char_key != KC_NO) {
+        del_key(char_key);
+        char_key = KC_NO;
+    }
+    set_char_mods(0);
+    send_keyboard_report();
+}
+
+// Makes room for a token, typing out what's already queued if need be
+static void queue_reserve(uint8_t length) {
+    while (SEND_STRING_ASYNC_BUFFER_SIZE - queue_used() < length) {
+        send_string_async_task();
+        wait_ms(1);
+    }
+}
+
+static inline uint8_t read_byte(const char *string, bool progmem) {
+    return progmem ? pgm_read_byte(string) : (uint8_t)*string;
+}
+
+void send_string_async_enqueue(const char *string, uint8_t interval, bool progmem) {
+    if (interval != queued_interval) {
+        queue_reserve(3);
+        queue_push(SS_QMK_PREFIX);
+        queue_push(SS_INTERVAL_CODE);
+        queue_push(interval);
+        queued_interval = interval;
+    }
+
+    while (true) {
+        uint8_t ascii_code = read_byte(string, progmem);
+        if (!ascii_code) break;
+
+        if (ascii_code != SS_QMK_PREFIX) {
+            queue_reserve(1);
+            queue_push(ascii_code);
+            ++string;
+            continue;
+        }
+
+        uint8_t code    = read_byte(++string, progmem);
+        uint8_t keycode = code ? read_byte(string + 1, progmem) : 0;
+        if (code == SS_TAP_CODE || code == SS_DOWN_CODE || code == SS_UP_CODE) {
+            // An unexpected end of string is dropped
+            if (!keycode) break;
+            queue_reserve(3);
+            queue_push(SS_QMK_PREFIX);
+            queue_push(code);
+            queue_push(keycode);
+            string += 2;
+        } else if (code == SS_DELAY_CODE) {
+            uint32_t ms = 0;
+            while (isdigit(keycode)) {
+                ms *= 10;
+                ms += keycode - '0';
+                keycode = read_byte(++string + 1, progmem);
+            }
+            if (ms > UINT16_MAX) {
+                ms = UINT16_MAX;
+            }
+            queue_reserve(SS_ASYNC_MAX_TOKEN);
+            queue_push(SS_QMK_PREFIX);
+            queue_push(SS_DELAY_CODE);
+            queue_push(ms & 0xFF);
+            queue_push(ms >> 8);
+            // Skip the terminating '|', unless the string ended first
+            string += keycode ? 2 : 1;
+        } else if (code) {
+            // Unknown codes are ignored
+            ++string;
+        } else {
+            break;
+        }
+    }
+}
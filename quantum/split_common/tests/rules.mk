@@ -0,0 +1,29 @@
+split_transactions_common_DEFS := \
+	-DSPLIT_KEYBOARD \
+	-DSPLIT_TRANSPORT_MIRROR \
+	-DSPLIT_LED_STATE_ENABLE \
+	-DSPLIT_MODS_ENABLE \
+	-DWPM_ENABLE \
+	-DSPLIT_WPM_ENABLE \
+	-DSPLIT_TRANSACTION_IDS_USER=USER_SYNC_A \
+	-DMATRIX_ROWS=10 \
+	-DMATRIX_COLS=8
+split_transactions_common_SRC := \
+	$(PLATFORM_PATH)/$(PLATFORM_KEY)/timer.c \
+	$(QUANTUM_PATH)/crc.c \
+	$(QUANTUM_PATH)/sync_timer.c \
+	$(QUANTUM_PATH)/split_common/transactions.c \
+	$(QUANTUM_PATH)/split_common/tests/transport_loopback.c \
+	$(QUANTUM_PATH)/split_common/tests/split_transactions_tests.cpp
+split_transactions_common_INC := \
+	$(QUANTUM_PATH)/split_common
+
+split_transactions_DEFS := $(split_transactions_common_DEFS)
+split_transactions_SRC := $(split_transactions_common_SRC)
+split_transactions_INC := $(split_transactions_common_INC)
+
+split_transactions_batched_DEFS := \
+	$(split_transactions_common_DEFS) \
+	-DSPLIT_TRANSPORT_BATCHED
+split_transactions_batched_SRC := $(split_transactions_common_SRC)
+split_transactions_batched_INC := $(split_transactions_common_INC)
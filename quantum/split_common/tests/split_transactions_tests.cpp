@@ -0,0 +1,233 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "gtest/gtest.h"
+
+#include <cstring>
+
+extern "C" {
+// The transaction ID header asserts with the C11 spelling
+#define _Static_assert static_assert
+#include "transactions.h"
+#include "transport.h"
+#include "transport_loopback.h"
+#undef _Static_assert
+
+void advance_time(uint32_t ms);
+}
+
+#define HALF_ROWS ((MATRIX_ROWS) / 2)
+
+// State the master publishes, along with what the slave received of it
+static uint8_t host_leds  = 0;
+static uint8_t slave_leds = 0;
+static uint8_t host_mods  = 0;
+static uint8_t slave_mods = 0;
+static uint8_t host_wpm   = 0;
+static uint8_t slave_wpm  = 0;
+
+extern "C" {
+uint8_t host_keyboard_leds(void) {
+    return host_leds;
+}
+void set_split_host_keyboard_leds(uint8_t led_state) {
+    slave_leds = led_state;
+}
+uint8_t get_mods(void) {
+    return host_mods;
+}
+void set_mods(uint8_t mods) {
+    slave_mods = mods;
+}
+uint8_t get_weak_mods(void) {
+    return 0;
+}
+void set_weak_mods(uint8_t mods) {}
+uint8_t get_oneshot_mods(void) {
+    return 0;
+}
+void set_oneshot_mods(uint8_t mods) {}
+uint8_t get_oneshot_locked_mods(void) {
+    return 0;
+}
+void set_oneshot_locked_mods(uint8_t mods) {}
+uint8_t get_current_wpm(void) {
+    return host_wpm;
+}
+void set_current_wpm(uint8_t wpm) {
+    slave_wpm = wpm;
+}
+}
+
+static void echo_increment_slave_handler(uint8_t in_buflen, const void *in_data, uint8_t out_buflen, void *out_data) {
+    const uint8_t *in  = (const uint8_t *)in_data;
+    uint8_t       *out = (uint8_t *)out_data;
+    for (uint8_t i = 0; i < in_buflen && i < out_buflen; ++i) {
+        out[i] = in[i] + 1;
+    }
+}
+
+class SplitTransactions : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        loopback_reset();
+        host_leds  = 0;
+        slave_leds = 0;
+        host_mods  = 0;
+        slave_mods = 0;
+        host_wpm   = 0;
+        slave_wpm  = 0;
+        memset(master_local_matrix, 0, sizeof(master_local_matrix));
+        memset(master_slave_matrix, 0, sizeof(master_slave_matrix));
+        memset(slave_local_matrix, 0, sizeof(slave_local_matrix));
+        memset(slave_master_matrix, 0, sizeof(slave_master_matrix));
+        // Let any state from previous tests time out
+        advance_time(1000);
+        settle();
+    }
+
+    // One scan cycle of both halves, the slave publishes its matrix before the master polls it
+    bool scan() {
+        loopback_slave(slave_master_matrix, slave_local_matrix);
+        bool okay = transactions_master(master_local_matrix, master_slave_matrix);
+        advance_time(1);
+        return okay;
+    }
+
+    void settle() {
+        for (int i = 0; i < 4; ++i) {
+            scan();
+        }
+    }
+
+    void expect_synced() {
+        for (uint8_t row = 0; row < HALF_ROWS; ++row) {
+            EXPECT_EQ(master_slave_matrix[row], slave_local_matrix[row]) << "slave row " << (int)row;
+            EXPECT_EQ(slave_master_matrix[row], master_local_matrix[row]) << "master row " << (int)row;
+        }
+        EXPECT_EQ(slave_leds, host_leds);
+        EXPECT_EQ(slave_mods, host_mods);
+        EXPECT_EQ(slave_wpm, host_wpm);
+    }
+
+    matrix_row_t master_local_matrix[HALF_ROWS];
+    matrix_row_t master_slave_matrix[HALF_ROWS];
+    matrix_row_t slave_local_matrix[HALF_ROWS];
+    matrix_row_t slave_master_matrix[HALF_ROWS];
+};
+
+TEST_F(SplitTransactions, SlaveMatrixReachesMasterInSameScan) {
+    slave_local_matrix[1] = 0x05;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(master_slave_matrix[1], 0x05);
+
+    slave_local_matrix[1] = 0x04;
+    slave_local_matrix[4] = 0x80;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(master_slave_matrix[1], 0x04);
+    EXPECT_EQ(master_slave_matrix[4], 0x80);
+}
+
+TEST_F(SplitTransactions, MasterStateReachesSlaveInSameScan) {
+    master_local_matrix[3] = 0x42;
+    host_mods              = 0x02;
+    EXPECT_TRUE(scan());
+    // The slave picks it up with its next pass over the handlers
+    loopback_slave(slave_master_matrix, slave_local_matrix);
+    EXPECT_EQ(slave_master_matrix[3], 0x42);
+    EXPECT_EQ(slave_mods, 0x02);
+}
+
+TEST_F(SplitTransactions, MasterStateReachesSlave) {
+    master_local_matrix[2] = 0x81;
+    host_leds              = 0x02;
+    host_mods              = 0x22;
+    host_wpm               = 42;
+    settle();
+    expect_synced();
+
+    master_local_matrix[2] = 0x00;
+    host_leds              = 0x00;
+    host_mods              = 0x00;
+    host_wpm               = 0;
+    settle();
+    expect_synced();
+}
+
+TEST_F(SplitTransactions, RecoversFromDroppedTransactions) {
+    for (int i = 0; i < 200; ++i) {
+        slave_local_matrix[i % HALF_ROWS] ^= 1 << (i % 7);
+        master_local_matrix[(i * 3) % HALF_ROWS] ^= 1 << (i % 5);
+        host_leds = i & 0x07;
+        host_mods = i & 0x03;
+        host_wpm  = i;
+        if (i % 9 == 0) {
+            // Runs out the retries of whichever transaction comes next
+            loopback_drop_transactions(10 + i % 3);
+        }
+        scan();
+    }
+    settle();
+    expect_synced();
+}
+
+TEST_F(SplitTransactions, RpcRunsAlongside) {
+    transaction_register_rpc(USER_SYNC_A, echo_increment_slave_handler);
+
+    uint8_t request[4] = {1, 2, 3, 4};
+    uint8_t response[4];
+    slave_local_matrix[0] = 0x11;
+    EXPECT_TRUE(scan());
+    EXPECT_TRUE(transaction_rpc_exec(USER_SYNC_A, sizeof(request), request, sizeof(response), response));
+    EXPECT_EQ(response[0], 2);
+    EXPECT_EQ(response[3], 5);
+
+    slave_local_matrix[0] = 0x22;
+    EXPECT_TRUE(scan());
+    EXPECT_EQ(master_slave_matrix[0], 0x22);
+}
+
+TEST_F(SplitTransactions, LinkUsagePerScan) {
+    const int scans = 1000;
+
+    uint32_t before = loopback_stats.transactions;
+    for (int i = 0; i < scans; ++i) {
+        scan();
+    }
+    uint32_t idle_transactions = loopback_stats.transactions - before;
+
+    // Typing: every few scans a key changes on one of the halves, followed by mods, WPM and host LEDs now and then
+    uint32_t max_transactions = 0;
+    for (int i = 0; i < scans; ++i) {
+        if (i % 4 == 0) {
+            slave_local_matrix[(i / 4) % HALF_ROWS] ^= 1 << (i % 8);
+        }
+        if (i % 6 == 0) {
+            master_local_matrix[(i / 6) % HALF_ROWS] ^= 1 << (i % 8);
+        }
+        if (i % 12 == 0) {
+            host_mods ^= 0x02;
+        }
+        if (i % 25 == 0) {
+            host_wpm = i / 25;
+        }
+        if (i % 50 == 0) {
+            host_leds ^= 0x02;
+        }
+        uint32_t scan_start = loopback_stats.transactions;
+        EXPECT_TRUE(scan());
+        max_transactions = std::max(max_transactions, loopback_stats.transactions - scan_start);
+    }
+
+    settle();
+    expect_synced();
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+    // A single exchange per scan and the odd sync timer update
+    EXPECT_LE(max_transactions, 2u);
+    EXPECT_LT(idle_transactions, (uint32_t)scans * 11 / 10);
+#else
+    (void)idle_transactions;
+    (void)max_transactions;
+#endif
+}
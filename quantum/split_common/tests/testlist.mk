@@ -0,0 +1 @@
+TEST_LIST += split_transactions split_transactions_batched
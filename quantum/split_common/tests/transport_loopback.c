@@ -0,0 +1,96 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+// In-memory transport connecting both halves within one process. The master
+// works on split_shmem, the slave's copy is swapped in whenever slave code runs.
+// The statistics follow the serial protocol: a handshake byte in each
+// direction plus the full transaction buffers.
+
+#include <string.h>
+
+#include "transport_loopback.h"
+#include "transactions.h"
+#include "transport.h"
+#include "synchronization_util.h"
+
+static split_shared_memory_t shared_memory;
+static split_shared_memory_t target_memory;
+split_shared_memory_t *const split_shmem = &shared_memory;
+
+loopback_stats_t loopback_stats;
+
+static bool    in_target         = false;
+static uint8_t dropped_remaining = 0;
+
+extern inline void split_shared_memory_lock(void);
+extern inline void split_shared_memory_unlock(void);
+
+static void loopback_swap(void) {
+    split_shared_memory_t temp;
+    memcpy(&temp, &shared_memory, sizeof(split_shared_memory_t));
+    memcpy(&shared_memory, &target_memory, sizeof(split_shared_memory_t));
+    memcpy(&target_memory, &temp, sizeof(split_shared_memory_t));
+    in_target = !in_target;
+}
+
+void loopback_reset(void) {
+    memset(&shared_memory, 0, sizeof(split_shared_memory_t));
+    memset(&target_memory, 0, sizeof(split_shared_memory_t));
+    memset(&loopback_stats, 0, sizeof(loopback_stats));
+    in_target         = false;
+    dropped_remaining = 0;
+}
+
+void loopback_drop_transactions(uint8_t count) {
+    dropped_remaining = count;
+}
+
+void loopback_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    loopback_swap();
+    transactions_slave(master_matrix, slave_matrix);
+    loopback_swap();
+}
+
+bool is_keyboard_master(void) {
+    return !in_target;
+}
+
+bool is_transport_connected(void) {
+    return true;
+}
+
+void transport_master_init(void) {}
+void transport_slave_init(void) {}
+
+bool transport_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (initiator2target_length > 0) {
+        size_t len = trans->initiator2target_buffer_size < initiator2target_length ? trans->initiator2target_buffer_size : initiator2target_length;
+        memcpy(split_trans_initiator2target_buffer(trans), initiator2target_buf, len);
+    }
+
+    loopback_stats.transactions++;
+    loopback_stats.bytes += 2 + trans->initiator2target_buffer_size;
+    if (dropped_remaining > 0) {
+        dropped_remaining--;
+        return false;
+    }
+
+    // Hand the initiator buffer over, let the slave react and fetch its response
+    uint8_t *target_base = (uint8_t *)&target_memory;
+    memcpy(&target_base[trans->initiator2target_offset], split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size);
+    loopback_swap();
+    if (trans->slave_callback) {
+        trans->slave_callback(trans->initiator2target_buffer_size, split_trans_initiator2target_buffer(trans), trans->target2initiator_buffer_size, split_trans_target2initiator_buffer(trans));
+    }
+    loopback_swap();
+    memcpy(split_trans_target2initiator_buffer(trans), &target_base[trans->target2initiator_offset], trans->target2initiator_buffer_size);
+    loopback_stats.bytes += trans->target2initiator_buffer_size;
+
+    if (target2initiator_length > 0) {
+        size_t len = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+        memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+    }
+
+    return true;
+}
@@ -0,0 +1,25 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include <stdbool.h>
+
+#include "matrix.h"
+
+typedef struct loopback_stats_t {
+    uint32_t transactions;
+    uint32_t bytes;
+} loopback_stats_t;
+
+extern loopback_stats_t loopback_stats;
+
+// Resets both halves' shared memory and the statistics
+void loopback_reset(void);
+
+// Makes the given number of upcoming transactions fail on the wire
+void loopback_drop_transactions(uint8_t count);
+
+// Runs the slave side handlers against the slave's copy of the shared memory
+void loopback_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]);
@@ -21,6 +21,10 @@ enum serial_transaction_id {
     I2C_EXECUTE_CALLBACK,
 #endif // USE_I2C
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+    EXCHANGE_BATCH,
+#endif // SPLIT_TRANSPORT_BATCHED
+
     GET_SLAVE_MATRIX_CHECKSUM,
     GET_SLAVE_MATRIX_DATA,
 
@@ -20,6 +20,7 @@
 
 #include "crc.h"
 #include "debug.h"
+#include "util.h"
 #include "matrix.h"
 #include "host.h"
 #include "action_util.h"
@@ -84,9 +85,18 @@
 #define trans_initiator2target_cb(cb) \
     { 0, 0, 0, 0, cb }
 
-#define transport_write(id, data, length) transport_execute_transaction(id, data, length, NULL, 0)
-#define transport_read(id, data, length) transport_execute_transaction(id, NULL, 0, data, length)
-#define transport_exec(id) transport_execute_transaction(id, NULL, 0, NULL, 0)
+#define trans_bidirectional_initializer_cb(initiator2target_member, target2initiator_member, cb) \
+    { sizeof_member(split_shared_memory_t, initiator2target_member), offsetof(split_shared_memory_t, initiator2target_member), sizeof_member(split_shared_memory_t, target2initiator_member), offsetof(split_shared_memory_t, target2initiator_member), cb }
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+#    define transport_transaction batch_execute_transaction
+#else // SPLIT_TRANSPORT_BATCHED
+#    define transport_transaction transport_execute_transaction
+#endif // SPLIT_TRANSPORT_BATCHED
+
+#define transport_write(id, data, length) transport_transaction(id, data, length, NULL, 0)
+#define transport_read(id, data, length) transport_transaction(id, NULL, 0, data, length)
+#define transport_exec(id) transport_transaction(id, NULL, 0, NULL, 0)
 
 #if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 // Forward-declare the RPC callback handlers
@@ -94,6 +104,314 @@ void slave_rpc_info_callback(uint8_t initiator2target_buffer_size, const void *i
 void slave_rpc_exec_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer);
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 
+////////////////////////////////////////////////////
+// Batched transport
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+
+/*
+ * Instead of one transaction per feature, the master sends a single EXCHANGE_BATCH transaction per scan:
+ *
+ * - writes issued by the master handlers are staged and sent with the exchange, as records holding only the span of
+ *   bytes that changed since the previous exchange; a write of unchanged data is a forced sync and sends the whole
+ *   region
+ * - the slave applies them and answers with every target-to-initiator region that changed since its last response,
+ *   encoded the same way; the master keeps a mirror of these regions and serves the handlers' reads from it
+ *
+ * Frames are [crc8][length][info][records...], a record is [id | BATCH_RECORD_FULL][region] or
+ * [id][offset][length][bytes]. Both frame buffers have a fixed size, only the first length bytes are meaningful.
+ */
+
+#    define BATCH_FRAME_HEADER_SIZE 3
+#    define BATCH_RECORD_FULL 0x80
+#    define BATCH_RECORD_ID_MASK 0x1F
+#    define BATCH_INFO_FLAG 0x80
+#    define BATCH_INFO_RESUME_MASK 0x3F
+#    define BATCH_MIRRORED_SIZE offsetof(split_shared_memory_t, batch)
+#    define BATCH_ID_BIT(id) (((uint32_t)1) << (id))
+
+_Static_assert(SPLIT_TRANSPORT_BATCH_SIZE > BATCH_FRAME_HEADER_SIZE && SPLIT_TRANSPORT_BATCH_SIZE <= UINT8_MAX, "SPLIT_TRANSPORT_BATCH_SIZE must be between 4 and 255");
+_Static_assert(NUM_TOTAL_TRANSACTIONS <= BATCH_RECORD_ID_MASK + 1, "Batch records only hold 5 bit transaction IDs");
+
+// Master side
+static bool     batch_staging     = false;
+static bool     batch_resync      = true;
+static uint32_t batch_last_resync = 0;
+static uint32_t batch_dirty       = 0; // staged writes not sent yet
+static uint32_t batch_full        = 0; // staged writes to be sent as whole region
+static uint32_t batch_fresh       = 0; // reads the mirror is up to date for
+static uint8_t  batch_span_start[NUM_TOTAL_TRANSACTIONS];
+static uint8_t  batch_span_end[NUM_TOTAL_TRANSACTIONS];
+static uint8_t  batch_mirror[BATCH_MIRRORED_SIZE];
+
+// Slave side
+static uint32_t batch_pending_full = 0;
+static uint8_t  batch_shadow[BATCH_MIRRORED_SIZE];
+
+static bool batch_is_staged(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    // Slave callbacks expect to be run in order with the handlers
+    if (trans->slave_callback != NULL) {
+        return false;
+    }
+#    ifndef DISABLE_SYNC_TIMER
+    // The sync timer has to go out right away to stay accurate
+    if (id == PUT_SYNC_TIMER) {
+        return false;
+    }
+#    endif // DISABLE_SYNC_TIMER
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id == PUT_RPC_REQ_DATA) {
+        return false;
+    }
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return trans->initiator2target_buffer_size > 0 && BATCH_FRAME_HEADER_SIZE + 1 + trans->initiator2target_buffer_size <= SPLIT_TRANSPORT_BATCH_SIZE;
+}
+
+static bool batch_is_mirrored(int8_t id) {
+    split_transaction_desc_t *trans = &split_transaction_table[id];
+    if (trans->slave_callback != NULL) {
+        return false;
+    }
+#    if defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    if (id == GET_RPC_RESP_DATA) {
+        return false;
+    }
+#    endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
+    return trans->target2initiator_buffer_size > 0 && BATCH_FRAME_HEADER_SIZE + 1 + trans->target2initiator_buffer_size <= SPLIT_TRANSPORT_BATCH_SIZE;
+}
+
+// Finds the span of bytes that differ between both buffers, returns false if they are equal
+static bool batch_diff_span(const uint8_t *old_data, const uint8_t *new_data, uint8_t length, uint8_t *start, uint8_t *end) {
+    uint8_t first = 0;
+    while (first < length && old_data[first] == new_data[first]) {
+        ++first;
+    }
+    if (first == length) {
+        return false;
+    }
+    uint8_t last = length;
+    while (old_data[last - 1] == new_data[last - 1]) {
+        --last;
+    }
+    *start = first;
+    *end   = last;
+    return true;
+}
+
+// Appends a record to the frame, returns the new frame length or 0 if the record doesn't fit
+static uint8_t batch_put_record(uint8_t *frame, uint8_t length, int8_t id, const uint8_t *region, uint8_t size, uint8_t start, uint8_t end, bool full) {
+    uint8_t count = end - start;
+    if (full || 3 + count >= 1 + size) {
+        if (length + 1 + size > SPLIT_TRANSPORT_BATCH_SIZE) {
+            return 0;
+        }
+        frame[length++] = id | BATCH_RECORD_FULL;
+        memcpy(&frame[length], region, size);
+        return length + size;
+    }
+    if (length + 3 + count > SPLIT_TRANSPORT_BATCH_SIZE) {
+        return 0;
+    }
+    frame[length++] = id;
+    frame[length++] = start;
+    frame[length++] = count;
+    memcpy(&frame[length], &region[start], count);
+    return length + count;
+}
+
+static void batch_seal_frame(uint8_t *frame, uint8_t length, uint8_t info) {
+    frame[1] = length;
+    frame[2] = info;
+    frame[0] = crc8(&frame[1], length - 1);
+}
+
+// Copies all records of a frame to their regions in base, returns false if the frame is corrupt
+static bool batch_apply_frame(const uint8_t *frame, uint8_t *base, bool initiator2target) {
+    uint8_t length = frame[1];
+    if (length < BATCH_FRAME_HEADER_SIZE || length > SPLIT_TRANSPORT_BATCH_SIZE || frame[0] != crc8(&frame[1], length - 1)) {
+        return false;
+    }
+
+    uint8_t pos = BATCH_FRAME_HEADER_SIZE;
+    while (pos < length) {
+        int8_t id   = frame[pos] & BATCH_RECORD_ID_MASK;
+        bool   full = frame[pos] & BATCH_RECORD_FULL;
+        ++pos;
+        if (id >= NUM_TOTAL_TRANSACTIONS || !(initiator2target ? batch_is_staged(id) : batch_is_mirrored(id))) {
+            return false;
+        }
+
+        split_transaction_desc_t *trans  = &split_transaction_table[id];
+        uint16_t                  offset = initiator2target ? trans->initiator2target_offset : trans->target2initiator_offset;
+        uint8_t                   size   = initiator2target ? trans->initiator2target_buffer_size : trans->target2initiator_buffer_size;
+        uint8_t                   start  = 0;
+        uint8_t                   count  = size;
+        if (!full) {
+            if (pos + 2 > length) {
+                return false;
+            }
+            start = frame[pos++];
+            count = frame[pos++];
+        }
+        if (start + count > size || pos + count > length) {
+            return false;
+        }
+        memcpy(&base[offset + start], &frame[pos], count);
+        pos += count;
+    }
+    return true;
+}
+
+static bool batch_stage_write(int8_t id, const void *data, uint16_t length) {
+    split_transaction_desc_t *trans  = &split_transaction_table[id];
+    uint8_t                  *region = split_trans_initiator2target_buffer(trans);
+    uint8_t                   len    = trans->initiator2target_buffer_size < length ? trans->initiator2target_buffer_size : length;
+    uint8_t                   start;
+    uint8_t                   end;
+
+    if (!batch_diff_span(region, data, len, &start, &end)) {
+        // Handlers only write unchanged data to force a sync
+        batch_full |= BATCH_ID_BIT(id);
+    } else if (batch_dirty & BATCH_ID_BIT(id)) {
+        batch_span_start[id] = MIN(batch_span_start[id], start);
+        batch_span_end[id]   = MAX(batch_span_end[id], end);
+    } else {
+        batch_span_start[id] = start;
+        batch_span_end[id]   = end;
+    }
+    memcpy(region, data, len);
+    batch_dirty |= BATCH_ID_BIT(id);
+    return true;
+}
+
+static void batch_build_request(uint8_t *frame, uint32_t *sent, uint8_t info) {
+    uint8_t length = BATCH_FRAME_HEADER_SIZE;
+    *sent          = 0;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!(batch_dirty & BATCH_ID_BIT(id))) {
+            continue;
+        }
+        split_transaction_desc_t *trans = &split_transaction_table[id];
+        uint8_t                   next  = batch_put_record(frame, length, id, split_trans_initiator2target_buffer(trans), trans->initiator2target_buffer_size, batch_span_start[id], batch_span_end[id], batch_full & BATCH_ID_BIT(id));
+        if (next == 0) {
+            // Out of space, the remaining writes go out with the next exchange
+            break;
+        }
+        length = next;
+        *sent |= BATCH_ID_BIT(id);
+    }
+    batch_dirty &= ~*sent;
+    batch_full &= ~*sent;
+    batch_seal_frame(frame, length, info);
+}
+
+static void batch_requeue(uint32_t ids) {
+    batch_dirty |= ids;
+    batch_full |= ids;
+}
+
+static bool batch_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    uint8_t  request[SPLIT_TRANSPORT_BATCH_SIZE];
+    uint8_t  response[SPLIT_TRANSPORT_BATCH_SIZE];
+    uint32_t sent;
+
+    if (timer_elapsed32(batch_last_resync) >= FORCED_SYNC_THROTTLE_MS) {
+        batch_resync = true;
+    }
+
+    // The request info flags a resync, the slave answers with all of its regions
+    bool resync = batch_resync;
+    batch_build_request(request, &sent, resync ? BATCH_INFO_FLAG : 0);
+    if (!transport_execute_transaction(EXCHANGE_BATCH, request, sizeof(request), response, sizeof(response)) || !batch_apply_frame(response, batch_mirror, false)) {
+        batch_requeue(sent);
+        batch_resync = true;
+        return false;
+    }
+
+    // The response info flags a corrupt request, it is resent in full
+    uint8_t info = response[2];
+    if (info & BATCH_INFO_FLAG) {
+        batch_requeue(sent);
+        return false;
+    }
+
+    if (resync) {
+        batch_resync      = false;
+        batch_last_resync = timer_read32();
+    }
+    for (int8_t id = 0; id < (info & BATCH_INFO_RESUME_MASK) && id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (batch_is_mirrored(id)) {
+            batch_fresh |= BATCH_ID_BIT(id);
+        }
+    }
+    return true;
+}
+
+static bool batch_execute_transaction(int8_t id, const void *initiator2target_buf, uint16_t initiator2target_length, void *target2initiator_buf, uint16_t target2initiator_length) {
+    if (batch_staging) {
+        if (initiator2target_length > 0 && target2initiator_length == 0 && batch_is_staged(id)) {
+            return batch_stage_write(id, initiator2target_buf, initiator2target_length);
+        }
+        if (initiator2target_length == 0 && target2initiator_length > 0 && (batch_fresh & BATCH_ID_BIT(id))) {
+            split_transaction_desc_t *trans = &split_transaction_table[id];
+            size_t                    len   = trans->target2initiator_buffer_size < target2initiator_length ? trans->target2initiator_buffer_size : target2initiator_length;
+            memcpy(split_trans_target2initiator_buffer(trans), &batch_mirror[trans->target2initiator_offset], trans->target2initiator_buffer_size);
+            memcpy(target2initiator_buf, split_trans_target2initiator_buffer(trans), len);
+            return true;
+        }
+    }
+    return transport_execute_transaction(id, initiator2target_buf, initiator2target_length, target2initiator_buf, target2initiator_length);
+}
+
+static void batch_exchange_slave_callback(uint8_t initiator2target_buffer_size, const void *initiator2target_buffer, uint8_t target2initiator_buffer_size, void *target2initiator_buffer) {
+    const uint8_t *request  = split_shmem->batch.m2s_frame;
+    bool           rejected = !batch_apply_frame(request, (uint8_t *)split_shmem, true);
+    if (!rejected && (request[2] & BATCH_INFO_FLAG)) {
+        batch_pending_full = UINT32_MAX;
+    }
+
+    // Encode every region that changed since it was last sent
+    uint8_t *frame  = split_shmem->batch.s2m_frame;
+    uint8_t  length = BATCH_FRAME_HEADER_SIZE;
+    uint8_t  resume = NUM_TOTAL_TRANSACTIONS;
+    for (int8_t id = 0; id < NUM_TOTAL_TRANSACTIONS; ++id) {
+        if (!batch_is_mirrored(id)) {
+            continue;
+        }
+        split_transaction_desc_t *trans  = &split_transaction_table[id];
+        uint8_t                  *region = split_trans_target2initiator_buffer(trans);
+        uint8_t                  *shadow = &batch_shadow[trans->target2initiator_offset];
+        uint8_t                   size   = trans->target2initiator_buffer_size;
+        bool                      full   = batch_pending_full & BATCH_ID_BIT(id);
+        uint8_t                   start  = 0;
+        uint8_t                   end    = size;
+        if (!full && !batch_diff_span(shadow, region, size, &start, &end)) {
+            continue;
+        }
+        uint8_t next = batch_put_record(frame, length, id, region, size, start, end, full);
+        if (next == 0) {
+            resume = id;
+            break;
+        }
+        length = next;
+        memcpy(&shadow[start], &region[start], end - start);
+        batch_pending_full &= ~BATCH_ID_BIT(id);
+    }
+    batch_seal_frame(frame, length, resume | (rejected ? BATCH_INFO_FLAG : 0));
+}
+
+// clang-format off
+#    define TRANSACTIONS_BATCH_REGISTRATIONS \
+    [EXCHANGE_BATCH] = trans_bidirectional_initializer_cb(batch.m2s_frame, batch.s2m_frame, batch_exchange_slave_callback),
+// clang-format on
+
+#else // SPLIT_TRANSPORT_BATCHED
+
+#    define TRANSACTIONS_BATCH_REGISTRATIONS
+
+#endif // SPLIT_TRANSPORT_BATCHED
+
 ////////////////////////////////////////////////////
 // Helpers
 
@@ -925,6 +1243,7 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // USE_I2C
 
     // clang-format off
+    TRANSACTIONS_BATCH_REGISTRATIONS
     TRANSACTIONS_SLAVE_MATRIX_REGISTRATIONS
     TRANSACTIONS_MASTER_MATRIX_REGISTRATIONS
     TRANSACTIONS_ENCODERS_REGISTRATIONS
@@ -954,6 +1273,54 @@ split_transaction_desc_t split_transaction_table[NUM_TOTAL_TRANSACTIONS] = {
 #endif // defined(SPLIT_TRANSACTION_IDS_KB) || defined(SPLIT_TRANSACTION_IDS_USER)
 };
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+
+// Handlers that send master state, their writes are staged for the exchange
+static bool batch_put_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_MASTER_MATRIX_MASTER();
+    TRANSACTIONS_SYNC_TIMER_MASTER();
+    TRANSACTIONS_LAYER_STATE_MASTER();
+    TRANSACTIONS_LED_STATE_MASTER();
+    TRANSACTIONS_MODS_MASTER();
+    TRANSACTIONS_BACKLIGHT_MASTER();
+    TRANSACTIONS_RGBLIGHT_MASTER();
+    TRANSACTIONS_LED_MATRIX_MASTER();
+    TRANSACTIONS_RGB_MATRIX_MASTER();
+    TRANSACTIONS_WPM_MASTER();
+    TRANSACTIONS_OLED_MASTER();
+    TRANSACTIONS_ST7565_MASTER();
+    TRANSACTIONS_WATCHDOG_MASTER();
+    TRANSACTIONS_HAPTIC_MASTER();
+    TRANSACTIONS_ACTIVITY_MASTER();
+    TRANSACTIONS_DETECTED_OS_MASTER();
+    return true;
+}
+
+// Handlers that fetch slave state, their reads are served from the mirror the exchange refreshed
+static bool batch_get_handlers_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    TRANSACTIONS_SLAVE_MATRIX_MASTER();
+    TRANSACTIONS_ENCODERS_MASTER();
+    TRANSACTIONS_POINTING_MASTER();
+    return true;
+}
+
+bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
+    batch_fresh   = 0;
+    batch_staging = true;
+    bool okay     = batch_put_handlers_master(master_matrix, slave_matrix);
+    if (okay) {
+        okay = transaction_handler_master(master_matrix, slave_matrix, "batch", &batch_handlers_master);
+    }
+    if (okay) {
+        // Writes issued from here on, like a pointing CPI change, go out with the next exchange
+        okay = batch_get_handlers_master(master_matrix, slave_matrix);
+    }
+    batch_staging = false;
+    return okay;
+}
+
+#else // SPLIT_TRANSPORT_BATCHED
+
 bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_MASTER();
     TRANSACTIONS_MASTER_MATRIX_MASTER();
@@ -977,6 +1344,8 @@ bool transactions_master(matrix_row_t master_matrix[], matrix_row_t slave_matrix
     return true;
 }
 
+#endif // SPLIT_TRANSPORT_BATCHED
+
 void transactions_slave(matrix_row_t master_matrix[], matrix_row_t slave_matrix[]) {
     TRANSACTIONS_SLAVE_MATRIX_SLAVE();
     TRANSACTIONS_MASTER_MATRIX_SLAVE();
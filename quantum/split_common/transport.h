@@ -31,6 +31,12 @@
 #    define RPC_S2M_BUFFER_SIZE 32
 #endif // RPC_S2M_BUFFER_SIZE
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+#    ifndef SPLIT_TRANSPORT_BATCH_SIZE
+#        define SPLIT_TRANSPORT_BATCH_SIZE 32
+#    endif // SPLIT_TRANSPORT_BATCH_SIZE
+#endif     // SPLIT_TRANSPORT_BATCHED
+
 void transport_master_init(void);
 void transport_slave_init(void);
 
@@ -147,6 +153,13 @@ typedef struct _rpc_sync_info_t {
 #    include "os_detection.h"
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
 
+#ifdef SPLIT_TRANSPORT_BATCHED
+typedef struct _split_batch_sync_t {
+    uint8_t m2s_frame[SPLIT_TRANSPORT_BATCH_SIZE];
+    uint8_t s2m_frame[SPLIT_TRANSPORT_BATCH_SIZE];
+} split_batch_sync_t;
+#endif // SPLIT_TRANSPORT_BATCHED
+
 typedef struct _split_shared_memory_t {
 #ifdef USE_I2C
     int8_t transaction_id;
@@ -231,6 +244,11 @@ typedef struct _split_shared_memory_t {
 #if defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
     os_variant_t detected_os;
 #endif // defined(OS_DETECTION_ENABLE) && defined(SPLIT_DETECTED_OS_ENABLE)
+
+#ifdef SPLIT_TRANSPORT_BATCHED
+    // Must stay the last member, everything before it is mirrored by the batched transport
+    split_batch_sync_t batch;
+#endif // SPLIT_TRANSPORT_BATCHED
 } split_shared_memory_t;
 
 extern split_shared_memory_t *const split_shmem;
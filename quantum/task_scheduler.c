@@ -0,0 +1,180 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stddef.h>
+#include "task_scheduler.h"
+#include "timer.h"
+#include "progmem.h"
+#include "tracing.h"
+
+#if defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+#if defined(__AVR__)
+#    if defined(__AVR_ATmega32A__)
+#        define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define TIMER_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#    else
+#        define TIMER_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#    endif
+
+// Timer 0 ticks: the milliseconds so far plus the count within the current one
+uint32_t task_scheduler_clock(void) {
+    uint32_t count;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = timer_count;
+        raw   = TIMER_RAW;
+        // The counter may have wrapped without the interrupt being served yet
+        if (TIMER_COMPARE_PENDING()) {
+            count++;
+            raw = TIMER_RAW;
+        }
+    }
+
+    return count * (TIMER_RAW_TOP + 1) + raw;
+}
+
+uint32_t task_scheduler_clock_frequency(void) {
+    return (uint32_t)(TIMER_RAW_TOP + 1) * 1000;
+}
+#elif defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE
+uint32_t task_scheduler_clock(void) {
+    return (uint32_t)chSysGetRealtimeCounterX();
+}
+
+uint32_t task_scheduler_clock_frequency(void) {
+    return REALTIME_COUNTER_CLOCK;
+}
+#elif defined(PROTOCOL_CHIBIOS)
+// System ticks, for ports without a realtime counter such as Cortex-M0
+uint32_t task_scheduler_clock(void) {
+    uint32_t systime = (uint32_t)chVTGetSystemTimeX();
+#    if CH_CFG_ST_RESOLUTION < 32
+    // Called on every loop, often enough to catch each overflow of a narrower system timer
+    static uint32_t last_systime = 0;
+    static uint32_t overflow     = 0;
+    if (systime < last_systime) {
+        overflow += ((uint32_t)1) << CH_CFG_ST_RESOLUTION;
+    }
+    last_systime = systime;
+    systime += overflow;
+#    endif
+    return systime;
+}
+
+uint32_t task_scheduler_clock_frequency(void) {
+    return CH_CFG_ST_FREQUENCY;
+}
+#else
+uint32_t task_scheduler_clock(void) {
+    return timer_read32();
+}
+
+uint32_t task_scheduler_clock_frequency(void) {
+    return 1000;
+}
+#endif
+
+uint32_t task_scheduler_ticks_to_us(uint32_t ticks) {
+    return (uint64_t)ticks * 1000000 / task_scheduler_clock_frequency();
+}
+
+void task_scheduler_set_budget(task_scheduler_t *scheduler, uint32_t budget_us) {
+    scheduler->budget = (uint64_t)budget_us * task_scheduler_clock_frequency() / 1000000;
+    // Don't let a short budget round down to no limit at all
+    if (budget_us > 0 && scheduler->budget == 0) {
+        scheduler->budget = 1;
+    }
+}
+
+bool task_scheduler_register(task_scheduler_t *scheduler, scheduled_task_fn_t task, uint16_t period_ms, uint8_t priority) {
+    if (scheduler->registered_count >= scheduler->registered_size) {
+        return false;
+    }
+
+    scheduler->registered[scheduler->registered_count] = (scheduled_task_t){.task = task, .period_ms = period_ms, .priority = priority, .trace_id = SCHEDULED_TASK_NO_TRACE};
+    scheduler->state[scheduler->count + scheduler->registered_count] = (scheduled_task_state_t){0};
+    scheduler->registered_count++;
+    return true;
+}
+
+// Table tasks are read from PROGMEM, registered ones from RAM
+static void task_get(const task_scheduler_t *scheduler, uint8_t index, scheduled_task_t *task) {
+    if (index < scheduler->count) {
+        memcpy_P(task, &scheduler->tasks[index], sizeof(scheduled_task_t));
+    } else {
+        *task = scheduler->registered[index - scheduler->count];
+    }
+}
+
+static bool task_is_due(const scheduled_task_t *task, const scheduled_task_state_t *state) {
+    return task->period_ms == 0 || state->runs == 0 || timer_elapsed(state->last_run) >= task->period_ms;
+}
+
+// Runs a task, returning the time it finished at so that the next task's duration can be measured from there
+static uint32_t task_run(const scheduled_task_t *task, scheduled_task_state_t *state, uint32_t start) {
+    state->last_run = timer_read();
+    if (task->trace_id == SCHEDULED_TASK_NO_TRACE) {
+        task->task();
+    } else {
+        TRACE_SPAN(task->trace_id, task->task());
+    }
+
+    uint32_t end      = task_scheduler_clock();
+    uint32_t duration = end - start;
+    if (duration > state->max_duration) {
+        state->max_duration = duration;
+    }
+    state->runs++;
+    state->deferred = false;
+    return end;
+}
+
+void task_scheduler_run(task_scheduler_t *scheduler, uint32_t loop_start) {
+    uint32_t now   = task_scheduler_clock();
+    uint8_t  total = scheduler->count + scheduler->registered_count;
+
+    for (uint8_t i = 0; i < total; i++) {
+        scheduled_task_t        task;
+        scheduled_task_state_t *state = &scheduler->state[i];
+        task_get(scheduler, i, &task);
+        if (!task_is_due(&task, state)) {
+            continue;
+        }
+
+        if (task.priority == TASK_PRIORITY_BACKGROUND && scheduler->budget > 0 && !state->deferred && now - loop_start >= scheduler->budget) {
+            state->deferred = true;
+            state->deferrals++;
+            continue;
+        }
+
+        now = task_run(&task, state, now);
+    }
+}
+
+const scheduled_task_state_t *task_scheduler_get_state(const task_scheduler_t *scheduler, scheduled_task_fn_t task) {
+    for (uint8_t i = 0; i < scheduler->count + scheduler->registered_count; i++) {
+        scheduled_task_t entry;
+        task_get(scheduler, i, &entry);
+        if (entry.task == task) {
+            return &scheduler->state[i];
+        }
+    }
+    return NULL;
+}
+
+void task_scheduler_clear_stats(task_scheduler_t *scheduler) {
+    for (uint8_t i = 0; i < scheduler->count + scheduler->registered_count; i++) {
+        scheduler->state[i].runs         = 0;
+        scheduler->state[i].deferrals    = 0;
+        scheduler->state[i].max_duration = 0;
+    }
+}
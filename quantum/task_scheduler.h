@@ -0,0 +1,128 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Cooperative scheduling of the tasks run by keyboard_task() after the matrix scan.
+
+    Tasks are run in table order, each at most once per period, followed by the ones registered at runtime.
+    Background tasks -- lighting and displays, which may take several milliseconds to render or flush -- are
+    additionally time-sliced against a per-loop budget: once the budget is spent, the rest of them are deferred to the
+    next loop. A task deferred on one loop is never deferred on the next, so that none of them starve.
+
+    The budget is measured with the finest clock of the platform, see task_scheduler_clock(). It defaults to 0, which
+    runs every due task on each loop, as keyboard_task() always has.
+*/
+
+/**
+ * @typedef A task to be run by the scheduler.
+ */
+typedef void (*scheduled_task_fn_t)(void);
+
+/**
+ * @enum Scheduling priorities. Foreground tasks are always run when due, background ones are subject to the budget.
+ */
+enum {
+    TASK_PRIORITY_FOREGROUND,
+    TASK_PRIORITY_BACKGROUND,
+};
+
+/**
+ * @brief The trace_id of tasks that don't record a span.
+ */
+#define SCHEDULED_TASK_NO_TRACE 0xFF
+
+/**
+ * @struct A task. Static tables of these are expected to be in PROGMEM.
+ */
+typedef struct scheduled_task_t {
+    scheduled_task_fn_t task;
+    uint16_t            period_ms; // 0 runs the task on every loop
+    uint8_t             priority;
+    uint8_t             trace_id; // The span recorded around each run, see tracing.h
+} scheduled_task_t;
+
+/**
+ * @struct Per-task state and diagnostics, one per task.
+ */
+typedef struct scheduled_task_state_t {
+    uint32_t runs;
+    uint32_t deferrals;    // The number of loops the task was due, but deferred for lack of budget
+    uint32_t max_duration; // The worst case time taken by a single run, in clock ticks
+    uint16_t last_run;
+    bool     deferred; // Deferred on the previous loop
+} scheduled_task_state_t;
+
+/**
+ * @struct Scheduler state for a table of tasks, and the ones registered at runtime.
+ */
+typedef struct task_scheduler_t {
+    const scheduled_task_t *tasks; // In PROGMEM
+    uint8_t                 count;
+    scheduled_task_t       *registered;
+    uint8_t                 registered_count;
+    uint8_t                 registered_size;
+    scheduled_task_state_t *state;  // count + registered_size of them
+    uint32_t                budget; // In clock ticks, 0 for no limit
+} task_scheduler_t;
+
+/**
+ * The scheduler clock, in ticks at the rate returned by task_scheduler_clock_frequency(): timer 0 ticks on AVR, the
+ * realtime counter on ChibiOS ports that have one, system ticks on those that don't, milliseconds elsewhere.
+ */
+uint32_t task_scheduler_clock(void);
+
+/**
+ * @return the number of scheduler clock ticks per second
+ */
+uint32_t task_scheduler_clock_frequency(void);
+
+/**
+ * Converts a number of scheduler clock ticks to microseconds.
+ */
+uint32_t task_scheduler_ticks_to_us(uint32_t ticks);
+
+/**
+ * Sets the time a loop may take before background tasks are deferred.
+ *
+ * @param scheduler[in,out] the table and its state
+ * @param budget_us[in] the budget in microseconds, rounded to clock ticks, 0 for no limit
+ */
+void task_scheduler_set_budget(task_scheduler_t *scheduler, uint32_t budget_us);
+
+/**
+ * Adds a task to be run after the table, until the scheduler's registration slots run out.
+ *
+ * @param scheduler[in,out] the table and its state
+ * @param task[in] the task to run
+ * @param period_ms[in] the minimum time between two runs, 0 to run on every loop
+ * @param priority[in] TASK_PRIORITY_FOREGROUND or TASK_PRIORITY_BACKGROUND
+ * @return true if the task was added
+ */
+bool task_scheduler_register(task_scheduler_t *scheduler, scheduled_task_fn_t task, uint16_t period_ms, uint8_t priority);
+
+/**
+ * Runs the due tasks in order, deferring background ones once the budget is spent.
+ *
+ * @param scheduler[in,out] the table and its state
+ * @param loop_start[in] the time the current loop started at, as returned by task_scheduler_clock()
+ */
+void task_scheduler_run(task_scheduler_t *scheduler, uint32_t loop_start);
+
+/**
+ * Looks up the diagnostics of a task.
+ *
+ * @param scheduler[in] the table and its state
+ * @param task[in] the task to look up
+ * @return the state of the task, or NULL if it isn't scheduled
+ */
+const scheduled_task_state_t *task_scheduler_get_state(const task_scheduler_t *scheduler, scheduled_task_fn_t task);
+
+/**
+ * Resets the diagnostics of every task.
+ */
+void task_scheduler_clear_stats(task_scheduler_t *scheduler);
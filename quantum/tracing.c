@@ -0,0 +1,166 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "tracing.h"
+#include "timer.h"
+#include "print.h"
+
+#if defined(__AVR__)
+#    include <avr/io.h>
+#    include <util/atomic.h>
+#    include "timer_avr.h"
+#elif defined(PROTOCOL_CHIBIOS)
+#    include <ch.h>
+#endif
+
+#ifndef TRACING_BUFFER_SIZE
+#    define TRACING_BUFFER_SIZE 64
+#endif
+
+#ifndef TRACING_CONSOLE_RECORDS
+#    define TRACING_CONSOLE_RECORDS 12
+#endif
+
+// Free running 8-bit indices are used, so their difference always gives the fill level
+_Static_assert(TRACING_BUFFER_SIZE > 0 && TRACING_BUFFER_SIZE <= 128 && (TRACING_BUFFER_SIZE & (TRACING_BUFFER_SIZE - 1)) == 0, "TRACING_BUFFER_SIZE must be a power of two, up to 128");
+
+#define TRACING_BUFFER_MASK (TRACING_BUFFER_SIZE - 1)
+
+// Keeps the compiler from moving the buffer accesses across the index updates
+#define tracing_barrier() __asm__ __volatile__("" ::: "memory")
+
+typedef struct {
+    uint32_t timestamp;
+    uint8_t  id;
+} trace_record_t;
+
+static trace_record_t   records[TRACING_BUFFER_SIZE];
+static volatile uint8_t head = 0; // Only written when recording
+static volatile uint8_t tail = 0; // Only written when reading
+
+// The number of records lost to a full buffer, and how many of those were reported
+static volatile uint32_t dropped          = 0;
+static uint32_t          dropped_reported = 0;
+
+#if defined(__AVR__)
+// The millisecond count kept by the timer 0 compare match interrupt
+extern volatile uint32_t timer_count;
+
+#    if defined(__AVR_ATmega32A__)
+#        define TRACING_COMPARE_PENDING() (TIFR & _BV(OCF0))
+#    elif defined(__AVR_ATtiny85__)
+#        define TRACING_COMPARE_PENDING() (TIFR & _BV(OCF0A))
+#    else
+#        define TRACING_COMPARE_PENDING() (TIFR0 & _BV(OCF0A))
+#    endif
+
+// Timer 0 ticks, at F_CPU / TIMER_PRESCALER: the milliseconds so far plus the count within the current one
+__attribute__((weak)) uint32_t tracing_timestamp(void) {
+    uint32_t count;
+    uint8_t  raw;
+
+    ATOMIC_BLOCK(ATOMIC_RESTORESTATE) {
+        count = timer_count;
+        raw   = TIMER_RAW;
+        // The counter may have wrapped without the interrupt being served yet
+        if (TRACING_COMPARE_PENDING()) {
+            count++;
+            raw = TIMER_RAW;
+        }
+    }
+
+    return count * (TIMER_RAW_TOP + 1) + raw;
+}
+#elif defined(PROTOCOL_CHIBIOS) && PORT_SUPPORTS_RT == TRUE
+// The realtime counter, usually the CPU cycle counter
+__attribute__((weak)) uint32_t tracing_timestamp(void) {
+    return (uint32_t)chSysGetRealtimeCounterX();
+}
+#elif defined(PROTOCOL_CHIBIOS)
+// System ticks, at CH_CFG_ST_FREQUENCY, for ports without a realtime counter such as Cortex-M0
+__attribute__((weak)) uint32_t tracing_timestamp(void) {
+    uint32_t systime = (uint32_t)chVTGetSystemTimeX();
+#    if CH_CFG_ST_RESOLUTION < 32
+    // Spans are recorded every scan, often enough to catch each overflow of a narrower system timer
+    static uint32_t last_systime = 0;
+    static uint32_t overflow     = 0;
+    if (systime < last_systime) {
+        overflow += ((uint32_t)1) << CH_CFG_ST_RESOLUTION;
+    }
+    last_systime = systime;
+    systime += overflow;
+#    endif
+    return systime;
+}
+#else
+__attribute__((weak)) uint32_t tracing_timestamp(void) {
+    return timer_read32();
+}
+#endif
+
+void tracing_record(uint8_t id, bool begin) {
+    uint32_t timestamp = tracing_timestamp();
+    uint8_t  index     = head;
+
+    if ((uint8_t)(index - tail) >= TRACING_BUFFER_SIZE) {
+        dropped = dropped + 1;
+        return;
+    }
+
+    records[index & TRACING_BUFFER_MASK] = (trace_record_t){.timestamp = timestamp, .id = id | (begin ? TRACE_RECORD_BEGIN : 0)};
+    tracing_barrier();
+    head = index + 1;
+}
+
+static void tracing_serialise(uint8_t *data, uint8_t id, uint32_t timestamp) {
+    data[0] = id;
+    data[1] = timestamp & 0xFF;
+    data[2] = (timestamp >> 8) & 0xFF;
+    data[3] = (timestamp >> 16) & 0xFF;
+    data[4] = (timestamp >> 24) & 0xFF;
+}
+
+uint8_t tracing_read(uint8_t *data, uint8_t length) {
+    uint8_t written = 0;
+
+    // Lost records are reported first, so that the decoder knows not to pair spans across them
+    uint32_t lost = dropped - dropped_reported;
+    if (lost > 0 && length >= TRACE_RECORD_SIZE) {
+        tracing_serialise(data, TRACE_DROPPED, lost);
+        dropped_reported += lost;
+        written += TRACE_RECORD_SIZE;
+    }
+
+    uint8_t index = tail;
+    while (index != head && length - written >= TRACE_RECORD_SIZE) {
+        const trace_record_t *record = &records[index & TRACING_BUFFER_MASK];
+        tracing_serialise(&data[written], record->id, record->timestamp);
+        written += TRACE_RECORD_SIZE;
+        index++;
+    }
+    tracing_barrier();
+    tail = index;
+
+    return written;
+}
+
+void tracing_clear(void) {
+    tail             = head;
+    dropped_reported = dropped;
+}
+
+void tracing_task(void) {
+#if defined(CONSOLE_ENABLE) && !defined(TRACING_NO_CONSOLE)
+    uint8_t buffer[TRACING_CONSOLE_RECORDS * TRACE_RECORD_SIZE];
+    uint8_t length = tracing_read(buffer, sizeof(buffer));
+    if (length == 0) {
+        return;
+    }
+
+    print("trace:");
+    for (uint8_t i = 0; i < length; i++) {
+        print_hex8(buffer[i]);
+    }
+    print("\n");
+#endif
+}
@@ -0,0 +1,117 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdbool.h>
+#include <stdint.h>
+
+/*
+    Lightweight tracing of named spans, recorded as timestamps into a ring buffer and drained over console or raw HID.
+
+    Usage example:
+
+        #include "tracing.h"
+
+        TRACE_BEGIN(TRACE_USER);
+        do_something_expensive();
+        TRACE_END(TRACE_USER);
+
+        // or, equivalently:
+        TRACE_SPAN(TRACE_USER, do_something_expensive());
+
+    Everything compiles away unless TRACING_ENABLE = yes is set in rules.mk.
+*/
+
+/**
+ * @brief Span identifiers, up to 127 of them. The core ones are instrumented in keyboard_task(), user code may use
+ * TRACE_USER and up.
+ */
+enum {
+    TRACE_KEYBOARD_TASK,
+    TRACE_MATRIX_TASK,
+    TRACE_QUANTUM_TASK,
+    TRACE_SPLIT_TRANSACTIONS,
+    TRACE_LED_MATRIX_TASK,
+    TRACE_RGB_MATRIX_TASK,
+    TRACE_RGBLIGHT_TASK,
+    TRACE_ENCODER_TASK,
+    TRACE_POINTING_DEVICE_TASK,
+    TRACE_OLED_TASK,
+    TRACE_BACKLIGHT_TASK,
+    TRACE_ST7565_TASK,
+    TRACE_MOUSEKEY_TASK,
+    TRACE_PS2_MOUSE_TASK,
+    TRACE_MIDI_TASK,
+    TRACE_JOYSTICK_TASK,
+    TRACE_BLUETOOTH_TASK,
+    TRACE_HAPTIC_TASK,
+    TRACE_LED_TASK,
+    TRACE_OS_DETECTION_TASK,
+    TRACE_PAINTER_TASK,
+    TRACE_SEND_STRING_TASK,
+    TRACE_USER = 0x40,
+    TRACE_DROPPED = 0x7F, // Emitted when drained after records were lost, the timestamp holds the number lost
+};
+
+/**
+ * @brief Size in bytes of a serialised record: a byte holding the span identifier, with the top bit set for the
+ * beginning of a span, followed by the little-endian 32-bit timestamp.
+ */
+#define TRACE_RECORD_SIZE 5
+#define TRACE_RECORD_BEGIN 0x80
+
+#ifdef TRACING_ENABLE
+
+/**
+ * @brief The current timestamp: timer 0 ticks (F_CPU / TIMER_PRESCALER) on AVR, the realtime counter (usually the CPU
+ * cycle counter) on ChibiOS ports that have one, system ticks (CH_CFG_ST_FREQUENCY) on those that don't, milliseconds
+ * elsewhere. May be overridden by the keyboard.
+ */
+uint32_t tracing_timestamp(void);
+
+/**
+ * @brief Records the beginning or the end of a span. Lock-free, single producer: only call from the main loop.
+ */
+void tracing_record(uint8_t id, bool begin);
+
+/**
+ * @brief Serialises as many whole records as fit into the buffer, removing them from the ring buffer.
+ *
+ * @return the number of bytes written, a multiple of TRACE_RECORD_SIZE
+ */
+uint8_t tracing_read(uint8_t *data, uint8_t length);
+
+/**
+ * @brief Discards all recorded spans.
+ */
+void tracing_clear(void);
+
+/**
+ * @brief Drains the recorded spans over console, if enabled. Called from the main loop.
+ */
+void tracing_task(void);
+
+#    define TRACE_BEGIN(id) tracing_record((id), true)
+#    define TRACE_END(id) tracing_record((id), false)
+#    define TRACE_SPAN(id, call) \
+        do {                     \
+            TRACE_BEGIN(id);     \
+            call;                \
+            TRACE_END(id);       \
+        } while (0)
+
+#else // TRACING_ENABLE
+
+#    define TRACE_BEGIN(id) \
+        do {                \
+        } while (0)
+#    define TRACE_END(id) \
+        do {              \
+        } while (0)
+#    define TRACE_SPAN(id, call) \
+        do {                     \
+            call;                \
+        } while (0)
+
+#endif // TRACING_ENABLE
@@ -63,4 +63,23 @@ wear_leveling_8byte_SRC := \
 	$(wear_leveling_common_SRC) \
 	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_8byte.cpp
 wear_leveling_8byte_INC := \
-	$(wear_leveling_common_INC)
\ No newline at end of file
+	$(wear_leveling_common_INC)
+wear_leveling_bulk_DEFS := \
+	$(wear_leveling_common_DEFS) \
+	-DBACKING_STORE_WRITE_SIZE=2 \
+	-DWEAR_LEVELING_BACKING_SIZE=8192 \
+	-DWEAR_LEVELING_LOGICAL_SIZE=2048
+wear_leveling_bulk_SRC := \
+	$(wear_leveling_common_SRC) \
+	$(QUANTUM_PATH)/wear_leveling/tests/wear_leveling_bulk.cpp
+wear_leveling_bulk_INC := \
+	$(wear_leveling_common_INC)
+
+wear_leveling_bulk_coalesced_DEFS := \
+	$(wear_leveling_bulk_DEFS) \
+	-DWEAR_LEVELING_WRITE_BUFFER_SIZE=64 \
+	-DWEAR_LEVELING_PLAYBACK_CHECKPOINT=1024
+wear_leveling_bulk_coalesced_SRC := \
+	$(wear_leveling_bulk_SRC)
+wear_leveling_bulk_coalesced_INC := \
+	$(wear_leveling_common_INC)
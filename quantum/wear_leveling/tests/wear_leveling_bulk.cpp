@@ -0,0 +1,201 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include <vector>
+#include "gtest/gtest.h"
+#include "gmock/gmock.h"
+#include "backing_mocks.hpp"
+
+// Dynamic keymap of 4 layers of 96 keys, located after the core EEPROM config
+#define KEYMAP_ADDRESS 0x25
+#define KEYMAP_SIZE (4 * 96 * 2)
+// Bytes per VIA set buffer command
+#define VIA_CHUNK_SIZE 28
+
+class WearLevelingBulk : public ::testing::Test {
+   protected:
+    void SetUp() override {
+        MockBackingStore::Instance().reset_instance();
+        wear_leveling_init();
+    }
+};
+
+static std::vector<std::uint8_t> generate_keymap(int seed) {
+    std::vector<std::uint8_t> keymap(KEYMAP_SIZE);
+    for (int key = 0; key < KEYMAP_SIZE / 2; ++key) {
+        // Base layer is fully populated, the others are mostly KC_TRANSPARENT
+        uint16_t keycode = 0x0001;
+        if (key < 96 || (key + seed) % 5 == 0) {
+            keycode = 0x04 + (key * 7 + seed) % 0x61;
+        }
+        // Big endian, as stored by the dynamic keymap
+        keymap[key * 2]     = keycode >> 8;
+        keymap[key * 2 + 1] = keycode & 0xFF;
+    }
+    return keymap;
+}
+
+/**
+ * Uploads a keymap the way the dynamic keymap does, updating the changed bytes one at a time. Each chunk is handled
+ * within one iteration of the main loop, after which the EEPROM driver is flushed.
+ */
+static std::size_t upload_keymap(const std::vector<std::uint8_t>& keymap) {
+    std::size_t changed = 0;
+    for (std::size_t offset = 0; offset < keymap.size(); offset += VIA_CHUNK_SIZE) {
+        for (std::size_t i = offset; i < offset + VIA_CHUNK_SIZE && i < keymap.size(); ++i) {
+            std::uint8_t current;
+            wear_leveling_read(KEYMAP_ADDRESS + i, &current, 1);
+            if (current != keymap[i]) {
+                EXPECT_NE(wear_leveling_write(KEYMAP_ADDRESS + i, &keymap[i], 1), WEAR_LEVELING_FAILED);
+                ++changed;
+            }
+        }
+        EXPECT_NE(wear_leveling_flush(), WEAR_LEVELING_FAILED);
+    }
+    return changed;
+}
+
+static void expect_keymap(const std::vector<std::uint8_t>& keymap) {
+    std::vector<std::uint8_t> stored(keymap.size());
+    EXPECT_EQ(wear_leveling_read(KEYMAP_ADDRESS, stored.data(), stored.size()), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(stored, keymap);
+}
+
+// Number of bytes in use in the write log
+static std::size_t write_log_bytes() {
+    auto& inst  = MockBackingStore::Instance();
+    auto  start = inst.storage_begin() + ((WEAR_LEVELING_LOGICAL_SIZE + 8) / BACKING_STORE_WRITE_SIZE);
+    return std::count_if(start, inst.storage_end(), [](const MockBackingStoreElement& e) { return !e.is_erased(); }) * BACKING_STORE_WRITE_SIZE;
+}
+
+/**
+ * This test checks how much of the backing store a VIA keymap upload uses up, per logical byte changed.
+ */
+TEST_F(WearLevelingBulk, KeymapUploadWritesPerByte) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::size_t changed = 0;
+    for (int seed = 0; seed < 8; ++seed) {
+        auto keymap = generate_keymap(seed);
+        changed += upload_keymap(keymap);
+        expect_keymap(keymap);
+    }
+
+    double ratio = (double)(inst.total_write_count() * BACKING_STORE_WRITE_SIZE) / changed;
+
+    // The data survives a restart
+    auto keymap = generate_keymap(7);
+    wear_leveling_init();
+    expect_keymap(keymap);
+
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    // Unmerged, every changed byte takes a 4 byte write log entry, plus its share of the consolidations
+    EXPECT_LT(ratio, 3.5);
+#else
+    EXPECT_GE(ratio, 4.0);
+#endif
+}
+
+/**
+ * This test checks how much write log has to be played back when starting up after keymap uploads.
+ */
+TEST_F(WearLevelingBulk, StartupPlayback) {
+    std::size_t max_log_bytes = 0;
+    for (int seed = 0; seed < 8; ++seed) {
+        auto keymap = generate_keymap(seed);
+        upload_keymap(keymap);
+
+        max_log_bytes = std::max(max_log_bytes, write_log_bytes());
+        EXPECT_NE(wear_leveling_init(), WEAR_LEVELING_FAILED);
+        expect_keymap(keymap);
+    }
+
+#ifdef WEAR_LEVELING_PLAYBACK_CHECKPOINT
+    // A checkpoint is taken once playback passes the limit, subsequent uploads only add a single upload's worth
+    EXPECT_LE(max_log_bytes, (std::size_t)(WEAR_LEVELING_PLAYBACK_CHECKPOINT + KEYMAP_SIZE * 2));
+#endif
+}
+
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+/**
+ * This test verifies that adjacent writes are merged into a single write log entry, and are readable before flushing.
+ */
+TEST_F(WearLevelingBulk, AdjacentWritesAreMerged) {
+    auto& inst   = MockBackingStore::Instance();
+    auto  writes = inst.write_invoke_count();
+
+    uint8_t values[] = {0x11, 0x22, 0x33};
+    EXPECT_EQ(wear_leveling_write(0x101, &values[1], 1), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_write(0x102, &values[2], 1), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_write(0x100, &values[0], 1), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.write_invoke_count(), writes) << "Writes should be held back";
+
+    uint8_t readback[3];
+    wear_leveling_read(0x100, readback, sizeof(readback));
+    EXPECT_EQ(memcmp(readback, values, sizeof(values)), 0);
+
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS);
+    // One multi-byte entry of 3 bytes
+    EXPECT_EQ(inst.write_invoke_count() - writes, 3);
+    EXPECT_EQ(wear_leveling_flush(), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(inst.write_invoke_count() - writes, 3) << "Nothing left to flush";
+
+    wear_leveling_init();
+    wear_leveling_read(0x100, readback, sizeof(readback));
+    EXPECT_EQ(memcmp(readback, values, sizeof(values)), 0);
+}
+
+/**
+ * This test verifies that a write elsewhere flushes the pending data first.
+ */
+TEST_F(WearLevelingBulk, DistantWriteFlushesPending) {
+    auto& inst   = MockBackingStore::Instance();
+    auto  writes = inst.write_invoke_count();
+
+    uint8_t value = 0x55;
+    EXPECT_EQ(wear_leveling_write(0x100, &value, 1), WEAR_LEVELING_SUCCESS);
+    EXPECT_EQ(wear_leveling_write(0x110, &value, 1), WEAR_LEVELING_SUCCESS);
+    // One multi-byte entry of 1 byte
+    EXPECT_EQ(inst.write_invoke_count() - writes, 2);
+
+    // Small gaps are rewritten from the cache rather than starting a new entry
+    EXPECT_EQ(wear_leveling_write(0x113, &value, 1), WEAR_LEVELING_SUCCESS);
+    wear_leveling_flush();
+    // One multi-byte entry of 4 bytes
+    EXPECT_EQ(inst.write_invoke_count() - writes, 6);
+
+    wear_leveling_init();
+    uint8_t readback[0x14];
+    wear_leveling_read(0x100, readback, sizeof(readback));
+    for (std::size_t i = 0; i < sizeof(readback); ++i) {
+        EXPECT_EQ(readback[i], (i == 0x00 || i == 0x10 || i == 0x13) ? 0x55 : 0x00) << "Invalid readback at " << i;
+    }
+}
+
+/**
+ * This test verifies that only the changed bytes of a block are written, and blocks larger than the buffer are written
+ * straight away.
+ */
+TEST_F(WearLevelingBulk, OnlyChangedBytesAreWritten) {
+    auto& inst = MockBackingStore::Instance();
+
+    std::array<std::uint8_t, WEAR_LEVELING_WRITE_BUFFER_SIZE * 2> block{};
+    block[10] = 0x10;
+    block[11] = 0x20;
+
+    auto writes = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_write(0x200, block.data(), block.size()), WEAR_LEVELING_SUCCESS);
+    wear_leveling_flush();
+    // One multi-byte entry of 2 bytes
+    EXPECT_EQ(inst.write_invoke_count() - writes, 3);
+
+    block.fill(0x42);
+    writes = inst.write_invoke_count();
+    EXPECT_EQ(wear_leveling_write(0x200, block.data(), block.size()), WEAR_LEVELING_SUCCESS);
+    EXPECT_GT(inst.write_invoke_count(), writes) << "Oversized writes should not be held back";
+
+    wear_leveling_init();
+    std::array<std::uint8_t, WEAR_LEVELING_WRITE_BUFFER_SIZE * 2> readback;
+    wear_leveling_read(0x200, readback.data(), readback.size());
+    EXPECT_EQ(readback, block);
+}
+#endif // WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
@@ -76,6 +76,18 @@
             * A new write log entry is appended to the log.
             * If the log's full, data is consolidated and the write log cleared.
 
+        With write coalescing (WEAR_LEVELING_WRITE_BUFFER_SIZE > 0):
+            * Only the changed bytes of a write are considered.
+            * Writes overlapping or close to the pending range are merged
+                into it, and only reach the write log when a write elsewhere
+                comes in, the range would grow past the buffer size, or
+                wear_leveling_flush() is called.
+
+        With a playback checkpoint (WEAR_LEVELING_PLAYBACK_CHECKPOINT):
+            * If more than that many bytes of write log were played back during
+                initialization, data is consolidated so the next startup
+                starts from the consolidated data alone.
+
     Write log structure:
 
         The first 8 bytes of the write log are a FNV1a_64 hash of the contents
@@ -155,6 +167,27 @@
         ╚════════════════╝
         0 <= Address <= 0x3FFE (16382) */
 
+/**
+ * Maximum number of bytes held back in the cache while further adjacent writes are merged into them. 0 disables
+ * write coalescing, writing everything to the log straight away.
+ */
+#ifndef WEAR_LEVELING_WRITE_BUFFER_SIZE
+#    define WEAR_LEVELING_WRITE_BUFFER_SIZE 0
+#endif
+
+/**
+ * Maximum number of unchanged bytes between two writes for them to still be merged -- rewriting a couple of unchanged
+ * bytes takes less of the write log than the header of a separate entry.
+ */
+#define WEAR_LEVELING_WRITE_BUFFER_GAP 2
+
+/**
+ * Number of backing store values fetched at a time when playing back the write log.
+ */
+#ifndef WEAR_LEVELING_PLAYBACK_READ_COUNT
+#    define WEAR_LEVELING_PLAYBACK_READ_COUNT 16
+#endif
+
 /**
  * Storage area for the wear-leveling cache.
  */
@@ -162,6 +195,10 @@ static struct __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) {
     __attribute__((__aligned__(BACKING_STORE_WRITE_SIZE))) uint8_t cache[(WEAR_LEVELING_LOGICAL_SIZE)];
     uint32_t                                                       write_address;
     bool                                                           unlocked;
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    uint32_t pending_address;
+    uint32_t pending_length;
+#endif
 } wear_leveling;
 
 /**
@@ -203,6 +240,9 @@ static inline backing_store_lock_status_t wear_leveling_lock(void) {
 static void wear_leveling_clear_cache(void) {
     memset(wear_leveling.cache, 0, (WEAR_LEVELING_LOGICAL_SIZE));
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 is due to the FNV1a_64 of the consolidated buffer
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    wear_leveling.pending_length = 0;
+#endif
 }
 
 /**
@@ -318,6 +358,11 @@ static wear_leveling_status_t wear_leveling_consolidate_force(void) {
     // Next write of the log occurs after the consolidated values at the start of the backing store.
     wear_leveling.write_address = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
 
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    // Any pending data is now part of the consolidated area
+    wear_leveling.pending_length = 0;
+#endif
+
     return status;
 }
 
@@ -469,18 +514,53 @@ static wear_leveling_status_t wear_leveling_write_raw(uint32_t address, const vo
     return status;
 }
 
+/**
+ * Read-ahead buffer used while playing back the write log, so that the log is fetched from the backing store in bulk.
+ */
+typedef struct wear_leveling_log_reader_t {
+    backing_store_int_t values[WEAR_LEVELING_PLAYBACK_READ_COUNT];
+    uint32_t            address; // Backing store address of values[0]
+    size_t              count;   // Number of values currently held
+} wear_leveling_log_reader_t;
+
+/**
+ * Reads a single value of the write log through the read-ahead buffer.
+ */
+static bool wear_leveling_read_log(wear_leveling_log_reader_t *reader, uint32_t address, backing_store_int_t *value) {
+    if (address >= (WEAR_LEVELING_BACKING_SIZE)) {
+        return false;
+    }
+
+    if (address < reader->address || address >= reader->address + (reader->count * (BACKING_STORE_WRITE_SIZE))) {
+        size_t count = ((WEAR_LEVELING_BACKING_SIZE) - address) / (BACKING_STORE_WRITE_SIZE);
+        if (count > (WEAR_LEVELING_PLAYBACK_READ_COUNT)) {
+            count = (WEAR_LEVELING_PLAYBACK_READ_COUNT);
+        }
+        if (!backing_store_read_bulk(address, reader->values, count)) {
+            reader->count = 0;
+            return false;
+        }
+        reader->address = address;
+        reader->count   = count;
+    }
+
+    *value = reader->values[(address - reader->address) / (BACKING_STORE_WRITE_SIZE)];
+    return true;
+}
+
 /**
  * "Replays" the write log from the backing store, updating the local cache with updated values.
  */
 static wear_leveling_status_t wear_leveling_playback_log(void) {
     wl_dprintf("Playback write log\n");
 
-    wear_leveling_status_t status          = WEAR_LEVELING_SUCCESS;
-    bool                   cancel_playback = false;
-    uint32_t               address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling_status_t     status          = WEAR_LEVELING_SUCCESS;
+    bool                       cancel_playback = false;
+    uint32_t                   address         = (WEAR_LEVELING_LOGICAL_SIZE) + 8; // +8 due to the FNV1a_64 of the consolidated area
+    wear_leveling_log_reader_t reader          = {.count = 0};
     while (!cancel_playback && address < (WEAR_LEVELING_BACKING_SIZE)) {
         backing_store_int_t value;
-        bool                ok = backing_store_read(address, &value);
+        bool                ok = wear_leveling_read_log(&reader, address, &value);
         if (!ok) {
             wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
             cancel_playback = true;
@@ -509,7 +589,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
         switch (LOG_ENTRY_GET_TYPE(log)) {
             case LOG_ENTRY_TYPE_MULTIBYTE: {
 #if BACKING_STORE_WRITE_SIZE == 2
-                ok = backing_store_read(address, &log.raw16[1]);
+                ok = wear_leveling_read_log(&reader, address, &log.raw16[1]);
                 if (!ok) {
                     wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                     cancel_playback = true;
@@ -529,7 +609,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
 
 #if BACKING_STORE_WRITE_SIZE == 2
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw16[2]);
+                    ok = wear_leveling_read_log(&reader, address, &log.raw16[2]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -539,7 +619,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                     address += (BACKING_STORE_WRITE_SIZE);
                 }
                 if (l > 3) {
-                    ok = backing_store_read(address, &log.raw16[3]);
+                    ok = wear_leveling_read_log(&reader, address, &log.raw16[3]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -550,7 +630,7 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
                 }
 #elif BACKING_STORE_WRITE_SIZE == 4
                 if (l > 1) {
-                    ok = backing_store_read(address, &log.raw32[1]);
+                    ok = wear_leveling_read_log(&reader, address, &log.raw32[1]);
                     if (!ok) {
                         wl_dprintf("Failed to load from backing store, skipping playback of write log\n");
                         cancel_playback = true;
@@ -603,6 +683,12 @@ static wear_leveling_status_t wear_leveling_playback_log(void) {
     if (status == WEAR_LEVELING_FAILED) {
         // If we had a failure during readback, assume we're corrupted -- force a consolidation with the data we already have
         status = wear_leveling_consolidate_force();
+#ifdef WEAR_LEVELING_PLAYBACK_CHECKPOINT
+    } else if (address - ((WEAR_LEVELING_LOGICAL_SIZE) + 8) > (WEAR_LEVELING_PLAYBACK_CHECKPOINT)) {
+        // Checkpoint the played back data into the consolidated area, so the next startup does not replay this log again
+        wl_dprintf("Write log exceeds playback checkpoint, consolidating\n");
+        status = wear_leveling_consolidate_force();
+#endif // WEAR_LEVELING_PLAYBACK_CHECKPOINT
     } else {
         // Consolidate the cache + write log if required
         status = wear_leveling_consolidate_if_needed();
@@ -672,25 +758,9 @@ wear_leveling_status_t wear_leveling_erase(void) {
 }
 
 /**
- * Writes logical data into the backing store. Skips writes if there are no changes to values.
+ * Appends the cached data within the supplied range to the write log, unlocking the backing store as required.
  */
-wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *value, size_t length) {
-    wl_assert(address + length <= (WEAR_LEVELING_LOGICAL_SIZE));
-    if (address + length > (WEAR_LEVELING_LOGICAL_SIZE)) {
-        return WEAR_LEVELING_FAILED;
-    }
-
-    wl_dprintf("Write ");
-    wl_dump(address, value, length);
-
-    // Skip write if there's no change compared to the current cached value
-    if (memcmp(value, &wear_leveling.cache[address], length) == 0) {
-        return true;
-    }
-
-    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
-    memcpy(&wear_leveling.cache[address], value, length);
-
+static wear_leveling_status_t wear_leveling_write_log(const uint32_t address, size_t length) {
     // Unlock the backing store
     backing_store_lock_status_t lock_status = wear_leveling_unlock();
     if (lock_status == STATUS_FAILURE) {
@@ -699,7 +769,7 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     }
 
     // Perform the actual write
-    wear_leveling_status_t status = wear_leveling_write_raw(address, value, length);
+    wear_leveling_status_t status = wear_leveling_write_raw(address, &wear_leveling.cache[address], length);
     switch (status) {
         case WEAR_LEVELING_CONSOLIDATED:
         case WEAR_LEVELING_FAILED:
@@ -726,6 +796,97 @@ wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *v
     return status;
 }
 
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+/**
+ * Merges already cached data into the pending range, flushing the pending range first if the two cannot be merged.
+ */
+static wear_leveling_status_t wear_leveling_write_buffered(const uint32_t address, size_t length) {
+    const uint32_t end = address + (uint32_t)length;
+    if (wear_leveling.pending_length > 0) {
+        const uint32_t pending_end = wear_leveling.pending_address + wear_leveling.pending_length;
+        const uint32_t merged      = address < wear_leveling.pending_address ? address : wear_leveling.pending_address;
+        const uint32_t merged_end  = end > pending_end ? end : pending_end;
+
+        // Overlapping or nearby writes are merged, as long as the result fits into the buffer
+        if (address <= pending_end + (WEAR_LEVELING_WRITE_BUFFER_GAP) && end + (WEAR_LEVELING_WRITE_BUFFER_GAP) >= wear_leveling.pending_address && merged_end - merged <= (WEAR_LEVELING_WRITE_BUFFER_SIZE)) {
+            wear_leveling.pending_address = merged;
+            wear_leveling.pending_length  = merged_end - merged;
+            return WEAR_LEVELING_SUCCESS;
+        }
+
+        // If consolidation occurred then the new data, already in the cache, has been written as well
+        wear_leveling_status_t status = wear_leveling_flush();
+        if (status != WEAR_LEVELING_SUCCESS) {
+            return status;
+        }
+    }
+
+    if (length > (WEAR_LEVELING_WRITE_BUFFER_SIZE)) {
+        return wear_leveling_write_log(address, length);
+    }
+
+    wear_leveling.pending_address = address;
+    wear_leveling.pending_length  = (uint32_t)length;
+    return WEAR_LEVELING_SUCCESS;
+}
+#endif // WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+
+/**
+ * Writes logical data into the backing store. Skips writes if there are no changes to values.
+ */
+wear_leveling_status_t wear_leveling_write(const uint32_t address, const void *value, size_t length) {
+    wl_assert(address + length <= (WEAR_LEVELING_LOGICAL_SIZE));
+    if (address + length > (WEAR_LEVELING_LOGICAL_SIZE)) {
+        return WEAR_LEVELING_FAILED;
+    }
+
+    wl_dprintf("Write ");
+    wl_dump(address, value, length);
+
+    // Skip write if there's no change compared to the current cached value
+    if (memcmp(value, &wear_leveling.cache[address], length) == 0) {
+        return true;
+    }
+
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    // Only the changed part of the block needs to reach the write log -- there is at least one changed byte
+    const uint8_t *p     = value;
+    uint32_t       start = address;
+    while (p[start - address] == wear_leveling.cache[start]) {
+        ++start;
+    }
+    uint32_t end = address + (uint32_t)length;
+    while (p[end - 1 - address] == wear_leveling.cache[end - 1]) {
+        --end;
+    }
+
+    memcpy(&wear_leveling.cache[start], &p[start - address], end - start);
+    return wear_leveling_write_buffered(start, end - start);
+#else
+    // Update the cache before writing to the backing store -- if we hit the end of the backing store during writes to the log then we'll force a consolidation in-line
+    memcpy(&wear_leveling.cache[address], value, length);
+    return wear_leveling_write_log(address, length);
+#endif
+}
+
+/**
+ * Writes any data held back by write coalescing to the write log.
+ */
+wear_leveling_status_t wear_leveling_flush(void) {
+#if WEAR_LEVELING_WRITE_BUFFER_SIZE > 0
+    if (wear_leveling.pending_length == 0) {
+        return WEAR_LEVELING_SUCCESS;
+    }
+
+    const uint32_t address       = wear_leveling.pending_address;
+    const uint32_t length        = wear_leveling.pending_length;
+    wear_leveling.pending_length = 0;
+    return wear_leveling_write_log(address, length);
+#else
+    return WEAR_LEVELING_SUCCESS;
+#endif
+}
+
 /**
  * Reads logical data from the cache.
  */
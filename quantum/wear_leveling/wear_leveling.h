@@ -36,6 +36,9 @@ wear_leveling_status_t wear_leveling_erase(void);
  * determine if an overwrite should occur -- if there is any data mismatch the entire block will be written to the log,
  * not just the changed bytes.
  *
+ * With WEAR_LEVELING_WRITE_BUFFER_SIZE set, only the changed bytes are written, and they may be held back to be merged
+ * with following writes until wear_leveling_flush() is invoked.
+ *
  * @param address[in] the logical address to write data
  * @param value[in] pointer to the source buffer
  * @param length[in] length of the data
@@ -43,6 +46,13 @@ wear_leveling_status_t wear_leveling_erase(void);
  */
 wear_leveling_status_t wear_leveling_write(uint32_t address, const void* value, size_t length);
 
+/**
+ * Writes any data held back for write coalescing into the backing store.
+ *
+ * @return Status of the request
+ */
+wear_leveling_status_t wear_leveling_flush(void);
+
 /**
  * Reads logical data from the cache.
  *
@@ -0,0 +1,70 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "keycode.h"
+#include "test_common.hpp"
+#include "typing_corpus.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using ::testing::_;
+using ::testing::AnyNumber;
+
+/* Number of times the corpus is typed, to even out the noise of the host. */
+#define CORPUS_PASSES 50
+
+class AutoCorrectBenchmark : public TestFixture {
+   public:
+    void SetUp() override {
+        autocorrect_enable();
+    }
+};
+
+/**
+ * Measures the cost of autocorrect for each keypress of a typing corpus. Set AUTOCORRECT_CORPUS to the path of a
+ * text file to type it instead of the built-in one, and drop a generated autocorrect_data.h next to the tests to
+ * measure a different dictionary.
+ */
+TEST_F(AutoCorrectBenchmark, TypingCorpus) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    const char *path   = std::getenv("AUTOCORRECT_CORPUS");
+    std::string corpus = typing_corpus;
+    if (path) {
+        std::ifstream     file(path);
+        std::stringstream contents;
+        contents << file.rdbuf();
+        corpus = contents.str();
+    }
+    ASSERT_FALSE(corpus.empty());
+
+    std::vector<uint64_t> key_ns;
+    for (int pass = 0; pass < CORPUS_PASSES; pass++) {
+        for (char c : corpus) {
+            keyrecord_t record   = {};
+            record.event.type    = KEY_EVENT;
+            record.event.pressed = true;
+            uint16_t keycode     = pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)c & 0x7F]);
+
+            auto start = std::chrono::steady_clock::now();
+            process_autocorrect(keycode, &record);
+            key_ns.push_back(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count());
+        }
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    std::sort(key_ns.begin(), key_ns.end());
+    std::cout << "[ BENCH    ] autocorrect: " << key_ns.size() << " keys, p50 " << key_ns[key_ns.size() / 2] << " ns, p99 " << key_ns[key_ns.size() * 99 / 100] << " ns, max " << key_ns.back() << " ns per key" << std::endl;
+}
@@ -1,18 +1,47 @@
 // Copyright 2021 Christopher Courtney, aka Drashna Jael're  (@drashna) <drashna@live.com>
 // SPDX-License-Identifier: GPL-2.0-or-later
 
+#include <iterator>
+#include <string>
+#include <vector>
+
 #include "keycode.h"
 #include "test_common.hpp"
+#include "typing_corpus.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
 
 using ::testing::_;
 using ::testing::AnyNumber;
 using ::testing::InSequence;
 
+/* Corrections applied since the start of the test, as "typo -> correct". */
+static std::vector<std::string> corrections;
+
+extern "C" bool apply_autocorrect(uint8_t backspaces, const char *str, char *typo, char *correct) {
+    corrections.push_back(std::string(typo) + " -> " + correct);
+    return true;
+}
+
 class AutoCorrect : public TestFixture {
    public:
     void SetUp() override {
         autocorrect_enable();
+        corrections.clear();
     }
+
+    // Feeds each character of `text` to autocorrect as a keypress.
+    void TypeText(const std::string &text) {
+        for (char c : text) {
+            keyrecord_t record   = {};
+            record.event.type    = KEY_EVENT;
+            record.event.pressed = true;
+            process_autocorrect(pgm_read_byte(&ascii_to_keycode_lut[(uint8_t)c & 0x7F]), &record);
+        }
+    }
+
     // Convenience function to tap `key`.
     void TapKey(KeymapKey key) {
         key.press();
@@ -202,3 +231,32 @@ TEST_F(AutoCorrect, overture_should_not_autocorrect) {
 
     VERIFY_AND_CLEAR(driver);
 }
+
+// Test that typos are found after the typo buffer has wrapped around, including backspaces over the wrap point
+TEST_F(AutoCorrect, typo_buffer_wraps_around) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeText("xyzxyzxyzfalet\bs");
+    TypeText("qwertyuiop thier ");
+    TypeText("abcdefgh\b\b\b\b\b\b\b\b\bcheif");
+
+    // Without a space, the whole buffer is taken as the typo'd word
+    std::vector<std::string> expected = {"yzxyzfales -> yzxyzfalse", "thier -> their", "cheif -> chief"};
+    EXPECT_EQ(corrections, expected);
+
+    VERIFY_AND_CLEAR(driver);
+}
+
+// Test that each typo of the typing corpus is corrected, and nothing else
+TEST_F(AutoCorrect, TypingCorpus) {
+    TestDriver driver;
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+
+    TypeText(typing_corpus);
+
+    std::vector<std::string> expected(std::begin(corpus_corrections), std::end(corpus_corrections));
+    EXPECT_EQ(corrections, expected);
+
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,13 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+/* Holds one of each of the typos from the default dictionary marked below, the rest should be left alone. '\b' is a
+ * backspace. */
+static const char *const typing_corpus =
+    "typing along at a steady pace, the cheif engineer checks thier keyboard firmware. "
+    "it is ture that a fales alarm can happen becuase of the lenght of a word. "
+    "the heirarchy of every key is hard to feel but easy to measure; look at the numbers. "
+    "some words roll: fades, joked, period, radio, and a word gets deleted\b\b\b\b\b\b\bremoved.\n";
+static const char *const corpus_corrections[] = {"cheif -> chief", "thier -> their", "ture -> true", "fales -> false", "becuase -> because", "lenght -> length", "heirarchy -> hierarchy"};
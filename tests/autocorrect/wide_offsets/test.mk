@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# The default dictionary, generated with 32-bit node links (--wide-offsets)
+# --------------------------------------------------------------------------------
+
+AUTOCORRECT_ENABLE = yes
+
+TEST_SRC += ../test_autocorrect.cpp ../benchmark_autocorrect.cpp
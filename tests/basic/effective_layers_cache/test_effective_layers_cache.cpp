@@ -0,0 +1,132 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+using testing::_;
+using testing::InSequence;
+
+extern "C" {
+#include "action_layer.h"
+}
+
+/* Every test brings its own keymap, so start each one with an empty cache */
+class ClearEffectiveLayersCache : public testing::EmptyTestEventListener {
+    void OnTestStart(const testing::TestInfo &test_info) override {
+        clear_effective_layers_cache();
+    }
+};
+
+static const bool clear_cache_registered = [] {
+    testing::UnitTest::GetInstance()->listeners().Append(new ClearEffectiveLayersCache);
+    return true;
+}();
+
+class EffectiveLayersCache : public TestFixture {};
+
+TEST_F(EffectiveLayersCache, FollowsLayerStateChanges) {
+    TestDriver driver;
+    KeymapKey  key_a_0(0, 0, 0, KC_A);
+    KeymapKey  key_b_0(0, 1, 0, KC_B);
+    KeymapKey  key_a_1(1, 0, 0, KC_TRNS);
+    KeymapKey  key_b_1(1, 1, 0, KC_C);
+    KeymapKey  key_a_2(2, 0, 0, KC_D);
+    KeymapKey  key_b_2(2, 1, 0, KC_TRNS);
+
+    set_keymap({key_a_0, key_b_0, key_a_1, key_b_1, key_a_2, key_b_2});
+
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 0);
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 1);
+
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 2);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 1);
+
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 2);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 0);
+
+    /* Direct assignments bypass layer_state_set(), as done on split halves */
+    layer_state = 0;
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 0);
+
+    default_layer_state = (layer_state_t)1 << 1;
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 0);
+    EXPECT_EQ(layer_switch_get_layer(key_b_0.position), 1);
+
+    default_layer_set((layer_state_t)1 << 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveLayersCache, FollowsKeymapChanges) {
+    TestDriver driver;
+    KeymapKey  key_a_0(0, 0, 0, KC_A);
+    KeymapKey  key_a_1(1, 0, 0, KC_TRNS);
+    KeymapKey  key_b_1(1, 0, 0, KC_B);
+
+    set_keymap({key_a_0, key_a_1});
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 0);
+
+    set_keymap({key_a_0, key_b_1});
+    clear_effective_layers_cache();
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 1);
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_b_1);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveLayersCache, ReleaseUsesSourceLayer) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_a_0(0, 0, 0, KC_A);
+    KeymapKey  key_a_1(1, 0, 0, KC_B);
+
+    set_keymap({key_a_0, key_a_1});
+
+    /* Press on layer 0, release after the cached layer changed */
+    EXPECT_REPORT(driver, (KC_A));
+    key_a_0.press();
+    run_one_scan_loop();
+
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_layer(key_a_0.position), 1);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a_0.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(EffectiveLayersCache, KeepsKeysOfUnchangedLayers) {
+    TestDriver driver;
+    KeymapKey  key_a_0(0, 0, 0, KC_A);
+    KeymapKey  key_b_0(0, 0, 0, KC_B);
+    KeymapKey  key_c_1(1, 0, 0, KC_C);
+    KeymapKey  key_trns_2(2, 0, 0, KC_TRNS);
+
+    set_keymap({key_a_0, key_trns_2});
+    layer_on(2);
+    EXPECT_EQ(layer_switch_get_keycode(key_a_0.position, NULL), KC_A);
+
+    /* Without clearing the cache the keycode resolved before is served for as
+     * long as the layers above and at the resolved layer stay the same */
+    set_keymap({key_b_0, key_c_1, key_trns_2});
+    layer_off(2);
+    EXPECT_EQ(layer_switch_get_keycode(key_a_0.position, NULL), KC_A);
+
+    /* Turning on a layer above the resolved one resolves the key again */
+    layer_on(1);
+    EXPECT_EQ(layer_switch_get_keycode(key_a_0.position, NULL), KC_C);
+    layer_off(1);
+    EXPECT_EQ(layer_switch_get_keycode(key_a_0.position, NULL), KC_B);
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,9 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_combos.c
+
+# Same behaviour as the linear combo search, run against the keycode index
+TEST_SRC += ../test_many_combos.cpp
@@ -0,0 +1,108 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <array>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+extern "C" {
+#include "keymap_introspection.h"
+#include "process_combo.h"
+}
+#include "quantum.h"
+#include "keycode.h"
+#include "test_common.h"
+#include "test_driver.hpp"
+#include "test_fixture.hpp"
+#include "test_keymap_key.hpp"
+
+using testing::_;
+
+/* Two key combos over keycodes the keymap doesn't use, served after the
+ * keymap's own combos through the weak combo_count()/combo_get() hooks. */
+static std::vector<std::array<uint16_t, 3>> generated_keys;
+static std::vector<combo_t>                 generated_combos;
+static uint16_t                             generated_count = 0;
+
+extern "C" uint16_t combo_count(void) {
+    return combo_count_raw() + generated_count;
+}
+
+extern "C" combo_t *combo_get(uint16_t combo_idx) {
+    if (combo_idx < combo_count_raw()) {
+        return combo_get_raw(combo_idx);
+    }
+    return &generated_combos[combo_idx - combo_count_raw()];
+}
+
+static void generate_combos(uint16_t count) {
+    static const uint16_t pool[] = {KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12, KC_F13, KC_F14, KC_F15, KC_F16, KC_F17, KC_F18, KC_F19, KC_F20, KC_F21, KC_F22, KC_F23, KC_F24, KC_KP_1, KC_KP_2, KC_KP_3, KC_KP_4, KC_KP_5, KC_KP_6, KC_KP_7, KC_KP_8, KC_KP_9, KC_KP_0};
+    const size_t          pool_size = sizeof(pool) / sizeof(pool[0]);
+
+    generated_keys.clear();
+    for (size_t first = 0; first < pool_size && generated_keys.size() < count; first++) {
+        for (size_t second = first + 1; second < pool_size && generated_keys.size() < count; second++) {
+            generated_keys.push_back({pool[first], pool[second], COMBO_END});
+        }
+    }
+
+    generated_combos.clear();
+    for (auto &keys : generated_keys) {
+        generated_combos.push_back((combo_t)COMBO(keys, KC_B));
+    }
+
+    generated_count = generated_combos.size();
+    combo_rebuild_index();
+}
+
+class ManyCombos : public TestFixture {
+   protected:
+    void TearDown() override {
+        generate_combos(0);
+    }
+};
+
+TEST_F(ManyCombos, combo_modtest_tapped_with_many_combos) {
+    TestDriver driver;
+    KeymapKey  key_y(0, 0, 1, KC_Y);
+    KeymapKey  key_u(0, 0, 2, KC_U);
+    set_keymap({key_y, key_u});
+    generate_combos(320);
+
+    EXPECT_REPORT(driver, (KC_SPACE));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_y, key_u});
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ManyCombos, combo_osmshift_tapped_with_many_combos) {
+    TestDriver driver;
+    KeymapKey  key_z(0, 0, 1, KC_Z);
+    KeymapKey  key_x(0, 0, 2, KC_X);
+    KeymapKey  key_i(0, 0, 3, KC_I);
+    set_keymap({key_z, key_x, key_i});
+    generate_combos(320);
+
+    EXPECT_NO_REPORT(driver);
+    tap_combo({key_z, key_x});
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_I, KC_LEFT_SHIFT));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_key(key_i);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ManyCombos, generated_combo_tapped) {
+    TestDriver driver;
+    KeymapKey  key_f1(0, 0, 1, KC_F1);
+    KeymapKey  key_kp_0(0, 0, 2, KC_KP_0);
+    set_keymap({key_f1, key_kp_0});
+    generate_combos(320);
+
+    // KC_F1 + KC_KP_0 is the 33rd generated combo
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    tap_combo({key_f1, key_kp_0});
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,285 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <algorithm>
+#include <vector>
+
+extern "C" {
+#include "deferred_exec.h"
+
+void set_time(uint32_t t);
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+#define TABLE_SIZE 32
+
+struct invocation {
+    uintptr_t id;
+    uint32_t  trigger_time;
+    uint32_t  time;
+};
+
+static std::vector<invocation> invocations;
+static uint32_t                repeat_delay = 0;
+
+static uint32_t record_callback(uint32_t trigger_time, void *cb_arg) {
+    invocations.push_back({(uintptr_t)cb_arg, trigger_time, timer_read32()});
+    return repeat_delay;
+}
+
+class DeferredExec : public TestFixture {
+   protected:
+    deferred_executor_t table[TABLE_SIZE] = {};
+    uint32_t            last_execution    = 0;
+
+    void SetUp() override {
+        invocations.clear();
+        repeat_delay = 0;
+    }
+
+    void start_at(uint32_t time) {
+        set_time(time);
+        last_execution = time - 1;
+    }
+
+    deferred_token defer(uint32_t delay_ms, uintptr_t id) {
+        return defer_exec_advanced(table, TABLE_SIZE, delay_ms, record_callback, (void *)id);
+    }
+
+    void run_for(uint32_t ms) {
+        for (uint32_t i = 0; i < ms; i++) {
+            advance_time(1);
+            deferred_exec_advanced_task(table, TABLE_SIZE, &last_execution);
+        }
+    }
+};
+
+TEST_F(DeferredExec, RunsInOrderOfTriggerTime) {
+    start_at(0);
+
+    // Queued in a scrambled order, every delay distinct
+    std::vector<deferred_token> tokens;
+    for (uintptr_t i = 0; i < TABLE_SIZE; i++) {
+        deferred_token token = defer(((i * 7) % TABLE_SIZE) + 1, i);
+        EXPECT_NE(token, INVALID_DEFERRED_TOKEN);
+        EXPECT_EQ(std::find(tokens.begin(), tokens.end(), token), tokens.end());
+        tokens.push_back(token);
+    }
+    EXPECT_EQ(defer(100, 100), INVALID_DEFERRED_TOKEN);
+
+    run_for(TABLE_SIZE + 5);
+    ASSERT_EQ(invocations.size(), TABLE_SIZE);
+    for (size_t i = 0; i < invocations.size(); i++) {
+        EXPECT_EQ(invocations[i].trigger_time, i + 1);
+        EXPECT_EQ(invocations[i].time, i + 1);
+        EXPECT_EQ(((invocations[i].id * 7) % TABLE_SIZE) + 1, i + 1);
+    }
+
+    // Everything ran once and freed its entry
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger_time));
+    for (auto token : tokens) {
+        EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    }
+}
+
+TEST_F(DeferredExec, ExtendAndCancel) {
+    start_at(0);
+
+    deferred_token first  = defer(10, 1);
+    deferred_token second = defer(20, 2);
+    deferred_token third  = defer(30, 3);
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger_time));
+    EXPECT_EQ(trigger_time, 10);
+
+    EXPECT_TRUE(extend_deferred_exec_advanced(table, TABLE_SIZE, first, 25));
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, second));
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, second));
+    EXPECT_FALSE(extend_deferred_exec_advanced(table, TABLE_SIZE, second, 5));
+    ASSERT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger_time));
+    EXPECT_EQ(trigger_time, 25);
+
+    // A freed entry is reused with a new token
+    deferred_token fourth = defer(5, 4);
+    EXPECT_NE(fourth, second);
+    EXPECT_NE(fourth, INVALID_DEFERRED_TOKEN);
+
+    run_for(40);
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].id, 4);
+    EXPECT_EQ(invocations[1].id, 1);
+    EXPECT_EQ(invocations[1].time, 25);
+    EXPECT_EQ(invocations[2].id, 3);
+    EXPECT_FALSE(cancel_deferred_exec_advanced(table, TABLE_SIZE, third));
+}
+
+TEST_F(DeferredExec, RepeatsRelativeToPreviousTrigger) {
+    start_at(0);
+    repeat_delay = 10;
+
+    deferred_token token = defer(10, 1);
+    run_for(9);
+    EXPECT_TRUE(invocations.empty());
+
+    // A late run doesn't push the following ones back
+    advance_time(5);
+    run_for(1);
+    run_for(20);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    run_for(20);
+
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].trigger_time, 10);
+    EXPECT_EQ(invocations[0].time, 15);
+    EXPECT_EQ(invocations[1].trigger_time, 20);
+    EXPECT_EQ(invocations[1].time, 20);
+    EXPECT_EQ(invocations[2].trigger_time, 30);
+    EXPECT_EQ(invocations[2].time, 30);
+}
+
+TEST_F(DeferredExec, FiresOncePerPass) {
+    start_at(0);
+    repeat_delay = 1;
+
+    defer(1, 1);
+    defer(5, 2);
+
+    // Late by several repeats, each executor still fires once per pass and catches up over the next ones
+    advance_time(10);
+    deferred_exec_advanced_task(table, TABLE_SIZE, &last_execution);
+    ASSERT_EQ(invocations.size(), 2);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].trigger_time, 1);
+    EXPECT_EQ(invocations[1].id, 2);
+
+    run_for(1);
+    ASSERT_EQ(invocations.size(), 4);
+    EXPECT_EQ(invocations[2].trigger_time, 2);
+    EXPECT_EQ(invocations[3].trigger_time, 6);
+}
+
+TEST_F(DeferredExec, TokensCycleThroughEveryValue) {
+    start_at(0);
+
+    // One executor stays queued, the other is queued and cancelled over and over
+    deferred_token        held = defer(1000, 1);
+    std::vector<uint16_t> seen(UINT8_MAX + 1);
+    for (int i = 0; i < (UINT8_MAX - 1) * 2; i++) {
+        deferred_token token = defer(10, 2);
+        ASSERT_NE(token, INVALID_DEFERRED_TOKEN);
+        ASSERT_NE(token, held);
+        seen[token]++;
+        EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, token));
+    }
+
+    // Every token other than the held one is handed out in turn
+    for (int token = 1; token <= UINT8_MAX; token++) {
+        EXPECT_EQ(seen[token], token == held ? 0 : 2) << "token " << token;
+    }
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, held));
+}
+
+TEST_F(DeferredExec, IgnoresInvalidTables) {
+    start_at(10);
+
+    deferred_exec_advanced_task(nullptr, 0, &last_execution);
+    deferred_exec_advanced_task(table, 0, &last_execution);
+    EXPECT_EQ(last_execution, 9);
+    EXPECT_EQ(defer_exec_advanced(table, 0, 10, record_callback, nullptr), INVALID_DEFERRED_TOKEN);
+}
+
+TEST_F(DeferredExec, HandlesTimerWraparound) {
+    start_at(0xFFFFFFF0);
+    repeat_delay = 0;
+
+    // Due before, right at and after the 32-bit timer wraps around
+    defer(40, 3);
+    defer(16, 2);
+    defer(5, 1);
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_advanced_next_trigger(table, TABLE_SIZE, &trigger_time));
+    EXPECT_EQ(trigger_time, 0xFFFFFFF5);
+
+    run_for(50);
+    ASSERT_EQ(invocations.size(), 3);
+    EXPECT_EQ(invocations[0].id, 1);
+    EXPECT_EQ(invocations[0].time, 0xFFFFFFF5);
+    EXPECT_EQ(invocations[1].id, 2);
+    EXPECT_EQ(invocations[1].time, 0);
+    EXPECT_EQ(invocations[2].id, 3);
+    EXPECT_EQ(invocations[2].time, 24);
+}
+
+TEST_F(DeferredExec, RepeatsAcrossTimerWraparound) {
+    start_at(0xFFFFFFE0);
+    repeat_delay = 15;
+
+    deferred_token repeating = defer(15, 1);
+    defer(61, 2);
+    run_for(64);
+    EXPECT_TRUE(cancel_deferred_exec_advanced(table, TABLE_SIZE, repeating));
+
+    std::vector<uint32_t> expected = {0xFFFFFFEF, 0xFFFFFFFE, 0x0000000D, 0x0000001C, 0x0000001D};
+    ASSERT_EQ(invocations.size(), expected.size());
+    for (size_t i = 0; i < expected.size(); i++) {
+        EXPECT_EQ(invocations[i].trigger_time, expected[i]);
+    }
+    // The one-off executor was queued first, but is due after the fourth repeat
+    EXPECT_EQ(invocations[3].id, 1);
+    EXPECT_EQ(invocations[4].id, 2);
+}
+
+static deferred_token      requeued_token = INVALID_DEFERRED_TOKEN;
+static deferred_executor_t requeue_table[4];
+
+static uint32_t requeue_callback(uint32_t trigger_time, void *cb_arg) {
+    // Cancels itself and queues a replacement, which must not be repeated by the task
+    cancel_deferred_exec_advanced(requeue_table, 4, requeued_token);
+    requeued_token = defer_exec_advanced(requeue_table, 4, 10, record_callback, cb_arg);
+    return 5;
+}
+
+TEST_F(DeferredExec, CallbackRequeuesItself) {
+    start_at(0);
+    last_execution = 0;
+    repeat_delay   = 0;
+
+    requeued_token = defer_exec_advanced(requeue_table, 4, 5, requeue_callback, (void *)1);
+    for (int i = 0; i < 20; i++) {
+        advance_time(1);
+        deferred_exec_advanced_task(requeue_table, 4, &last_execution);
+    }
+
+    ASSERT_EQ(invocations.size(), 1);
+    EXPECT_EQ(invocations[0].trigger_time, 15);
+    uint32_t trigger_time;
+    EXPECT_FALSE(deferred_exec_advanced_next_trigger(requeue_table, 4, &trigger_time));
+}
+
+TEST_F(DeferredExec, BasicApi) {
+    std::vector<deferred_token> tokens;
+    for (uintptr_t i = 0; i < MAX_DEFERRED_EXECUTORS; i++) {
+        tokens.push_back(defer_exec(100 - i, record_callback, (void *)i));
+        EXPECT_NE(tokens.back(), INVALID_DEFERRED_TOKEN);
+    }
+    EXPECT_EQ(defer_exec(10, record_callback, NULL), INVALID_DEFERRED_TOKEN);
+
+    uint32_t trigger_time;
+    ASSERT_TRUE(deferred_exec_next_trigger(&trigger_time));
+    EXPECT_EQ(trigger_time, 100 - (MAX_DEFERRED_EXECUTORS - 1));
+
+    for (auto token : tokens) {
+        EXPECT_TRUE(cancel_deferred_exec(token));
+    }
+    EXPECT_FALSE(deferred_exec_next_trigger(&trigger_time));
+    deferred_exec_task();
+    EXPECT_TRUE(invocations.empty());
+}
@@ -0,0 +1,32 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string.h>
+#include "eeprom_driver.h"
+#include "eeprom_mock.h"
+
+static uint8_t eeprom_mock_buffer[EEPROM_SIZE];
+
+eeprom_mock_stats_t eeprom_mock_stats;
+
+void eeprom_mock_reset(void) {
+    eeprom_mock_stats = (eeprom_mock_stats_t){0};
+}
+
+void eeprom_driver_init(void) {}
+
+void eeprom_driver_erase(void) {
+    memset(eeprom_mock_buffer, 0x00, sizeof(eeprom_mock_buffer));
+}
+
+void eeprom_read_block(void *buf, const void *addr, size_t len) {
+    eeprom_mock_stats.reads++;
+    eeprom_mock_stats.read_bytes += len;
+    memcpy(buf, &eeprom_mock_buffer[(uintptr_t)addr], len);
+}
+
+void eeprom_write_block(const void *buf, void *addr, size_t len) {
+    eeprom_mock_stats.writes++;
+    eeprom_mock_stats.write_bytes += len;
+    memcpy(&eeprom_mock_buffer[(uintptr_t)addr], buf, len);
+}
@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+typedef struct {
+    uint32_t reads;
+    uint32_t read_bytes;
+    uint32_t writes;
+    uint32_t write_bytes;
+} eeprom_mock_stats_t;
+
+// Driver level accesses, every eeprom_read_byte() and friends is one of these
+extern eeprom_mock_stats_t eeprom_mock_stats;
+
+void eeprom_mock_reset(void);
@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../config.h"
+
+#define DYNAMIC_KEYMAP_RAM_CACHE
+#define DYNAMIC_KEYMAP_WRITE_BACK_DELAY 100
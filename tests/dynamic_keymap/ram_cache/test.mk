@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+DYNAMIC_KEYMAP_ENABLE = yes
+EEPROM_DRIVER = custom
+
+SRC += ../eeprom_mock.c
+
+# Same checks as the direct EEPROM accesses, served from the RAM cache
+TEST_SRC += ../test_dynamic_keymap.cpp
@@ -0,0 +1,257 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "dynamic_keymap.h"
+#include "eeprom.h"
+#include "eeprom_mock.h"
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+#define KEYMAP_SIZE (DYNAMIC_KEYMAP_LAYER_COUNT * MATRIX_ROWS * MATRIX_COLS * 2)
+
+class DynamicKeymap : public TestFixture {
+   protected:
+    void SetUp() override {
+        dynamic_keymap_reset();
+        dynamic_keymap_macro_reset();
+        dynamic_keymap_flush();
+    }
+
+    // What the uncached implementation returns, straight from the EEPROM
+    uint16_t eeprom_keycode(uint8_t layer, uint8_t row, uint8_t col) {
+        const uint8_t *address = (const uint8_t *)dynamic_keymap_key_to_eeprom_address(layer, row, col);
+        return (eeprom_read_byte(address) << 8) | eeprom_read_byte(address + 1);
+    }
+
+    void expect_eeprom_matches_keymap() {
+        for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+            for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+                for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                    EXPECT_EQ(eeprom_keycode(layer, row, col), dynamic_keymap_get_keycode(layer, row, col)) << "layer " << +layer << " row " << +row << " col " << +col;
+                }
+            }
+        }
+    }
+
+    void set_macros(const uint8_t *macros, uint16_t size) {
+        uint16_t buffer_size = dynamic_keymap_macro_get_buffer_size();
+        uint8_t  busy        = 0xFF;
+        // Same sequence as VIA, the last byte flags the buffer as being written
+        dynamic_keymap_macro_set_buffer(buffer_size - 1, 1, &busy);
+        dynamic_keymap_macro_set_buffer(0, size, (uint8_t *)macros);
+        uint8_t done = 0;
+        dynamic_keymap_macro_set_buffer(buffer_size - 1, 1, &done);
+    }
+};
+
+TEST_F(DynamicKeymap, KeycodesRoundTrip) {
+    dynamic_keymap_set_keycode(0, 1, 2, KC_A);
+    dynamic_keymap_set_keycode(1, 3, 9, QK_MACRO_3);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 1, 2), KC_A);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 3, 9), QK_MACRO_3);
+
+    // Big endian keycodes, one row of layer 1
+    uint8_t row[MATRIX_COLS * 2];
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        row[col * 2]     = 0x7E;
+        row[col * 2 + 1] = col;
+    }
+    dynamic_keymap_set_buffer((MATRIX_ROWS + 2) * MATRIX_COLS * 2, sizeof(row), row);
+    for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+        EXPECT_EQ(dynamic_keymap_get_keycode(1, 2, col), 0x7E00 | col);
+    }
+
+    uint8_t buffer[KEYMAP_SIZE];
+    dynamic_keymap_get_buffer(0, sizeof(buffer), buffer);
+    EXPECT_EQ(buffer[(1 * MATRIX_COLS + 2) * 2], KC_A >> 8);
+    EXPECT_EQ(buffer[(1 * MATRIX_COLS + 2) * 2 + 1], KC_A & 0xFF);
+    EXPECT_EQ(memcmp(&buffer[(MATRIX_ROWS + 2) * MATRIX_COLS * 2], row, sizeof(row)), 0);
+
+    dynamic_keymap_flush();
+    expect_eeprom_matches_keymap();
+}
+
+TEST_F(DynamicKeymap, OutOfRangeAccess) {
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, MATRIX_ROWS, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, MATRIX_COLS), KC_NO);
+
+    // Writes past the keymap are dropped, reads past it are zero
+    uint8_t data[4] = {0x12, 0x34, 0x56, 0x78};
+    dynamic_keymap_set_buffer(KEYMAP_SIZE - 2, sizeof(data), data);
+    uint8_t buffer[4];
+    dynamic_keymap_get_buffer(KEYMAP_SIZE - 2, sizeof(buffer), buffer);
+    EXPECT_EQ(buffer[0], 0x12);
+    EXPECT_EQ(buffer[1], 0x34);
+    EXPECT_EQ(buffer[2], 0x00);
+    EXPECT_EQ(buffer[3], 0x00);
+    EXPECT_EQ(dynamic_keymap_get_keycode(DYNAMIC_KEYMAP_LAYER_COUNT - 1, MATRIX_ROWS - 1, MATRIX_COLS - 1), 0x1234);
+
+    dynamic_keymap_flush();
+    expect_eeprom_matches_keymap();
+}
+
+TEST_F(DynamicKeymap, ResetIsStoredImmediately) {
+    dynamic_keymap_set_keycode(0, 0, 0, KC_B);
+    dynamic_keymap_reset();
+    EXPECT_EQ(dynamic_keymap_get_keycode(0, 0, 0), KC_NO);
+    EXPECT_EQ(dynamic_keymap_get_keycode(1, 0, 0), KC_TRNS);
+    expect_eeprom_matches_keymap();
+}
+
+TEST_F(DynamicKeymap, ChangesAreWrittenBack) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    uint8_t  chunk[28];
+    uint32_t writes = eeprom_mock_stats.write_bytes;
+    for (uint16_t offset = 0; offset < KEYMAP_SIZE; offset += sizeof(chunk)) {
+        for (uint8_t i = 0; i < sizeof(chunk); i++) {
+            chunk[i] = offset + i;
+        }
+        dynamic_keymap_set_buffer(offset, sizeof(chunk), chunk);
+    }
+
+    uint32_t upload_writes = eeprom_mock_stats.write_bytes - writes;
+
+    writes = eeprom_mock_stats.write_bytes;
+    run_one_scan_loop();
+    idle_for(1000);
+    writes = eeprom_mock_stats.write_bytes - writes;
+    expect_eeprom_matches_keymap();
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Nothing was written while uploading, then the whole keymap in one go
+    EXPECT_EQ(upload_writes, 0u);
+    EXPECT_EQ(writes, (uint32_t)KEYMAP_SIZE);
+#else
+    // Written while uploading, nothing left afterwards
+    EXPECT_GT(upload_writes, 0u);
+    EXPECT_EQ(writes, 0u);
+#endif
+}
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+TEST_F(DynamicKeymap, WriteBackWaitsForChangesToSettle) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    uint32_t writes = eeprom_mock_stats.write_bytes;
+
+    dynamic_keymap_set_keycode(0, 2, 3, KC_C);
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY / 2);
+    dynamic_keymap_set_keycode(1, 0, 1, KC_D);
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY / 2);
+    EXPECT_EQ(eeprom_mock_stats.write_bytes, writes);
+    EXPECT_NE(eeprom_keycode(0, 2, 3), KC_C);
+
+    idle_for(DYNAMIC_KEYMAP_WRITE_BACK_DELAY);
+    EXPECT_EQ(eeprom_keycode(0, 2, 3), KC_C);
+    EXPECT_EQ(eeprom_keycode(1, 0, 1), KC_D);
+    // The range between both changes goes out as a single block
+    uint16_t first = (2 * MATRIX_COLS + 3) * 2;
+    uint16_t last  = (MATRIX_ROWS * MATRIX_COLS + 1) * 2 + 2;
+    EXPECT_EQ(eeprom_mock_stats.write_bytes - writes, (uint32_t)(last - first));
+}
+#endif
+
+TEST_F(DynamicKeymap, LookupCost) {
+    const uint32_t lookups = MATRIX_ROWS * MATRIX_COLS * DYNAMIC_KEYMAP_LAYER_COUNT;
+    dynamic_keymap_get_keycode(0, 0, 0);
+
+    uint32_t reads = eeprom_mock_stats.reads;
+    for (uint8_t layer = 0; layer < DYNAMIC_KEYMAP_LAYER_COUNT; layer++) {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                keycode_at_keymap_location(layer, row, col);
+            }
+        }
+    }
+    reads = eeprom_mock_stats.reads - reads;
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    EXPECT_EQ(reads, 0u);
+#else
+    EXPECT_EQ(reads, lookups * 2);
+#endif
+}
+
+TEST_F(DynamicKeymap, MacrosAreSent) {
+    TestDriver driver;
+    const uint8_t macros[] = "a\0bc\0\0d";
+    set_macros(macros, sizeof(macros));
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_C));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    // Empty macros, both explicit and past the stored ones
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(2);
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT - 1);
+    dynamic_keymap_macro_send(DYNAMIC_KEYMAP_MACRO_COUNT);
+    VERIFY_AND_CLEAR(driver);
+
+    uint32_t reads = eeprom_mock_stats.reads;
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_D));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    dynamic_keymap_macro_send(3);
+    VERIFY_AND_CLEAR(driver);
+    reads = eeprom_mock_stats.reads - reads;
+
+#ifdef DYNAMIC_KEYMAP_RAM_CACHE
+    // Only the macro itself and its terminator
+    EXPECT_EQ(reads, 2u);
+#else
+    // The macros before it are skipped byte by byte
+    EXPECT_GT(reads, 2u);
+#endif
+}
+
+TEST_F(DynamicKeymap, MacrosFollowBufferChanges) {
+    TestDriver driver;
+    const uint8_t macros[] = "a\0b";
+    set_macros(macros, sizeof(macros));
+
+    EXPECT_REPORT(driver, (KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    const uint8_t longer[] = "ef\0g";
+    set_macros(longer, sizeof(longer));
+
+    EXPECT_REPORT(driver, (KC_G));
+    EXPECT_EMPTY_REPORT(driver);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    // A buffer that is being written sends nothing
+    uint8_t busy = 0xFF;
+    dynamic_keymap_macro_set_buffer(dynamic_keymap_macro_get_buffer_size() - 1, 1, &busy);
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    dynamic_keymap_macro_send(1);
+    VERIFY_AND_CLEAR(driver);
+
+    dynamic_keymap_macro_reset();
+    EXPECT_NO_REPORT(driver);
+    dynamic_keymap_macro_send(0);
+    VERIFY_AND_CLEAR(driver);
+}
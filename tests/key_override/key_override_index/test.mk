@@ -0,0 +1,9 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+KEY_OVERRIDE_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = test_key_overrides.c
+
+# Same behaviour as the linear key override search, run against the trigger index
+TEST_SRC += ../test_key_override.cpp
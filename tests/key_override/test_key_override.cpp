@@ -0,0 +1,307 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "keymap_introspection.h"
+}
+
+using testing::_;
+using testing::AnyNumber;
+using testing::InSequence;
+
+/* GUI overrides over keycodes the tests mostly don't use, served after the
+ * keymap's own overrides through the weak key_override_count()/key_override_get()
+ * hooks. None of them activate, as the tests never hold GUI. */
+static std::vector<key_override_t> generated_overrides;
+
+extern "C" uint16_t key_override_count(void) {
+    return key_override_count_raw() + generated_overrides.size();
+}
+
+extern "C" const key_override_t *key_override_get(uint16_t key_override_idx) {
+    if (key_override_idx < key_override_count_raw()) {
+        return key_override_get_raw(key_override_idx);
+    }
+    if (key_override_idx - key_override_count_raw() < generated_overrides.size()) {
+        return &generated_overrides[key_override_idx - key_override_count_raw()];
+    }
+    return NULL;
+}
+
+static void generate_overrides(uint16_t count) {
+    static const uint16_t pool[] = {KC_F1, KC_F2, KC_F3, KC_F4, KC_F5, KC_F6, KC_F7, KC_F8, KC_F9, KC_F10, KC_F11, KC_F12, KC_KP_1, KC_KP_2, KC_KP_3, KC_KP_4, KC_KP_5, KC_KP_6, KC_KP_7, KC_KP_8, KC_KP_9, KC_KP_0, KC_BACKSPACE, KC_COMMA, KC_NO};
+    const size_t          pool_size = sizeof(pool) / sizeof(pool[0]);
+
+    generated_overrides.clear();
+    for (uint16_t i = 0; i < count; i++) {
+        key_override_t override  = {};
+        override.trigger         = pool[i % pool_size];
+        override.trigger_mods    = MOD_MASK_GUI;
+        override.layers          = ~0;
+        override.suppressed_mods = MOD_MASK_GUI;
+        override.replacement     = KC_KP_ENTER;
+        override.options         = ko_options_default;
+        generated_overrides.push_back(override);
+    }
+    key_override_rebuild_index();
+}
+
+class KeyOverride : public TestFixture {
+   protected:
+    void SetUp() override {
+        key_override_on();
+        generate_overrides(300);
+    }
+
+    void TearDown() override {
+        generate_overrides(0);
+    }
+};
+
+TEST_F(KeyOverride, shift_backspace_sends_delete) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_backspace});
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger is swallowed and the mods are suppressed along with the replacement
+    EXPECT_REPORT(driver, (KC_DELETE));
+    key_backspace.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_LEFT_SHIFT)).Times(AnyNumber());
+    key_backspace.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, backspace_without_shift_is_not_overridden) {
+    TestDriver driver;
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_backspace});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_BACKSPACE));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    tap_key(key_backspace);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, first_matching_override_wins) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LEFT_CTRL);
+    KeymapKey  key_comma(0, 1, 0, KC_COMMA);
+    set_keymap({key_ctrl, key_comma});
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    key_ctrl.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger is swallowed and the mods are suppressed along with the replacement
+    EXPECT_REPORT(driver, (KC_A));
+    key_comma.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_comma.release();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, override_for_other_layer_is_ignored) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_slash(0, 1, 0, KC_SLASH);
+    set_keymap({key_shift, key_slash});
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_SLASH));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_slash);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, negative_mod_blocks_override) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_RIGHT_CTRL);
+    KeymapKey  key_alt(0, 1, 0, KC_LEFT_ALT);
+    KeymapKey  key_q(0, 2, 0, KC_Q);
+    set_keymap({key_ctrl, key_alt, key_q});
+
+    // Alt + Q is overridden
+    EXPECT_REPORT(driver, (KC_LEFT_ALT));
+    key_alt.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger is swallowed and the mods are suppressed along with the replacement
+    EXPECT_REPORT(driver, (KC_D));
+    key_q.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_q.release();
+    run_one_scan_loop();
+    key_alt.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Ctrl + Alt + Q is not. Right ctrl, as left ctrl + left alt is a modifier only override of its own
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_RIGHT_CTRL));
+        EXPECT_REPORT(driver, (KC_RIGHT_CTRL, KC_LEFT_ALT));
+        EXPECT_REPORT(driver, (KC_RIGHT_CTRL, KC_LEFT_ALT, KC_Q));
+        EXPECT_REPORT(driver, (KC_RIGHT_CTRL, KC_LEFT_ALT));
+    }
+    key_ctrl.press();
+    run_one_scan_loop();
+    key_alt.press();
+    run_one_scan_loop();
+    tap_key(key_q);
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_alt.release();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, modifier_only_override) {
+    TestDriver driver;
+    KeymapKey  key_ctrl(0, 0, 0, KC_LEFT_CTRL);
+    KeymapKey  key_alt(0, 1, 0, KC_LEFT_ALT);
+    set_keymap({key_ctrl, key_alt});
+
+    EXPECT_REPORT(driver, (KC_LEFT_CTRL));
+    key_ctrl.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // Activated by a modifier, so the replacement is deferred
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    key_alt.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // No key was pressed recently, so the replacement waits for the repeat delay
+    EXPECT_REPORT(driver, (KC_F13));
+    idle_for(500); // KEY_OVERRIDE_REPEAT_DELAY
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_alt.release();
+    run_one_scan_loop();
+    key_ctrl.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, modifier_pressed_while_trigger_held) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_backspace});
+
+    EXPECT_REPORT(driver, (KC_BACKSPACE));
+    key_backspace.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    // The trigger is unregistered right away, the replacement comes after the repeat delay
+    EXPECT_EMPTY_REPORT(driver).Times(AnyNumber());
+    key_shift.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_REPORT(driver, (KC_DELETE));
+    idle_for(500); // KEY_OVERRIDE_REPEAT_DELAY
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(AnyNumber());
+    key_backspace.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, turned_off) {
+    TestDriver driver;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_backspace(0, 1, 0, KC_BACKSPACE);
+    set_keymap({key_shift, key_backspace});
+
+    key_override_off();
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_BACKSPACE));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    key_shift.press();
+    run_one_scan_loop();
+    tap_key(key_backspace);
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(KeyOverride, many_inactive_overrides_leave_keys_alone) {
+    TestDriver driver;
+    InSequence s;
+    KeymapKey  key_shift(0, 0, 0, KC_LEFT_SHIFT);
+    KeymapKey  key_a(0, 1, 0, KC_A);
+    set_keymap({key_shift, key_a});
+
+    for (uint16_t count : {0, 50, 100, 200, 400}) {
+        generate_overrides(count);
+
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+        tap_key(key_a);
+
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        key_shift.press();
+        run_one_scan_loop();
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_A));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        tap_key(key_a);
+        EXPECT_EMPTY_REPORT(driver);
+        key_shift.release();
+        run_one_scan_loop();
+        VERIFY_AND_CLEAR(driver);
+    }
+}
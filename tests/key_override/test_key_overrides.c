@@ -0,0 +1,21 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+#include "quantum.h"
+
+const key_override_t shift_backspace_override = ko_make_basic(MOD_MASK_SHIFT, KC_BACKSPACE, KC_DELETE);
+const key_override_t ctrl_comma_override      = ko_make_basic(MOD_MASK_CTRL, KC_COMMA, KC_A);
+const key_override_t ctrl_comma_shadowed      = ko_make_basic(MOD_MASK_CTRL, KC_COMMA, KC_B);
+const key_override_t shift_slash_on_layer_1   = ko_make_with_layers(MOD_MASK_SHIFT, KC_SLASH, KC_C, 1 << 1);
+const key_override_t alt_q_without_ctrl       = ko_make_with_layers_and_negmods(MOD_MASK_ALT, KC_Q, KC_D, ~0, MOD_MASK_CTRL);
+const key_override_t ctrl_alt_only            = ko_make_basic(MOD_BIT(KC_LEFT_CTRL) | MOD_BIT(KC_LEFT_ALT), KC_NO, KC_F13);
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &shift_backspace_override,
+    &ctrl_comma_override,
+    &ctrl_comma_shadowed,
+    &shift_slash_on_layer_1,
+    &alt_q_without_ctrl,
+    &ctrl_alt_only,
+};
+// clang-format on
@@ -0,0 +1,82 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+#include "typing_trace.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+
+/* Number of times the trace is replayed, to even out the noise of the host. */
+#define LATENCY_PASSES 3
+
+static uint64_t percentile(const std::vector<uint64_t> &sorted, unsigned percent) {
+    if (sorted.empty()) {
+        return 0;
+    }
+    return sorted[std::min<size_t>(sorted.size() - 1, sorted.size() * percent / 100)];
+}
+
+static std::string feature_set(void) {
+    std::string features;
+#ifdef COMBO_ENABLE
+    features += " combo";
+#endif
+#ifdef TAP_DANCE_ENABLE
+    features += " tap_dance";
+#endif
+#ifdef KEY_OVERRIDE_ENABLE
+    features += " key_override";
+#endif
+#ifdef AUTOCORRECT_ENABLE
+    features += " autocorrect";
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    features += " auto_shift";
+#endif
+    return features.empty() ? "baseline" : features.substr(1);
+}
+
+/**
+ * Measures the cost of the matrix to report path for each event of a typing trace. The cost of a scan loop with
+ * matrix changes is split over the events it handled, all others are idle scans. Set LATENCY_TRACE to the path of a
+ * recorded trace to replay it instead of the built-in one.
+ */
+TEST_F(TypingTrace, Latency) {
+    TestDriver driver;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_nkro_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_mouse_mock(_)).Times(AnyNumber());
+    EXPECT_CALL(driver, send_extra_mock(_)).Times(AnyNumber());
+
+    const char *path  = std::getenv("LATENCY_TRACE");
+    auto        trace = path ? load_trace(path) : synthesize_trace(typing_text);
+    ASSERT_FALSE(trace.empty());
+
+    std::vector<uint64_t> event_ns, idle_ns;
+    for (int pass = 0; pass < LATENCY_PASSES; pass++) {
+        replay(trace, [&event_ns, &idle_ns](unsigned events) {
+            auto start = std::chrono::steady_clock::now();
+            keyboard_task();
+            auto elapsed = std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - start).count();
+
+            if (events) {
+                for (unsigned i = 0; i < events; i++) {
+                    event_ns.push_back(elapsed / events);
+                }
+            } else {
+                idle_ns.push_back(elapsed);
+            }
+        });
+    }
+    VERIFY_AND_CLEAR(driver);
+
+    std::sort(event_ns.begin(), event_ns.end());
+    std::sort(idle_ns.begin(), idle_ns.end());
+    std::cout << "[ BENCH    ] latency (" << feature_set() << "): " << event_ns.size() << " events, p50 " << percentile(event_ns, 50) << " ns, p99 " << percentile(event_ns, 99) << " ns, max " << event_ns.back() << " ns per event; idle scan p50 " << percentile(idle_ns, 50) << " ns, p99 " << percentile(idle_ns, 99) << " ns" << std::endl;
+}
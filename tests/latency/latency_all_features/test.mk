@@ -0,0 +1,12 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+COMBO_ENABLE = yes
+TAP_DANCE_ENABLE = yes
+KEY_OVERRIDE_ENABLE = yes
+AUTOCORRECT_ENABLE = yes
+AUTO_SHIFT_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../latency_features.c
+
+TEST_SRC += ../test_latency.cpp ../typing_trace.cpp ../benchmark_latency.cpp
@@ -0,0 +1,8 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+AUTO_SHIFT_ENABLE = yes
+
+INTROSPECTION_KEYMAP_C = ../latency_features.c
+
+TEST_SRC += ../test_latency.cpp ../typing_trace.cpp ../benchmark_latency.cpp
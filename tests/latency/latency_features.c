@@ -0,0 +1,46 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "quantum.h"
+
+/* Feature configuration shared by all latency tests, each one only
+ * picks up the parts for the features it enables. */
+
+#ifdef COMBO_ENABLE
+// Home row combos, which are rolled over regularly while typing
+const uint16_t PROGMEM combo_df[] = {KC_D, KC_F, COMBO_END};
+const uint16_t PROGMEM combo_jk[] = {KC_J, KC_K, COMBO_END};
+const uint16_t PROGMEM combo_er[] = {KC_E, KC_R, COMBO_END};
+const uint16_t PROGMEM combo_io[] = {KC_I, KC_O, COMBO_END};
+
+// clang-format off
+combo_t key_combos[] = {
+    COMBO(combo_df, KC_TAB),
+    COMBO(combo_jk, KC_ESCAPE),
+    COMBO(combo_er, KC_MINUS),
+    COMBO(combo_io, KC_EQUAL),
+};
+// clang-format on
+#endif
+
+#ifdef TAP_DANCE_ENABLE
+// clang-format off
+tap_dance_action_t tap_dance_actions[] = {
+    ACTION_TAP_DANCE_DOUBLE(KC_SPACE, KC_ENTER),
+};
+// clang-format on
+#endif
+
+#ifdef KEY_OVERRIDE_ENABLE
+const key_override_t delete_key_override = ko_make_basic(MOD_MASK_SHIFT, KC_BACKSPACE, KC_DELETE);
+const key_override_t semicolon_override  = ko_make_basic(MOD_MASK_SHIFT, KC_COMMA, KC_SEMICOLON);
+const key_override_t colon_override      = ko_make_basic(MOD_MASK_SHIFT, KC_DOT, S(KC_SEMICOLON));
+
+// clang-format off
+const key_override_t *key_overrides[] = {
+    &delete_key_override,
+    &semicolon_override,
+    &colon_override,
+};
+// clang-format on
+#endif
@@ -0,0 +1,8 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+# --------------------------------------------------------------------------------
+# Baseline: the keypress pipeline without any optional features
+# --------------------------------------------------------------------------------
+
+INTROSPECTION_KEYMAP_C = latency_features.c
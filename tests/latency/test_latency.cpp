@@ -0,0 +1,222 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <string>
+#include <vector>
+
+#include "keyboard_report_util.hpp"
+#include "typing_trace.hpp"
+
+using testing::_;
+using testing::AnyNumber;
+using testing::Invoke;
+
+/* Works out the reports the host should see for a trace, from what each
+ * enabled feature does to the key events of the built-in typing text. */
+class ExpectedReports {
+   public:
+    std::vector<report_keyboard_t> reports;
+
+    void event(const trace_event_t &event) {
+        uint16_t keycode = trace_keycode(event.row, event.col);
+        if (event.pressed) {
+            press(keycode);
+        } else {
+            release(keycode);
+        }
+    }
+
+   private:
+    report_keyboard_t report = {};
+
+    void send(void) {
+        // Reports are only sent when they change
+        if (reports.empty() || !(reports.back() == report)) {
+            reports.push_back(report);
+        }
+    }
+
+    void add(uint16_t keycode) {
+        if (IS_MODIFIER_KEYCODE(keycode)) {
+            report.mods |= MOD_BIT(keycode);
+            return;
+        }
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (!report.keys[i]) {
+                report.keys[i] = keycode;
+                return;
+            }
+        }
+    }
+
+    void del(uint16_t keycode) {
+        if (IS_MODIFIER_KEYCODE(keycode)) {
+            report.mods &= ~MOD_BIT(keycode);
+            return;
+        }
+        for (uint8_t i = 0; i < KEYBOARD_REPORT_KEYS; i++) {
+            if (report.keys[i] == keycode) {
+                report.keys[i] = 0;
+            }
+        }
+    }
+
+    void tap(uint16_t keycode) {
+        add(keycode);
+        send();
+        del(keycode);
+        send();
+    }
+
+#ifdef TAP_DANCE_ENABLE
+    // The space bar is a tap dance, tapped once it sends space as soon as the next key is pressed
+    bool space_pending = false;
+    bool space_held    = false;
+
+    void resolve_space(void) {
+        if (space_pending) {
+            space_pending = false;
+            add(KC_SPACE);
+            send();
+            if (!space_held) {
+                del(KC_SPACE);
+                send();
+            }
+        }
+    }
+#endif
+
+#ifdef AUTO_SHIFT_ENABLE
+    // Taps shorter than the timeout are sent on release, or when the next key is pressed
+    uint16_t shift_pending = KC_NO;
+
+    void resolve_shift(void) {
+        if (shift_pending != KC_NO) {
+            tap(shift_pending);
+            shift_pending = KC_NO;
+        }
+    }
+#endif
+
+#ifdef AUTOCORRECT_ENABLE
+    // The letters typed since the last word boundary
+    std::string word;
+
+    bool autocorrect(uint16_t keycode) {
+        static const struct {
+            const char *typo;
+            const char *correction;
+            bool        word_start;
+        } corrections[] = {
+            {"becuase", "because", false},
+            {"cheif", "chief", false},
+            {"thier", "their", true},
+            {"ture", "true", true},
+        };
+
+        if (IS_MODIFIER_KEYCODE(keycode)) {
+            return false;
+        }
+        if (keycode == KC_BACKSPACE) {
+            if (!word.empty()) {
+                word.pop_back();
+            }
+            return false;
+        }
+        if (keycode < KC_A || keycode > KC_Z) {
+            word.clear();
+            return false;
+        }
+
+        word += (char)('a' + keycode - KC_A);
+        for (auto &c : corrections) {
+            std::string typo(c.typo);
+            if (word.size() < typo.size() || word.compare(word.size() - typo.size(), typo.size(), typo) != 0 || (c.word_start && word.size() != typo.size())) {
+                continue;
+            }
+            // Only the differing tail is retyped, the last letter of the typo is never sent
+            size_t common = 0;
+            while (c.typo[common] == c.correction[common]) {
+                common++;
+            }
+            for (size_t i = common; i < typo.size() - 1; i++) {
+                tap(KC_BACKSPACE);
+            }
+            for (const char *letter = &c.correction[common]; *letter; letter++) {
+                tap(KC_A + (*letter - 'a'));
+            }
+            word.clear();
+            return true;
+        }
+        return false;
+    }
+#endif
+
+    void press(uint16_t keycode) {
+#ifdef TAP_DANCE_ENABLE
+        resolve_space();
+        if (keycode == KC_SPACE) {
+            space_pending = true;
+            space_held    = true;
+            return;
+        }
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+        // Auto shift comes first in the chain, autocorrect never sees the keys it takes over
+        resolve_shift();
+        if (IS_BASIC_KEYCODE(keycode) && (keycode <= KC_Z || (keycode >= KC_MINUS && keycode <= KC_SLASH))) {
+            shift_pending = keycode;
+            return;
+        }
+#endif
+#ifdef AUTOCORRECT_ENABLE
+        if (autocorrect(keycode)) {
+            return;
+        }
+#endif
+        add(keycode);
+        send();
+    }
+
+    void release(uint16_t keycode) {
+#ifdef TAP_DANCE_ENABLE
+        if (keycode == KC_SPACE) {
+            space_held = false;
+            if (space_pending) {
+                return;
+            }
+        }
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+        if (keycode == shift_pending) {
+            resolve_shift();
+            return;
+        }
+#endif
+        del(keycode);
+        send();
+    }
+};
+
+/**
+ * Replays the built-in typing trace and checks every report the host receives.
+ */
+TEST_F(TypingTrace, ReportSequence) {
+    TestDriver                     driver;
+    std::vector<report_keyboard_t> reports;
+    EXPECT_CALL(driver, send_keyboard_mock(_)).Times(AnyNumber()).WillRepeatedly(Invoke([&reports](report_keyboard_t &report) { reports.push_back(report); }));
+
+    auto trace = synthesize_trace(typing_text);
+    replay(trace, [](unsigned events) { keyboard_task(); });
+    VERIFY_AND_CLEAR(driver);
+
+    ExpectedReports expected;
+    for (auto &event : trace) {
+        expected.event(event);
+    }
+
+    ASSERT_EQ(reports.size(), expected.reports.size());
+    for (size_t i = 0; i < reports.size(); i++) {
+        ASSERT_EQ(reports[i], expected.reports[i]) << "report " << i;
+    }
+}
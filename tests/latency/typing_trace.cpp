@@ -0,0 +1,165 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <sstream>
+#include <string>
+
+#include "typing_trace.hpp"
+
+extern "C" {
+#include "test_matrix.h"
+}
+
+static const char *const layout[] = {"qwertyuiop", "asdfghjkl;", "zxcvbnm,./"};
+
+/* Includes a few typos from the default autocorrect dictionary and a few home
+ * row rolls for combos. */
+const char *const typing_text =
+    "The quick brown fox jumps over the lazy dog, then it naps. "
+    "Typing along at a steady pace, we cheif\b\b\bief among friends should find thier\b\b\beir keys. "
+    "Firmware latency is hard to feel but easy to measure; look at teh\b\bhe numbers. "
+    "Some words roll: dfjk, erio, fades, joked, period, radio. "
+    "Becuase\b\b\b\bause it is ture, every key goes through the whole pipeline.\n"
+    "Sometimes a mistake happens and a word gets deleted\b\b\b\b\b\b\bremoved, then typing resumes. "
+    "Shifted Letters Appear At The Start Of Every Word In This Sentence.\n";
+
+static bool find_char(char c, uint8_t *row, uint8_t *col, bool *shifted) {
+    *shifted = c >= 'A' && c <= 'Z';
+    if (*shifted) {
+        c = c - 'A' + 'a';
+    }
+
+    switch (c) {
+        case ' ':
+            *row = SPACE_ROW;
+            *col = SPACE_COL;
+            return true;
+        case '\n':
+            *row = ENTER_ROW;
+            *col = ENTER_COL;
+            return true;
+        case '\b':
+            *row = BACKSPACE_ROW;
+            *col = BACKSPACE_COL;
+            return true;
+    }
+
+    for (uint8_t r = 0; r < sizeof(layout) / sizeof(layout[0]); r++) {
+        const char *found = strchr(layout[r], c);
+        if (found) {
+            *row = r;
+            *col = found - layout[r];
+            return true;
+        }
+    }
+    return false;
+}
+
+uint16_t trace_keycode(uint8_t row, uint8_t col) {
+    if (row < sizeof(layout) / sizeof(layout[0])) {
+        char c = layout[row][col];
+        return c >= 'a' && c <= 'z' ? KC_A + (c - 'a') : c == ';' ? KC_SEMICOLON : c == ',' ? KC_COMMA : c == '.' ? KC_DOT : KC_SLASH;
+    }
+    switch (col) {
+        case SHIFT_COL:
+            return KC_LEFT_SHIFT;
+        case SPACE_COL:
+            return KC_SPACE;
+        case ENTER_COL:
+            return KC_ENTER;
+        case BACKSPACE_COL:
+            return KC_BACKSPACE;
+    }
+    return KC_NO;
+}
+
+/* Jittered gaps between keys, some of them shorter than the hold time of the
+ * previous key (rolls). The jitter comes from a fixed LCG, so every run
+ * replays the same trace. */
+std::vector<trace_event_t> synthesize_trace(const char *text) {
+    std::vector<trace_event_t> trace;
+    uint32_t                   seed = 1;
+    auto                       jitter = [&seed](uint32_t range) {
+        seed = seed * 1103515245 + 12345;
+        return (seed >> 16) % range;
+    };
+
+    uint32_t time         = 100;
+    uint32_t last_release = 0;
+    uint8_t  last_row = 0xFF, last_col = 0xFF;
+    for (const char *c = text; *c; c++) {
+        uint8_t row, col;
+        bool    shifted;
+        if (!find_char(*c, &row, &col, &shifted)) {
+            continue;
+        }
+
+        // The same key can't be pressed again before it was released
+        if (row == last_row && col == last_col && time <= last_release) {
+            time = last_release + 20;
+        }
+
+        uint32_t hold = 60 + jitter(60);
+        if (shifted) {
+            trace.push_back({time, SHIFT_ROW, SHIFT_COL, true});
+            time += 30;
+        }
+        trace.push_back({time, row, col, true});
+        trace.push_back({time + hold, row, col, false});
+        if (shifted) {
+            trace.push_back({time + hold + 20, SHIFT_ROW, SHIFT_COL, false});
+            time += hold + 40;
+        }
+
+        last_row     = row;
+        last_col     = col;
+        last_release = time + hold;
+        time += 90 + jitter(120);
+    }
+
+    // Events due in the same scan are handled in matrix order
+    std::stable_sort(trace.begin(), trace.end(), [](const trace_event_t &a, const trace_event_t &b) { return a.time != b.time ? a.time < b.time : a.row != b.row ? a.row < b.row : a.col < b.col; });
+    return trace;
+}
+
+std::vector<trace_event_t> load_trace(const char *path) {
+    std::vector<trace_event_t> trace;
+    std::ifstream              file(path);
+    std::string                line;
+    while (std::getline(file, line)) {
+        if (line.empty() || line[0] == '#') {
+            continue;
+        }
+        std::istringstream fields(line);
+        unsigned           time, row, col, pressed;
+        if (fields >> time >> row >> col >> pressed && row < MATRIX_ROWS && col < MATRIX_COLS) {
+            trace.push_back({time, (uint8_t)row, (uint8_t)col, pressed != 0});
+        }
+    }
+    EXPECT_FALSE(trace.empty()) << "no events in trace " << path;
+    return trace;
+}
+
+void TypingTrace::SetUp() {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            uint16_t keycode = trace_keycode(row, col);
+#ifdef TAP_DANCE_ENABLE
+            if (keycode == KC_SPACE) {
+                keycode = TD(0);
+            }
+#endif
+            add_key(KeymapKey(0, col, row, keycode));
+        }
+    }
+
+#ifdef AUTOCORRECT_ENABLE
+    autocorrect_enable();
+#endif
+#ifdef AUTO_SHIFT_ENABLE
+    autoshift_enable();
+#endif
+}
@@ -0,0 +1,71 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+#include "test_common.hpp"
+
+extern "C" {
+void advance_time(uint32_t ms);
+}
+
+typedef struct {
+    uint32_t time;
+    uint8_t  row;
+    uint8_t  col;
+    bool     pressed;
+} trace_event_t;
+
+/* Letters are laid out over the first three rows, the last one holds the
+ * modifiers and the space bar. */
+#define SHIFT_ROW 3
+#define SHIFT_COL 0
+#define SPACE_ROW 3
+#define SPACE_COL 4
+#define ENTER_ROW 3
+#define ENTER_COL 8
+#define BACKSPACE_ROW 3
+#define BACKSPACE_COL 9
+
+/* Typed at around 70 WPM, '\b' being a backspace. */
+extern const char *const typing_text;
+
+/* The keycode the host sees for the key at row/col. */
+uint16_t trace_keycode(uint8_t row, uint8_t col);
+
+/* Turns text into a trace with human-like timing. */
+std::vector<trace_event_t> synthesize_trace(const char *text);
+
+/* Recorded traces hold one event per line: "<time in ms> <row> <col> <1 for a press, 0 for a release>". */
+std::vector<trace_event_t> load_trace(const char *path);
+
+class TypingTrace : public TestFixture {
+   protected:
+    void SetUp() override;
+
+    /* Replays the trace one millisecond per scan loop, until every feature has timed out. `task` runs
+     * keyboard_task() and is told how many events it is handling. */
+    template <typename F>
+    void replay(const std::vector<trace_event_t> &trace, F task) {
+        const uint32_t end  = trace.back().time + TAPPING_TERM * 2;
+        size_t         next = 0;
+        for (uint32_t time = 0; time <= end; time++) {
+            unsigned events = 0;
+            for (; next < trace.size() && trace[next].time <= time; next++, events++) {
+                if (trace[next].pressed) {
+                    press_key(trace[next].col, trace[next].row);
+                } else {
+                    release_key(trace[next].col, trace[next].row);
+                }
+            }
+
+            task(events);
+
+            housekeeping_task();
+            advance_time(1);
+        }
+    }
+};
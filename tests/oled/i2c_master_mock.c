@@ -0,0 +1,89 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <stdbool.h>
+
+#include "i2c_master.h"
+
+i2c_mock_stats_t i2c_mock_stats;
+uint8_t          i2c_mock_gram[I2C_MOCK_GRAM_PAGES][I2C_MOCK_GRAM_COLUMNS];
+
+// Addressing state of the emulated controller
+static uint8_t column_start, column_end = I2C_MOCK_GRAM_COLUMNS - 1, page_start, page_end = I2C_MOCK_GRAM_PAGES - 1;
+static uint8_t column, page;
+static bool    horizontal_mode;
+
+void i2c_mock_reset(void) {
+    i2c_mock_stats = (i2c_mock_stats_t){0};
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_transmit(uint8_t address, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_stats.writes++;
+    i2c_mock_stats.bytes += 1 + length;
+
+    // Commands are prefixed with a control byte
+    for (uint16_t i = 1; i < length; ++i) {
+        uint8_t cmd = data[i];
+        switch (cmd) {
+            case 0x20: // memory mode
+                horizontal_mode = data[++i] == 0x00;
+                break;
+            case 0x21: // column range
+                column_start = column = data[++i];
+                column_end            = data[++i];
+                break;
+            case 0x22: // page range
+                page_start = page = data[++i];
+                page_end          = data[++i];
+                break;
+            case 0x23: // fade/blink
+            case 0x81: // contrast
+            case 0x8D: // charge pump
+            case 0xA8: // multiplex ratio
+            case 0xD3: // display offset
+            case 0xD5: // display clock
+            case 0xD9: // pre-charge period
+            case 0xDA: // COM pins
+            case 0xDB: // VCOM detect
+            case 0xDC: // SH1107 start line
+                ++i;
+                break;
+            case 0x26: // scroll right
+            case 0x27: // scroll left
+                i += 6;
+                break;
+            default:
+                if (cmd >= 0xB0 && cmd <= 0xBF) {
+                    page = cmd & 0x0F;
+                } else if (cmd <= 0x0F) {
+                    column = (column & 0xF0) | cmd;
+                } else if (cmd >= 0x10 && cmd <= 0x1F) {
+                    column = (column & 0x0F) | ((cmd & 0x0F) << 4);
+                }
+                break;
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_stats.writes++;
+    i2c_mock_stats.bytes += 2 + length;
+
+    for (uint16_t i = 0; i < length; ++i) {
+        if (page < I2C_MOCK_GRAM_PAGES && column < I2C_MOCK_GRAM_COLUMNS) {
+            i2c_mock_gram[page][column] = data[i];
+        }
+
+        // Page addressing stays on the same page, horizontal addressing wraps within the configured window
+        if (!horizontal_mode) {
+            column++;
+        } else if (column++ == column_end) {
+            column = column_start;
+            page   = (page == page_end) ? page_start : page + 1;
+        }
+    }
+    return I2C_STATUS_SUCCESS;
+}
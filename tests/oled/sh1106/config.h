@@ -0,0 +1,11 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../config.h"
+
+// A 128x64 panel addressed a page at a time
+#define OLED_DISPLAY_128X64
+#define OLED_IC OLED_IC_SH1106
+#define OLED_SHADOW_BUFFER
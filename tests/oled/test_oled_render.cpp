@@ -0,0 +1,165 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "test_common.hpp"
+
+extern "C" {
+#include "oled_driver.h"
+#include "i2c_master.h"
+}
+
+namespace {
+
+const oled_rotation_t rotations[] = {OLED_ROTATION_0, OLED_ROTATION_90};
+
+bool gram_pixel(uint16_t column, uint16_t row) {
+    return (i2c_mock_gram[row / 8][column + OLED_COLUMN_OFFSET] >> (row % 8)) & 1;
+}
+
+bool buffer_pixel(uint16_t x, uint16_t y, uint16_t width) {
+    return (oled_read_raw(0).current_element[x + (y / 8) * width] >> (y % 8)) & 1;
+}
+
+// Checks every pixel of the buffer made it to the right place in the display's RAM
+::testing::AssertionResult display_matches_buffer(oled_rotation_t rotation) {
+    for (uint16_t row = 0; row < OLED_DISPLAY_HEIGHT; ++row) {
+        for (uint16_t column = 0; column < OLED_DISPLAY_WIDTH; ++column) {
+            // Rotated by 90 degrees, the buffer's rows run along the display's columns, from the bottom up
+            bool expected = rotation == OLED_ROTATION_0 ? buffer_pixel(column, row, OLED_DISPLAY_WIDTH) : buffer_pixel(OLED_DISPLAY_HEIGHT - 1 - row, column, OLED_DISPLAY_HEIGHT);
+            if (gram_pixel(column, row) != expected) {
+                return ::testing::AssertionFailure() << "mismatch at column " << column << ", row " << row;
+            }
+        }
+    }
+    return ::testing::AssertionSuccess();
+}
+
+void draw_dashboard(uint8_t wpm) {
+    char line[32];
+    oled_set_cursor(0, 0);
+    oled_write_ln("Layer: Base", false);
+    snprintf(line, sizeof(line), "WPM: %3u", wpm);
+    oled_write_ln(line, false);
+    oled_write("CAPS", wpm % 2);
+}
+
+void draw_pattern(uint32_t seed) {
+    for (uint16_t i = 0; i < 400; ++i) {
+        seed = seed * 1103515245 + 12345;
+        oled_write_pixel((seed >> 8) % 128, (seed >> 16) % 128, (seed >> 24) & 1);
+    }
+}
+
+} // namespace
+
+class OledRender : public TestFixture {
+   protected:
+    void init(oled_rotation_t rotation) {
+        ASSERT_TRUE(oled_init(rotation));
+        oled_render_dirty(true);
+        i2c_mock_reset();
+    }
+};
+
+TEST_F(OledRender, DisplayMatchesBuffer) {
+    for (auto rotation : rotations) {
+        SCOPED_TRACE(rotation == OLED_ROTATION_0 ? "rotation 0" : "rotation 90");
+        init(rotation);
+        EXPECT_TRUE(display_matches_buffer(rotation));
+
+        draw_dashboard(42);
+        draw_pattern(rotation + 1);
+        oled_render_dirty(true);
+        EXPECT_TRUE(display_matches_buffer(rotation));
+
+        // Small changes scattered over the display
+        draw_pattern(rotation + 2);
+        oled_render_dirty(true);
+        EXPECT_TRUE(display_matches_buffer(rotation));
+
+        // One block at a time
+        draw_dashboard(43);
+        while (i2c_mock_reset(), oled_render(), i2c_mock_stats.writes > 0) {
+        }
+        EXPECT_TRUE(display_matches_buffer(rotation));
+    }
+}
+
+TEST_F(OledRender, UnchangedTextIsNotResent) {
+    for (auto rotation : rotations) {
+        init(rotation);
+        draw_dashboard(42);
+        oled_render_dirty(true);
+
+        i2c_mock_reset();
+        draw_dashboard(42);
+        oled_render_dirty(true);
+        EXPECT_EQ(i2c_mock_stats.bytes, 0u);
+    }
+}
+
+TEST_F(OledRender, ClearedAndRedrawnText) {
+    for (auto rotation : rotations) {
+        init(rotation);
+        draw_dashboard(42);
+        oled_render_dirty(true);
+
+        i2c_mock_reset();
+        oled_clear();
+        draw_dashboard(42);
+        oled_render_dirty(true);
+#ifdef OLED_SHADOW_BUFFER
+        EXPECT_EQ(i2c_mock_stats.bytes, 0u);
+#else
+        EXPECT_GT(i2c_mock_stats.bytes, 0u);
+#endif
+        EXPECT_TRUE(display_matches_buffer(rotation));
+    }
+}
+
+TEST_F(OledRender, FullFrameIsSentInFewTransfers) {
+    init(OLED_ROTATION_0);
+    draw_pattern(7);
+    oled_pan(true);
+    oled_render_dirty(true);
+
+    // Contiguous blocks go out together, one transfer per page at most
+    EXPECT_LE(i2c_mock_stats.writes, 2u * (OLED_DISPLAY_HEIGHT / 8));
+    EXPECT_TRUE(display_matches_buffer(OLED_ROTATION_0));
+}
+
+TEST_F(OledRender, EveryFrameReachesTheDisplay) {
+    struct scenario {
+        const char* name;
+        void (*draw)(uint32_t frame);
+        bool static_content; // Nothing needs to be sent after the first frame
+    };
+    const scenario scenarios[] = {
+        {"static text", [](uint32_t frame) { draw_dashboard(42); }, true},
+        {"counter", [](uint32_t frame) { draw_dashboard(frame % 200); }, false},
+        {"cleared and redrawn", [](uint32_t frame) {
+             oled_clear();
+             draw_dashboard(42);
+         }, false},
+        {"full redraw", [](uint32_t frame) { draw_pattern(frame); }, false},
+    };
+    const uint32_t frames = 100;
+
+    for (auto rotation : rotations) {
+        for (const auto& s : scenarios) {
+            init(rotation);
+            s.draw(0);
+            oled_render_dirty(true);
+
+            i2c_mock_reset();
+            for (uint32_t frame = 1; frame <= frames; ++frame) {
+                s.draw(frame);
+                oled_render_dirty(true);
+                ASSERT_TRUE(display_matches_buffer(rotation)) << s.name << ", frame " << frame;
+            }
+            if (s.static_content) {
+                EXPECT_EQ(i2c_mock_stats.bytes, 0u) << s.name;
+            }
+        }
+    }
+}
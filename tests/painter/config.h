@@ -0,0 +1,19 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Allow every QGF format to be drawn
+#define QUANTUM_PAINTER_SUPPORTS_256_PALETTE 1
+#define QUANTUM_PAINTER_SUPPORTS_NATIVE_COLORS 1
+
+// An RGB565 and a monochrome framebuffer
+#define SURFACE_NUM_DEVICES 2
+
+// Used by the SH1106 I2C comms
+#define I2C_TIMEOUT 100
+
+// Stream asynchronous surface draws a few rows at a time
+#define SURFACE_ASYNC_PIXELS_PER_TASK 256
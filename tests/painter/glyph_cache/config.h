@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../config.h"
+
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES 32
+#define QUANTUM_PAINTER_GLYPH_CACHE_ENTRY_SIZE 512
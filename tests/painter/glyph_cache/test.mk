@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+QUANTUM_PAINTER_DRIVERS = surface sh1106_i2c
+
+SRC += ../thintel15.qff.c ../i2c_master_mock.c
+
+# Same text tests and benchmark, with rendered glyphs cached in native pixel format
+TEST_SRC += ../test_painter_text.cpp
@@ -0,0 +1,39 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+
+#include "test_common.hpp"
+#include "../painter_test_util.hpp"
+#include "../painter_test_font.hpp"
+
+class GlyphCache : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(rgb565_surface(), QP_ROTATION_0));
+    }
+};
+
+TEST_F(GlyphCache, more_glyphs_than_cache_entries) {
+    test_font             font_data = make_font(IMAGE_COMPRESSED_RLE, 1);
+    painter_font_handle_t font      = qp_load_font_mem(font_data.qff.data());
+    ASSERT_NE(font, nullptr);
+
+    // Cycle through more distinct glyphs than fit in the cache, twice over, checking each against an uncached render
+    for (int pass = 0; pass < 2; ++pass) {
+        for (uint16_t index = 95; index < 95 + QUANTUM_PAINTER_GLYPH_CACHE_ENTRIES * 2; ++index) {
+            std::string text = utf8({font_data.code_points[index]});
+            memset(rgb565_buffer(), 0, kRgb565BufferSize);
+            ASSERT_EQ(qp_drawtext(rgb565_surface(), 0, 0, font, text.c_str()), font_data.widths[index]);
+            for (uint16_t y = 0; y < kLineHeight; ++y) {
+                for (uint16_t x = 0; x < font_data.widths[index]; ++x) {
+                    uint8_t value = font_data.values[index][y * font_data.widths[index] + x];
+                    ASSERT_EQ(rgb565_buffer()[y * kWidth + x], qp_internal_global_pixel_lookup_table[value].rgb565) << "glyph " << index << " pass " << pass;
+                }
+            }
+        }
+    }
+
+    qp_close_font(font);
+}
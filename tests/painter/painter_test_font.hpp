@@ -0,0 +1,99 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <string>
+#include <vector>
+
+#include "painter_test_util.hpp"
+
+extern "C" {
+#include "qff.h"
+}
+
+constexpr uint8_t  kLineHeight    = 12;
+constexpr uint16_t kUnicodeGlyphs = 400;
+
+struct test_font {
+    std::vector<uint8_t>              qff;
+    std::vector<uint32_t>             code_points;
+    std::vector<uint8_t>              widths;
+    std::vector<std::vector<uint8_t>> values; // palette indices of each glyph, row-major
+};
+
+inline uint32_t unicode_code_point(uint16_t index) {
+    return 0x100 + index * 7;
+}
+
+// 2bpp grayscale font with the full ascii table followed by a sorted unicode table
+inline test_font make_font(painter_compression_t compression, uint32_t seed) {
+    test_font font;
+    for (uint32_t c = 0x20; c < 0x7F; ++c) {
+        font.code_points.push_back(c);
+    }
+    for (uint16_t i = 0; i < kUnicodeGlyphs; ++i) {
+        font.code_points.push_back(unicode_code_point(i));
+    }
+
+    std::vector<uint8_t>  data;
+    std::vector<uint32_t> offsets;
+    for (size_t i = 0; i < font.code_points.size(); ++i) {
+        uint8_t width = 3 + (i % 9);
+        font.widths.push_back(width);
+        font.values.push_back(make_values(width * kLineHeight, 3, seed + i));
+
+        std::vector<uint8_t> glyph = pack_indices(font.values.back(), 2);
+        if (compression == IMAGE_COMPRESSED_RLE) {
+            glyph = rle_encode(glyph);
+        }
+        offsets.push_back(data.size());
+        data.insert(data.end(), glyph.begin(), glyph.end());
+    }
+
+    std::vector<uint8_t> body;
+    put_block_header(body, QFF_ASCII_GLYPH_DESCRIPTOR_TYPEID, 95 * 3);
+    for (size_t i = 0; i < 95; ++i) {
+        put_u24(body, font.widths[i] | offsets[i] << QFF_GLYPH_WIDTH_BITS);
+    }
+    put_block_header(body, QFF_UNICODE_GLYPH_DESCRIPTOR_TYPEID, kUnicodeGlyphs * 6);
+    for (size_t i = 95; i < font.code_points.size(); ++i) {
+        put_u24(body, font.code_points[i]);
+        put_u24(body, font.widths[i] | offsets[i] << QFF_GLYPH_WIDTH_BITS);
+    }
+    put_block_header(body, 0x04, data.size()); // font data block
+    body.insert(body.end(), data.begin(), data.end());
+
+    uint32_t total = sizeof(qff_font_descriptor_v1_t) + body.size();
+    put_block_header(font.qff, QFF_FONT_DESCRIPTOR_TYPEID, 20);
+    put_u24(font.qff, QFF_MAGIC);
+    font.qff.push_back(0x01);
+    put_u32(font.qff, total);
+    put_u32(font.qff, ~total);
+    font.qff.push_back(kLineHeight);
+    font.qff.push_back(1);
+    put_u16(font.qff, kUnicodeGlyphs);
+    font.qff.push_back(GRAYSCALE_2BPP);
+    font.qff.push_back(0);
+    font.qff.push_back(compression);
+    font.qff.push_back(0);
+    font.qff.insert(font.qff.end(), body.begin(), body.end());
+    return font;
+}
+
+inline std::string utf8(const std::vector<uint32_t>& code_points) {
+    std::string out;
+    for (uint32_t c : code_points) {
+        if (c < 0x80) {
+            out += (char)c;
+        } else if (c < 0x800) {
+            out += (char)(0xC0 | (c >> 6));
+            out += (char)(0x80 | (c & 0x3F));
+        } else {
+            out += (char)(0xE0 | (c >> 12));
+            out += (char)(0x80 | ((c >> 6) & 0x3F));
+            out += (char)(0x80 | (c & 0x3F));
+        }
+    }
+    return out;
+}
@@ -0,0 +1,196 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <vector>
+
+extern "C" {
+#include "qp.h"
+#include "qp_draw.h"
+#include "qp_comms.h"
+#include "qp_comms_dummy.h"
+#include "qp_surface.h"
+}
+
+constexpr uint16_t kWidth  = 64;
+constexpr uint16_t kHeight = 48;
+
+inline void put_u16(std::vector<uint8_t>& out, uint16_t v) {
+    out.push_back(v & 0xFF);
+    out.push_back(v >> 8);
+}
+
+inline void put_u24(std::vector<uint8_t>& out, uint32_t v) {
+    put_u16(out, v & 0xFFFF);
+    out.push_back((v >> 16) & 0xFF);
+}
+
+inline void put_u32(std::vector<uint8_t>& out, uint32_t v) {
+    put_u16(out, v & 0xFFFF);
+    put_u16(out, v >> 16);
+}
+
+inline void put_block_header(std::vector<uint8_t>& out, uint8_t type_id, uint32_t length) {
+    out.push_back(type_id);
+    out.push_back(~type_id);
+    put_u24(out, length);
+}
+
+// Same scheme as `qmk painter-convert-graphics`: markers below 128 repeat the next byte, others prefix a literal run
+inline std::vector<uint8_t> rle_encode(const std::vector<uint8_t>& data) {
+    std::vector<uint8_t> out;
+    size_t               i = 0;
+    while (i < data.size()) {
+        size_t run = 1;
+        while (i + run < data.size() && run < 127 && data[i + run] == data[i]) {
+            ++run;
+        }
+        if (run >= 3) {
+            out.push_back(run);
+            out.push_back(data[i]);
+            i += run;
+            continue;
+        }
+        size_t literal = 0;
+        while (i + literal < data.size() && literal < 128) {
+            if (i + literal + 2 < data.size() && data[i + literal] == data[i + literal + 1] && data[i + literal] == data[i + literal + 2]) {
+                break;
+            }
+            ++literal;
+        }
+        out.push_back(127 + literal);
+        out.insert(out.end(), data.begin() + i, data.begin() + i + literal);
+        i += literal;
+    }
+    return out;
+}
+
+// Flat runs broken up by noise, so RLE output has both repeated and literal runs
+inline std::vector<uint8_t> make_values(uint32_t count, uint32_t max_value, uint32_t seed = 0x2545F491) {
+    std::vector<uint8_t> values;
+    while (values.size() < count) {
+        seed            = seed * 1664525 + 1013904223;
+        uint32_t length = 1 + ((seed >> 8) % 40);
+        uint8_t  value  = (seed >> 20) % (max_value + 1);
+        bool     noisy  = (seed >> 28) & 1;
+        for (uint32_t i = 0; i < length && values.size() < count; ++i) {
+            if (noisy) {
+                seed  = seed * 1664525 + 1013904223;
+                value = (seed >> 16) % (max_value + 1);
+            }
+            values.push_back(value);
+        }
+    }
+    return values;
+}
+
+inline std::vector<uint8_t> pack_indices(const std::vector<uint8_t>& indices, uint8_t bpp) {
+    const uint8_t        pixels_per_byte = 8 / bpp;
+    std::vector<uint8_t> out((indices.size() + pixels_per_byte - 1) / pixels_per_byte);
+    for (size_t i = 0; i < indices.size(); ++i) {
+        out[i / pixels_per_byte] |= indices[i] << ((i % pixels_per_byte) * bpp);
+    }
+    return out;
+}
+
+inline uint32_t fnv1a(const uint8_t* data, size_t length) {
+    uint32_t hash = 2166136261u;
+    for (size_t i = 0; i < length; ++i) {
+        hash = (hash ^ data[i]) * 16777619u;
+    }
+    return hash;
+}
+
+// Panel that streams RGB565 pixdata out through the dummy comms, like a real panel rather than a framebuffer
+inline bool bench_panel_noop(painter_device_t device) {
+    return true;
+}
+
+inline bool bench_panel_init(painter_device_t device, painter_rotation_t rotation) {
+    return true;
+}
+
+inline bool bench_panel_power(painter_device_t device, bool power_on) {
+    return true;
+}
+
+// Sends the column and row address commands with their parameters, like a typical SPI panel
+inline bool bench_panel_viewport(painter_device_t device, uint16_t left, uint16_t top, uint16_t right, uint16_t bottom) {
+    const uint8_t commands[] = {0x2A, (uint8_t)(left >> 8), (uint8_t)left, (uint8_t)(right >> 8), (uint8_t)right, 0x2B, (uint8_t)(top >> 8), (uint8_t)top, (uint8_t)(bottom >> 8), (uint8_t)bottom, 0x2C};
+    return qp_comms_send(device, commands, sizeof(commands)) == sizeof(commands);
+}
+
+inline bool bench_panel_pixdata(painter_device_t device, const void* pixel_data, uint32_t native_pixel_count) {
+    return qp_comms_send(device, pixel_data, native_pixel_count * sizeof(uint16_t)) == native_pixel_count * sizeof(uint16_t);
+}
+
+inline bool bench_panel_palette_convert(painter_device_t device, int16_t palette_size, qp_pixel_t* palette) {
+    for (int16_t i = 0; i < palette_size; ++i) {
+        palette[i].rgb565 = (palette[i].hsv888.h >> 3) << 11 | (palette[i].hsv888.s >> 2) << 5 | (palette[i].hsv888.v >> 3);
+    }
+    return true;
+}
+
+inline bool bench_panel_append_pixels(painter_device_t device, uint8_t* target_buffer, qp_pixel_t* palette, uint32_t pixel_offset, uint32_t pixel_count, uint8_t* palette_indices) {
+    uint16_t* buf = (uint16_t*)target_buffer;
+    for (uint32_t i = 0; i < pixel_count; ++i) {
+        buf[pixel_offset + i] = palette[palette_indices[i]].rgb565;
+    }
+    return true;
+}
+
+inline bool bench_panel_append_pixdata(painter_device_t device, uint8_t* target_buffer, uint32_t pixdata_offset, uint8_t pixdata_byte) {
+    target_buffer[pixdata_offset] = pixdata_byte;
+    return true;
+}
+
+static const painter_driver_vtable_t bench_panel_vtable = {
+    .init            = bench_panel_init,
+    .power           = bench_panel_power,
+    .clear           = bench_panel_noop,
+    .flush           = bench_panel_noop,
+    .viewport        = bench_panel_viewport,
+    .pixdata         = bench_panel_pixdata,
+    .palette_convert = bench_panel_palette_convert,
+    .append_pixels   = bench_panel_append_pixels,
+    .append_pixdata  = bench_panel_append_pixdata,
+};
+
+static painter_driver_t bench_panel = {
+    .driver_vtable         = &bench_panel_vtable,
+    .comms_vtable          = &dummy_comms_vtable,
+    .validate_ok           = true,
+    .panel_width           = kWidth,
+    .panel_height          = kHeight,
+    .rotation              = QP_ROTATION_0,
+    .offset_x              = 0,
+    .offset_y              = 0,
+    .native_bits_per_pixel = 16,
+    .comms_config          = nullptr,
+};
+
+
+// Framebuffers shared by every test in the binary, as surfaces can't be released once made
+inline uint16_t* rgb565_buffer() {
+    static uint16_t buffer[kWidth * kHeight];
+    return buffer;
+}
+
+inline uint8_t* mono_buffer() {
+    static uint8_t buffer[SURFACE_REQUIRED_BUFFER_BYTE_SIZE(kWidth, kHeight, 1)];
+    return buffer;
+}
+
+constexpr size_t kRgb565BufferSize = kWidth * kHeight * sizeof(uint16_t);
+constexpr size_t kMonoBufferSize   = SURFACE_REQUIRED_BUFFER_BYTE_SIZE(kWidth, kHeight, 1);
+
+inline painter_device_t rgb565_surface() {
+    static painter_device_t device = qp_make_rgb565_surface(kWidth, kHeight, rgb565_buffer());
+    return device;
+}
+
+inline painter_device_t mono_surface() {
+    static painter_device_t device = qp_make_mono1bpp_surface(kWidth, kHeight, mono_buffer());
+    return device;
+}
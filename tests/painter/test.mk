@@ -0,0 +1,8 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+QUANTUM_PAINTER_ENABLE = yes
+# Surfaces aren't counted as devices, a display driver gives the device table a non-zero size
+QUANTUM_PAINTER_DRIVERS = surface sh1106_i2c
+
+SRC += thintel15.qff.c i2c_master_mock.c
@@ -0,0 +1,141 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <vector>
+
+#include "test_common.hpp"
+#include "painter_test_util.hpp"
+
+extern "C" {
+#include "qgf.h"
+#include "thintel15.qff.h"
+}
+
+namespace {
+
+struct image_format {
+    const char*       name;
+    qp_image_format_t format;
+    uint8_t           bpp;
+    bool              has_palette;
+};
+
+const image_format formats[] = {
+    {"gray1", GRAYSCALE_1BPP, 1, false}, {"gray2", GRAYSCALE_2BPP, 2, false}, {"gray4", GRAYSCALE_4BPP, 4, false}, {"gray8", GRAYSCALE_8BPP, 8, false}, {"pal1", PALETTE_1BPP, 1, true}, {"pal2", PALETTE_2BPP, 2, true}, {"pal4", PALETTE_4BPP, 4, true}, {"pal8", PALETTE_8BPP, 8, true}, {"rgb565", RGB565_16BPP, 16, false},
+};
+
+std::vector<uint8_t> make_qgf(const image_format& fmt, painter_compression_t compression, const std::vector<uint8_t>& pixdata) {
+    std::vector<uint8_t> body;
+
+    // Frame offsets, pointing just past themselves
+    put_block_header(body, QGF_FRAME_OFFSET_DESCRIPTOR_TYPEID, 4);
+    put_u32(body, sizeof(qgf_graphics_descriptor_v1_t) + sizeof(qgf_frame_offsets_v1_t) + 4);
+
+    put_block_header(body, QGF_FRAME_DESCRIPTOR_TYPEID, 6);
+    body.push_back(fmt.format);
+    body.push_back(0);
+    body.push_back(compression);
+    body.push_back(0);
+    put_u16(body, 0);
+
+    if (fmt.has_palette) {
+        const int entries = 1 << fmt.bpp;
+        put_block_header(body, QGF_FRAME_PALETTE_DESCRIPTOR_TYPEID, entries * 3);
+        for (int i = 0; i < entries; ++i) {
+            body.push_back(i * 37);
+            body.push_back(255 - i * 11);
+            body.push_back(i * 73 + 20);
+        }
+    }
+
+    const std::vector<uint8_t> data = compression == IMAGE_COMPRESSED_RLE ? rle_encode(pixdata) : pixdata;
+    put_block_header(body, QGF_FRAME_DATA_DESCRIPTOR_TYPEID, data.size());
+    body.insert(body.end(), data.begin(), data.end());
+
+    std::vector<uint8_t> out;
+    uint32_t             total = sizeof(qgf_graphics_descriptor_v1_t) + body.size();
+    put_block_header(out, QGF_GRAPHICS_DESCRIPTOR_TYPEID, 18);
+    put_u24(out, QGF_MAGIC);
+    out.push_back(0x01);
+    put_u32(out, total);
+    put_u32(out, ~total);
+    put_u16(out, kWidth);
+    put_u16(out, kHeight);
+    put_u16(out, 1);
+    out.insert(out.end(), body.begin(), body.end());
+    return out;
+}
+
+} // namespace
+
+class PainterCodec : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(rgb565_surface(), QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(mono_surface(), QP_ROTATION_0));
+    }
+};
+
+TEST_F(PainterCodec, every_format_decodes_to_the_expected_pixels) {
+    const uint32_t pixel_count = kWidth * kHeight;
+
+    for (const auto& fmt : formats) {
+        for (painter_compression_t compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            SCOPED_TRACE(std::string(fmt.name) + (compression == IMAGE_COMPRESSED_RLE ? " rle" : " raw"));
+
+            std::vector<uint8_t> values = make_values(fmt.bpp <= 8 ? pixel_count : pixel_count * 2, fmt.bpp <= 8 ? (1 << fmt.bpp) - 1 : 255);
+            std::vector<uint8_t> qgf    = make_qgf(fmt, compression, fmt.bpp <= 8 ? pack_indices(values, fmt.bpp) : values);
+
+            painter_image_handle_t image = qp_load_image_mem(qgf.data());
+            ASSERT_NE(image, nullptr);
+
+            memset(rgb565_buffer(), 0x5A, kRgb565BufferSize);
+            ASSERT_TRUE(qp_drawimage(rgb565_surface(), 0, 0, image));
+            for (uint32_t i = 0; i < pixel_count; ++i) {
+                uint16_t expected = fmt.bpp <= 8 ? qp_internal_global_pixel_lookup_table[values[i]].rgb565 : (values[i * 2] | values[i * 2 + 1] << 8);
+                ASSERT_EQ(rgb565_buffer()[i], expected) << "pixel " << i;
+            }
+
+            // Monochrome surfaces can't take native pixels
+            if (fmt.bpp <= 8) {
+                memset(mono_buffer(), 0x5A, kMonoBufferSize);
+                ASSERT_TRUE(qp_drawimage(mono_surface(), 0, 0, image));
+                for (uint32_t i = 0; i < pixel_count; ++i) {
+                    uint8_t expected = qp_internal_global_pixel_lookup_table[values[i]].mono;
+                    ASSERT_EQ((mono_buffer()[i / 8] >> (i % 8)) & 1, expected) << "pixel " << i;
+                }
+            }
+
+            qp_close_image(image);
+        }
+    }
+}
+
+TEST_F(PainterCodec, text_renders_unchanged) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+
+    memset(rgb565_buffer(), 0, kRgb565BufferSize);
+    EXPECT_GT(qp_drawtext_recolor(rgb565_surface(), 0, 0, font, "Hello, World!", 0, 255, 255, 170, 255, 64), 0);
+    EXPECT_GT(qp_drawtext(rgb565_surface(), 2, 20, font, "0123456789 ~{}"), 0);
+    EXPECT_EQ(fnv1a((const uint8_t*)rgb565_buffer(), kRgb565BufferSize), 0x07B98931u);
+
+    qp_close_font(font);
+}
+
+TEST_F(PainterCodec, every_format_streams_to_a_panel) {
+    const uint32_t pixel_count = kWidth * kHeight;
+
+    for (const auto& fmt : formats) {
+        for (painter_compression_t compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+            std::vector<uint8_t> values = make_values(fmt.bpp <= 8 ? pixel_count : pixel_count * 2, fmt.bpp <= 8 ? (1 << fmt.bpp) - 1 : 255);
+            std::vector<uint8_t> qgf    = make_qgf(fmt, compression, fmt.bpp <= 8 ? pack_indices(values, fmt.bpp) : values);
+
+            painter_image_handle_t image = qp_load_image_mem(qgf.data());
+            ASSERT_NE(image, nullptr);
+            EXPECT_TRUE(qp_drawimage(&bench_panel, 0, 0, image)) << fmt.name << (compression == IMAGE_COMPRESSED_RLE ? " rle" : " raw");
+            qp_close_image(image);
+        }
+    }
+}
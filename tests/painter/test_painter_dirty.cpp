@@ -0,0 +1,167 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+#include <vector>
+
+#include "test_common.hpp"
+#include "painter_test_util.hpp"
+
+extern "C" {
+#include "qp_surface_internal.h"
+}
+
+namespace {
+
+// A typical 240x135 status display, plus a second one to copy into
+constexpr uint16_t kDashWidth  = 240;
+constexpr uint16_t kDashHeight = 135;
+
+surface_painter_device_t dash_table[2];
+
+uint16_t* dash_buffer() {
+    static uint16_t buffer[kDashWidth * kDashHeight];
+    return buffer;
+}
+
+uint16_t* copy_buffer() {
+    static uint16_t buffer[kDashWidth * kDashHeight];
+    return buffer;
+}
+
+painter_device_t dash_surface() {
+    static painter_device_t device = qp_make_rgb565_surface_advanced(dash_table, 2, kDashWidth, kDashHeight, dash_buffer());
+    return device;
+}
+
+painter_device_t copy_surface() {
+    static painter_device_t device = qp_make_rgb565_surface_advanced(dash_table, 2, kDashWidth, kDashHeight, copy_buffer());
+    return device;
+}
+
+struct widget {
+    uint16_t l, t, r, b;
+};
+
+struct layout {
+    const char*         name;
+    std::vector<widget> widgets;
+};
+
+const layout layouts[] = {
+    {"single widget", {{100, 50, 139, 69}}},
+    {"opposite corners", {{2, 2, 61, 17}, {178, 117, 237, 132}}},
+    {"status column", {{2, 2, 81, 13}, {2, 40, 81, 51}, {2, 80, 81, 91}}},
+    {"meter and clock", {{10, 60, 229, 67}, {90, 110, 149, 125}}},
+    {"five widgets", {{2, 2, 41, 13}, {198, 2, 237, 13}, {100, 60, 139, 71}, {2, 121, 41, 132}, {198, 121, 237, 132}}},
+};
+
+uint32_t bytes_sent = 0;
+
+uint32_t counting_comms_send(painter_device_t device, const void* data, uint32_t byte_count) {
+    bytes_sent += byte_count;
+    return byte_count;
+}
+
+constexpr uint32_t kViewportBytes = 11; // bench_panel's address commands
+
+uint32_t region_bytes(const widget& w) {
+    return ((uint32_t)w.r - w.l + 1) * ((uint32_t)w.b - w.t + 1) * sizeof(uint16_t) + kViewportBytes;
+}
+
+} // namespace
+
+class PainterDirty : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(dash_surface(), QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(copy_surface(), QP_ROTATION_0));
+
+        // Start each test with nothing dirty
+        ASSERT_TRUE(qp_surface_draw(dash_surface(), &bench_panel, 0, 0, false));
+
+        original_send                 = dummy_comms_vtable.comms_send;
+        dummy_comms_vtable.comms_send = counting_comms_send;
+        bytes_sent                    = 0;
+    }
+
+    void TearDown() override {
+        dummy_comms_vtable.comms_send = original_send;
+    }
+
+    void draw_widgets(const layout& l, uint8_t hue) {
+        for (const auto& w : l.widgets) {
+            qp_rect(dash_surface(), w.l, w.t, w.r, w.b, hue, 255, 255, true);
+        }
+    }
+
+    painter_driver_comms_send_func original_send;
+};
+
+TEST_F(PainterDirty, distant_widgets_are_separate_regions) {
+    const layout&             l    = layouts[1];
+    surface_painter_device_t* dash = (surface_painter_device_t*)dash_surface();
+    draw_widgets(l, 0);
+
+    ASSERT_EQ(dash->dirty.count, 2);
+    for (uint8_t i = 0; i < 2; ++i) {
+        const widget& w = l.widgets[i];
+        EXPECT_EQ(dash->dirty.rects[i].l, w.l);
+        EXPECT_EQ(dash->dirty.rects[i].t, w.t);
+        EXPECT_EQ(dash->dirty.rects[i].r, w.r);
+        EXPECT_EQ(dash->dirty.rects[i].b, w.b);
+    }
+}
+
+TEST_F(PainterDirty, nearby_pixels_share_a_region) {
+    surface_painter_device_t* dash = (surface_painter_device_t*)dash_surface();
+
+    // Outlines and scattered pixels close together end up in one region
+    qp_rect(dash_surface(), 20, 20, 59, 39, 0, 255, 255, false);
+    qp_setpixel(dash_surface(), 62, 30, 85, 255, 255);
+    qp_setpixel(dash_surface(), 40, 40, 85, 255, 255);
+    ASSERT_EQ(dash->dirty.count, 1);
+    EXPECT_EQ(dash->dirty.rects[0].l, 20);
+    EXPECT_EQ(dash->dirty.rects[0].t, 20);
+    EXPECT_EQ(dash->dirty.rects[0].r, 62);
+    EXPECT_EQ(dash->dirty.rects[0].b, 40);
+}
+
+TEST_F(PainterDirty, every_region_is_copied) {
+    for (const auto& l : layouts) {
+        SCOPED_TRACE(l.name);
+
+        ASSERT_TRUE(qp_surface_draw(dash_surface(), copy_surface(), 0, 0, true));
+        draw_widgets(l, 170);
+        ASSERT_TRUE(qp_surface_draw(dash_surface(), copy_surface(), 0, 0, false));
+        EXPECT_EQ(memcmp(dash_buffer(), copy_buffer(), kDashWidth * kDashHeight * sizeof(uint16_t)), 0);
+    }
+}
+
+TEST_F(PainterDirty, bytes_sent_for_dashboard_layouts) {
+    uint8_t hue = 0;
+    for (const auto& l : layouts) {
+        SCOPED_TRACE(l.name);
+
+        draw_widgets(l, hue += 40);
+        bytes_sent = 0;
+        ASSERT_TRUE(qp_surface_draw(dash_surface(), &bench_panel, 0, 0, false));
+
+        // What a single bounding box around every widget would have cost
+        widget   bounds = l.widgets[0];
+        uint32_t exact  = 0;
+        for (const auto& w : l.widgets) {
+            bounds.l = std::min(bounds.l, w.l);
+            bounds.t = std::min(bounds.t, w.t);
+            bounds.r = std::max(bounds.r, w.r);
+            bounds.b = std::max(bounds.b, w.b);
+            exact += region_bytes(w);
+        }
+
+        EXPECT_LE(bytes_sent, region_bytes(bounds));
+        if (l.widgets.size() <= SURFACE_DIRTY_REGION_COUNT) {
+            EXPECT_EQ(bytes_sent, exact);
+        }
+    }
+}
@@ -0,0 +1,170 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <algorithm>
+#include <cstring>
+
+#include "test_common.hpp"
+#include "painter_test_util.hpp"
+
+extern "C" {
+#include "qp_surface_internal.h"
+
+void qp_internal_task(void);
+}
+
+namespace {
+
+// Surfaces used as draw targets, kept out of the shared surface table
+surface_painter_device_t target_table[1];
+
+uint16_t* target_buffer() {
+    static uint16_t buffer[kWidth * kHeight];
+    return buffer;
+}
+
+painter_device_t target_surface() {
+    static painter_device_t device = qp_make_rgb565_surface_advanced(target_table, 1, kWidth, kHeight, target_buffer());
+    return device;
+}
+
+uint16_t* transfer_buffer() {
+    static uint16_t buffer[kWidth * kHeight];
+    return buffer;
+}
+
+struct flush_result {
+    int  calls   = 0;
+    bool success = false;
+};
+
+void record_flush(painter_device_t surface, painter_device_t target, bool success, void* cb_arg) {
+    flush_result* result = static_cast<flush_result*>(cb_arg);
+    result->calls++;
+    result->success = success;
+}
+
+} // namespace
+
+class PainterSurface : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(rgb565_surface(), QP_ROTATION_0));
+        ASSERT_TRUE(qp_init(target_surface(), QP_ROTATION_0));
+        ASSERT_TRUE(qp_surface_set_transfer_buffer(rgb565_surface(), nullptr));
+        memset(target_buffer(), 0, kRgb565BufferSize);
+    }
+
+    // Runs one pass of the main loop, which ticks Quantum Painter after the keyboard's tasks
+    void main_loop_pass() {
+        idle_for(1);
+        qp_internal_task();
+    }
+
+    // Runs the main loop until the surface's transfer completes, returning the number of milliseconds it took
+    int wait_for_flush(painter_device_t surface) {
+        int elapsed = 0;
+        while (qp_surface_flush_in_progress(surface) && elapsed < 1000) {
+            main_loop_pass();
+            elapsed++;
+        }
+        return elapsed;
+    }
+
+    // The main loop runs the keyboard's tasks too, which need a host driver to report to
+    TestDriver driver;
+};
+
+TEST_F(PainterSurface, async_draw_matches_sync_draw) {
+    qp_rect(rgb565_surface(), 5, 7, 40, 30, 0, 255, 255, true);
+    qp_circle(rgb565_surface(), 32, 24, 10, 85, 255, 255, true);
+
+    flush_result result;
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, true, record_flush, &result));
+    EXPECT_TRUE(qp_surface_flush_in_progress(rgb565_surface()));
+    EXPECT_EQ(result.calls, 0);
+
+    // 256 pixels a tick is four of the 64 pixel rows, so a 48 row surface takes 12 ticks
+    EXPECT_GT(wait_for_flush(rgb565_surface()), 1);
+    EXPECT_FALSE(qp_surface_flush_in_progress(rgb565_surface()));
+    EXPECT_EQ(result.calls, 1);
+    EXPECT_TRUE(result.success);
+    EXPECT_EQ(memcmp(target_buffer(), rgb565_buffer(), kRgb565BufferSize), 0);
+
+    // Only the dirty region goes out next time
+    memset(target_buffer(), 0, kRgb565BufferSize);
+    qp_rect(rgb565_surface(), 10, 10, 12, 12, 170, 255, 255, true);
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, false, record_flush, &result));
+    wait_for_flush(rgb565_surface());
+    EXPECT_EQ(result.calls, 2);
+    for (uint16_t y = 0; y < kHeight; ++y) {
+        for (uint16_t x = 0; x < kWidth; ++x) {
+            bool in_rect = x >= 10 && x <= 12 && y >= 10 && y <= 12;
+            ASSERT_EQ(target_buffer()[y * kWidth + x], in_rect ? rgb565_buffer()[y * kWidth + x] : 0) << x << "," << y;
+        }
+    }
+}
+
+TEST_F(PainterSurface, only_one_transfer_at_a_time) {
+    qp_rect(rgb565_surface(), 0, 0, 20, 20, 0, 255, 255, true);
+
+    flush_result result;
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, true, record_flush, &result));
+    EXPECT_FALSE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, true, record_flush, &result));
+    EXPECT_FALSE(qp_surface_draw(rgb565_surface(), target_surface(), 0, 0, true));
+    EXPECT_FALSE(qp_surface_set_transfer_buffer(rgb565_surface(), transfer_buffer()));
+
+    wait_for_flush(rgb565_surface());
+    EXPECT_EQ(result.calls, 1);
+
+    // With nothing dirty, the callback fires straight away
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, false, record_flush, &result));
+    EXPECT_FALSE(qp_surface_flush_in_progress(rgb565_surface()));
+    EXPECT_EQ(result.calls, 2);
+    EXPECT_TRUE(result.success);
+}
+
+TEST_F(PainterSurface, double_buffered_transfer_sends_the_queued_frame) {
+    ASSERT_TRUE(qp_surface_set_transfer_buffer(rgb565_surface(), transfer_buffer()));
+
+    qp_rect(rgb565_surface(), 0, 0, kWidth - 1, kHeight - 1, 0, 255, 255, true);
+    std::vector<uint16_t> frame(rgb565_buffer(), rgb565_buffer() + kWidth * kHeight);
+
+    flush_result result;
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, false, record_flush, &result));
+
+    // Draw the next frame while the first is still streaming out
+    main_loop_pass();
+    ASSERT_TRUE(qp_surface_flush_in_progress(rgb565_surface()));
+    qp_rect(rgb565_surface(), 8, 8, 23, 23, 85, 255, 255, true);
+
+    wait_for_flush(rgb565_surface());
+    EXPECT_EQ(result.calls, 1);
+    EXPECT_EQ(memcmp(target_buffer(), frame.data(), kRgb565BufferSize), 0);
+
+    // The next frame only carries what changed
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, false, record_flush, &result));
+    wait_for_flush(rgb565_surface());
+    EXPECT_EQ(result.calls, 2);
+    EXPECT_EQ(memcmp(target_buffer(), rgb565_buffer(), kRgb565BufferSize), 0);
+}
+
+TEST_F(PainterSurface, flush_is_spread_over_the_main_loop) {
+    const uint32_t pixel_count = kWidth * kHeight;
+    qp_rect(rgb565_surface(), 0, 0, kWidth - 1, kHeight - 1, 0, 255, 255, true);
+    ASSERT_TRUE(qp_surface_draw_async(rgb565_surface(), target_surface(), 0, 0, true, nullptr, nullptr));
+
+    // No pass of the main loop sends more than its share of the surface
+    uint32_t sent   = 0;
+    uint32_t passes = 0;
+    while (qp_surface_flush_in_progress(rgb565_surface()) && passes < 1000) {
+        main_loop_pass();
+        uint32_t now_sent = std::count_if(target_buffer(), target_buffer() + pixel_count, [](uint16_t pixel) { return pixel != 0; });
+        EXPECT_LE(now_sent - sent, (uint32_t)SURFACE_ASYNC_PIXELS_PER_TASK);
+        sent = now_sent;
+        passes++;
+    }
+
+    EXPECT_EQ(sent, pixel_count);
+    EXPECT_EQ(passes, (pixel_count + SURFACE_ASYNC_PIXELS_PER_TASK - 1) / SURFACE_ASYNC_PIXELS_PER_TASK);
+}
@@ -0,0 +1,181 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include "test_common.hpp"
+#include "painter_test_util.hpp"
+#include "painter_test_font.hpp"
+
+extern "C" {
+#include "thintel15.qff.h"
+}
+
+namespace {
+
+// A mix of ascii glyphs and unicode glyphs from either end and the middle of the table
+const std::vector<uint16_t> glyph_indices = {95, 33, 95 + kUnicodeGlyphs - 1, 0, 95 + kUnicodeGlyphs / 2, 94, 96, 95 + 123};
+
+std::vector<uint32_t> sample_code_points(const test_font& font) {
+    std::vector<uint32_t> code_points;
+    for (uint16_t index : glyph_indices) {
+        code_points.push_back(font.code_points[index]);
+    }
+    return code_points;
+}
+
+std::vector<uint16_t> snapshot() {
+    return std::vector<uint16_t>(rgb565_buffer(), rgb565_buffer() + kWidth * kHeight);
+}
+
+} // namespace
+
+class PainterText : public TestFixture {
+   protected:
+    void SetUp() override {
+        ASSERT_TRUE(qp_init(rgb565_surface(), QP_ROTATION_0));
+    }
+};
+
+TEST_F(PainterText, glyphs_decode_to_the_expected_pixels) {
+    for (painter_compression_t compression : {IMAGE_UNCOMPRESSED, IMAGE_COMPRESSED_RLE}) {
+        SCOPED_TRACE(compression == IMAGE_COMPRESSED_RLE ? "rle" : "raw");
+
+        test_font             font_data = make_font(compression, 1);
+        painter_font_handle_t font      = qp_load_font_mem(font_data.qff.data());
+        ASSERT_NE(font, nullptr);
+
+        std::string text           = utf8(sample_code_points(font_data));
+        int16_t     expected_width = 0;
+        for (uint16_t index : glyph_indices) {
+            expected_width += font_data.widths[index];
+        }
+        EXPECT_EQ(qp_textwidth(font, text.c_str()), expected_width);
+
+        memset(rgb565_buffer(), 0, kRgb565BufferSize);
+        ASSERT_EQ(qp_drawtext_recolor(rgb565_surface(), 0, 0, font, text.c_str(), 0, 255, 255, 85, 255, 64), expected_width);
+
+        uint16_t x = 0;
+        for (uint16_t index : glyph_indices) {
+            for (uint16_t y = 0; y < kLineHeight; ++y) {
+                for (uint16_t dx = 0; dx < font_data.widths[index]; ++dx) {
+                    uint8_t value = font_data.values[index][y * font_data.widths[index] + dx];
+                    ASSERT_EQ(rgb565_buffer()[y * kWidth + x + dx], qp_internal_global_pixel_lookup_table[value].rgb565) << "glyph " << index << " at " << dx << "," << y;
+                }
+            }
+            x += font_data.widths[index];
+        }
+
+        // Drawing it again, potentially from cached glyphs, gives the same result
+        std::vector<uint16_t> first = snapshot();
+        memset(rgb565_buffer(), 0, kRgb565BufferSize);
+        ASSERT_EQ(qp_drawtext_recolor(rgb565_surface(), 0, 0, font, text.c_str(), 0, 255, 255, 85, 255, 64), expected_width);
+        EXPECT_EQ(snapshot(), first);
+
+        qp_close_font(font);
+    }
+}
+
+TEST_F(PainterText, missing_code_point_is_not_drawn) {
+    test_font             font_data = make_font(IMAGE_UNCOMPRESSED, 1);
+    painter_font_handle_t font      = qp_load_font_mem(font_data.qff.data());
+    ASSERT_NE(font, nullptr);
+
+    EXPECT_EQ(qp_drawtext(rgb565_surface(), 0, 0, font, utf8({unicode_code_point(5) + 1}).c_str()), 0);
+    EXPECT_EQ(qp_drawtext(rgb565_surface(), 0, 0, font, utf8({unicode_code_point(kUnicodeGlyphs)}).c_str()), 0);
+    EXPECT_EQ(qp_drawtext(rgb565_surface(), 0, 0, font, utf8({0x7F}).c_str()), 0);
+
+    qp_close_font(font);
+}
+
+TEST_F(PainterText, colors_are_rendered_independently) {
+    test_font             font_data = make_font(IMAGE_COMPRESSED_RLE, 1);
+    painter_font_handle_t font      = qp_load_font_mem(font_data.qff.data());
+    ASSERT_NE(font, nullptr);
+    std::string text = utf8(sample_code_points(font_data));
+
+    memset(rgb565_buffer(), 0, kRgb565BufferSize);
+    qp_drawtext_recolor(rgb565_surface(), 0, 0, font, text.c_str(), 0, 255, 255, 85, 255, 64);
+    std::vector<uint16_t> red_on_green = snapshot();
+
+    qp_drawtext_recolor(rgb565_surface(), 0, 0, font, text.c_str(), 170, 255, 255, 0, 0, 0);
+    EXPECT_NE(snapshot(), red_on_green);
+
+    qp_drawtext_recolor(rgb565_surface(), 0, 0, font, text.c_str(), 0, 255, 255, 85, 255, 64);
+    EXPECT_EQ(snapshot(), red_on_green);
+
+    qp_close_font(font);
+}
+
+TEST_F(PainterText, reopened_font_slot_draws_the_new_font) {
+    test_font             first_data  = make_font(IMAGE_UNCOMPRESSED, 1);
+    test_font             second_data = make_font(IMAGE_UNCOMPRESSED, 1000);
+    painter_font_handle_t font        = qp_load_font_mem(first_data.qff.data());
+    ASSERT_NE(font, nullptr);
+    std::string text = utf8(sample_code_points(first_data));
+
+    memset(rgb565_buffer(), 0, kRgb565BufferSize);
+    qp_drawtext(rgb565_surface(), 0, 0, font, text.c_str());
+    std::vector<uint16_t> first = snapshot();
+    qp_close_font(font);
+
+    // Likely the same handle, but different glyphs
+    font = qp_load_font_mem(second_data.qff.data());
+    ASSERT_NE(font, nullptr);
+    qp_drawtext(rgb565_surface(), 0, 0, font, text.c_str());
+    std::vector<uint16_t> second = snapshot();
+    EXPECT_NE(second, first);
+    qp_close_font(font);
+
+    // Matches a fresh render of the second font
+    font = qp_load_font_mem(second_data.qff.data());
+    memset(rgb565_buffer(), 0, kRgb565BufferSize);
+    qp_drawtext(rgb565_surface(), 0, 0, font, text.c_str());
+    EXPECT_EQ(snapshot(), second);
+    qp_close_font(font);
+}
+
+TEST_F(PainterText, repeated_renders_are_unchanged) {
+    painter_font_handle_t font = qp_load_font_mem(font_thintel15);
+    ASSERT_NE(font, nullptr);
+
+    for (int i = 0; i < 3; ++i) {
+        memset(rgb565_buffer(), 0, kRgb565BufferSize);
+        EXPECT_GT(qp_drawtext_recolor(rgb565_surface(), 0, 0, font, "Hello, World!", 0, 255, 255, 170, 255, 64), 0);
+        EXPECT_GT(qp_drawtext(rgb565_surface(), 2, 20, font, "0123456789 ~{}"), 0);
+        EXPECT_EQ(fnv1a((const uint8_t*)rgb565_buffer(), kRgb565BufferSize), 0x07B98931u);
+    }
+
+    qp_close_font(font);
+}
+
+TEST_F(PainterText, text_streams_to_a_panel) {
+    painter_font_handle_t ascii_font   = qp_load_font_mem(font_thintel15);
+    test_font             unicode_data = make_font(IMAGE_COMPRESSED_RLE, 1);
+    painter_font_handle_t unicode_font = qp_load_font_mem(unicode_data.qff.data());
+    ASSERT_NE(ascii_font, nullptr);
+    ASSERT_NE(unicode_font, nullptr);
+
+    std::vector<uint32_t> unicode_code_points;
+    for (uint16_t i = 0; i < 12; ++i) {
+        unicode_code_points.push_back(unicode_code_point((i * 97) % kUnicodeGlyphs));
+    }
+
+    const struct {
+        const char*           name;
+        painter_font_handle_t font;
+        std::string           text;
+    } cases[] = {
+        {"ascii", ascii_font, "Layer: Base WPM: 123"},
+        {"unicode", unicode_font, utf8(unicode_code_points)},
+    };
+
+    for (const auto& c : cases) {
+        EXPECT_EQ(qp_drawtext_recolor(&bench_panel, 0, 0, c.font, c.text.c_str(), 0, 0, 255, 0, 0, 0), qp_textwidth(c.font, c.text.c_str())) << c.name;
+    }
+
+    qp_close_font(unicode_font);
+    qp_close_font(ascii_font);
+}
@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+GRAVE_ESC_ENABLE = yes
+TRI_LAYER_ENABLE = yes
+
+PROCESS_RECORD_LEGACY_DISPATCH = yes
+
+# Same checks, against the chain of process_record handlers
+TEST_SRC += ../test_process_record_dispatch.cpp
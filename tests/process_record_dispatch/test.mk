@@ -0,0 +1,5 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+GRAVE_ESC_ENABLE = yes
+TRI_LAYER_ENABLE = yes
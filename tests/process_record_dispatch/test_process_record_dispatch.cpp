@@ -0,0 +1,124 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <vector>
+
+using testing::_;
+using testing::InSequence;
+
+static std::vector<uint16_t> user_keycodes;
+static uint16_t              user_blocked_keycode = KC_NO;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    user_keycodes.push_back(keycode);
+    return keycode != user_blocked_keycode;
+}
+
+class ProcessRecordDispatch : public TestFixture {
+   protected:
+    void SetUp() override {
+        user_keycodes.clear();
+        user_blocked_keycode = KC_NO;
+    }
+};
+
+TEST_F(ProcessRecordDispatch, BasicKeycodeReachesAction) {
+    TestDriver driver;
+    KeymapKey  key_a = KeymapKey{0, 0, 0, KC_A};
+    set_keymap({key_a});
+
+    EXPECT_REPORT(driver, (KC_A));
+    key_a.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_a.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(user_keycodes, (std::vector<uint16_t>{KC_A, KC_A}));
+}
+
+TEST_F(ProcessRecordDispatch, RangeHandlersSeePressAndRelease) {
+    TestDriver driver;
+    KeymapKey  key_shift = KeymapKey{0, 0, 0, KC_LEFT_SHIFT};
+    KeymapKey  key_esc   = KeymapKey{0, 1, 0, QK_GRAVE_ESCAPE};
+    set_keymap({key_shift, key_esc});
+
+    EXPECT_REPORT(driver, (KC_ESCAPE));
+    key_esc.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EMPTY_REPORT(driver);
+    key_esc.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT, KC_GRAVE));
+        EXPECT_REPORT(driver, (KC_LEFT_SHIFT));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    key_shift.press();
+    run_one_scan_loop();
+    key_esc.press();
+    run_one_scan_loop();
+    key_esc.release();
+    run_one_scan_loop();
+    key_shift.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ProcessRecordDispatch, UserRunsBeforeRangeHandlers) {
+    TestDriver driver;
+    KeymapKey  key_esc   = KeymapKey{0, 0, 0, QK_GRAVE_ESCAPE};
+    KeymapKey  key_lower = KeymapKey{0, 1, 0, QK_TRI_LAYER_LOWER};
+    set_keymap({key_esc, key_lower});
+
+    user_blocked_keycode = QK_GRAVE_ESCAPE;
+    EXPECT_NO_REPORT(driver);
+    tap_key(key_esc);
+    VERIFY_AND_CLEAR(driver);
+
+    user_blocked_keycode = QK_TRI_LAYER_LOWER;
+    key_lower.press();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    key_lower.release();
+    run_one_scan_loop();
+
+    user_blocked_keycode = KC_NO;
+    key_lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    key_lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_EQ(user_keycodes, (std::vector<uint16_t>{QK_GRAVE_ESCAPE, QK_GRAVE_ESCAPE, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_LOWER, QK_TRI_LAYER_LOWER}));
+}
+
+TEST_F(ProcessRecordDispatch, HandledKeycodesStopTheChain) {
+    TestDriver driver;
+    KeymapKey  key_lower = KeymapKey{0, 0, 0, QK_TRI_LAYER_LOWER};
+    // Layer 1 is only reachable through the tri layer handler
+    set_keymap({key_lower, KeymapKey{1, 0, 0, KC_TRNS}});
+
+    EXPECT_NO_REPORT(driver);
+    key_lower.press();
+    run_one_scan_loop();
+    EXPECT_TRUE(layer_state_is(get_tri_layer_lower_layer()));
+    key_lower.release();
+    run_one_scan_loop();
+    EXPECT_FALSE(layer_state_is(get_tri_layer_lower_layer()));
+    VERIFY_AND_CLEAR(driver);
+}
@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+SRC += ../led_config.c ../rgb_matrix_mock.c
+
+# Same effects as the uncached runners, rendered from the geometry cache
+TEST_SRC += ../test_rgb_matrix_effects.cpp
@@ -0,0 +1,42 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+extern "C" {
+// The EEPROM config layout is asserted with the C11 spelling
+#define _Static_assert static_assert
+#include "rgb_matrix.h"
+#undef _Static_assert
+#include "lib/lib8tion/lib8tion.h"
+
+extern const led_point_t k_rgb_matrix_center;
+}
+#include "test_common.h"
+#include "test_fixture.hpp"
+
+class GeometryCache : public TestFixture {};
+
+TEST_F(GeometryCache, geometry_matches_led_config) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        int16_t dx = g_led_config.point[i].x - k_rgb_matrix_center.x;
+        int16_t dy = g_led_config.point[i].y - k_rgb_matrix_center.y;
+
+        EXPECT_EQ(g_led_geometry[i].dx, dx) << "LED " << +i;
+        EXPECT_EQ(g_led_geometry[i].dy, dy) << "LED " << +i;
+        EXPECT_EQ(g_led_geometry[i].dist, sqrt16(dx * dx + dy * dy)) << "LED " << +i;
+        EXPECT_EQ(g_led_geometry[i].angle, atan2_8(dy, dx)) << "LED " << +i;
+    }
+}
+
+TEST_F(GeometryCache, geometry_follows_led_config_updates) {
+    led_point_t point = g_led_config.point[0];
+
+    g_led_config.point[0] = k_rgb_matrix_center;
+    rgb_matrix_update_geometry();
+    EXPECT_EQ(g_led_geometry[0].dx, 0);
+    EXPECT_EQ(g_led_geometry[0].dy, 0);
+    EXPECT_EQ(g_led_geometry[0].dist, 0);
+
+    g_led_config.point[0] = point;
+    rgb_matrix_update_geometry();
+    EXPECT_EQ(g_led_geometry[0].dx, point.x - k_rgb_matrix_center.x);
+}
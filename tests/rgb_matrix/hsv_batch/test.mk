@@ -0,0 +1,11 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+CIE1931_CURVE = yes
+
+SRC += ../led_config.c ../rgb_matrix_mock.c
+
+# Same effects as the per LED conversion, with each scanline converted in one go
+TEST_SRC += ../test_rgb_matrix_effects.cpp
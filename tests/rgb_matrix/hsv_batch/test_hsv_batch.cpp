@@ -0,0 +1,64 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <vector>
+
+extern "C" {
+// The EEPROM config layout is asserted with the C11 spelling
+#define _Static_assert static_assert
+#include "rgb_matrix.h"
+#undef _Static_assert
+}
+#include "test_common.h"
+#include "test_fixture.hpp"
+
+class HsvBatch : public TestFixture {};
+
+static bool same_rgb(RGB a, RGB b) {
+    return a.r == b.r && a.g == b.g && a.b == b.b;
+}
+
+TEST_F(HsvBatch, batch_matches_hsv_to_rgb_for_every_color) {
+    HSV hsv[256];
+    RGB rgb[256];
+    RGB rgb_nocie[256];
+
+    for (uint16_t h = 0; h < 256; h++) {
+        for (uint16_t s = 0; s < 256; s++) {
+            for (uint16_t v = 0; v < 256; v++) {
+                hsv[v] = {static_cast<uint8_t>(h), static_cast<uint8_t>(s), static_cast<uint8_t>(v)};
+            }
+            hsv_to_rgb_batch(hsv, rgb, 256);
+            hsv_to_rgb_nocie_batch(hsv, rgb_nocie, 256);
+
+            for (uint16_t v = 0; v < 256; v++) {
+                ASSERT_TRUE(same_rgb(rgb[v], hsv_to_rgb(hsv[v]))) << "HSV " << h << "," << s << "," << v;
+                ASSERT_TRUE(same_rgb(rgb_nocie[v], hsv_to_rgb_nocie(hsv[v]))) << "HSV " << h << "," << s << "," << v << " (no CIE)";
+            }
+        }
+    }
+}
+
+TEST_F(HsvBatch, batch_handles_repeated_colors) {
+    const HSV hsv[] = {{HSV_RED}, {HSV_RED}, {HSV_BLUE}, {HSV_BLUE}, {HSV_RED}, {HSV_WHITE}, {HSV_WHITE}};
+    RGB       rgb[7];
+
+    hsv_to_rgb_batch(hsv, rgb, 7);
+    for (uint8_t i = 0; i < 7; i++) {
+        EXPECT_TRUE(same_rgb(rgb[i], hsv_to_rgb(hsv[i]))) << "index " << +i;
+    }
+}
+
+TEST_F(HsvBatch, batch_matches_hsv_to_rgb_for_a_rainbow) {
+    std::vector<HSV> hsv;
+    for (uint32_t i = 0; i < 4096; i++) {
+        // A slowly moving rainbow, so that neighbors differ like they do in most effects
+        hsv.push_back({static_cast<uint8_t>(i * 7), static_cast<uint8_t>(255 - (i % 64)), static_cast<uint8_t>(i * 13)});
+    }
+    std::vector<RGB> rgb(hsv.size());
+
+    hsv_to_rgb_batch(hsv.data(), rgb.data(), hsv.size());
+    for (size_t i = 0; i < hsv.size(); i++) {
+        ASSERT_TRUE(same_rgb(rgb[i], hsv_to_rgb(hsv[i]))) << "index " << i;
+    }
+}
@@ -0,0 +1,25 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+
+typedef int16_t i2c_status_t;
+
+#define I2C_STATUS_SUCCESS (0)
+#define I2C_STATUS_ERROR (-1)
+#define I2C_STATUS_TIMEOUT (-2)
+
+void         i2c_init(void);
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout);
+
+// Bus traffic since the last reset, bytes include the device and register address of every write
+typedef struct {
+    uint32_t writes;
+    uint32_t bytes;
+} i2c_mock_stats_t;
+
+extern i2c_mock_stats_t i2c_mock_stats;
+
+void i2c_mock_reset(void);
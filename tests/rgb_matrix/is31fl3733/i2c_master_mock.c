@@ -0,0 +1,18 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "i2c_master.h"
+
+i2c_mock_stats_t i2c_mock_stats;
+
+void i2c_mock_reset(void) {
+    i2c_mock_stats = (i2c_mock_stats_t){0};
+}
+
+void i2c_init(void) {}
+
+i2c_status_t i2c_write_register(uint8_t devaddr, uint8_t regaddr, const uint8_t* data, uint16_t length, uint16_t timeout) {
+    i2c_mock_stats.writes++;
+    i2c_mock_stats.bytes += 2 + length;
+    return I2C_STATUS_SUCCESS;
+}
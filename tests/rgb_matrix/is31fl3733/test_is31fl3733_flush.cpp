@@ -0,0 +1,126 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+extern "C" {
+// The EEPROM config layout is asserted with the C11 spelling
+#define _Static_assert static_assert
+#include "rgb_matrix.h"
+#undef _Static_assert
+#include "i2c_master.h"
+
+void advance_time(uint32_t ms);
+}
+#include "test_common.h"
+#include "test_fixture.hpp"
+
+// Each row of the test matrix takes three SW lines, one per color, with the columns on CS1-CS10
+#define LED(row, col) {0, (3 * (row) + 0) * 16 + (col), (3 * (row) + 1) * 16 + (col), (3 * (row) + 2) * 16 + (col)}
+
+// clang-format off
+extern "C" const is31fl3733_led_t PROGMEM g_is31fl3733_leds[IS31FL3733_LED_COUNT] = {
+    LED(0, 0), LED(0, 1), LED(0, 2), LED(0, 3), LED(0, 4), LED(0, 5), LED(0, 6), LED(0, 7), LED(0, 8), LED(0, 9),
+    LED(1, 0), LED(1, 1), LED(1, 2), LED(1, 3), LED(1, 4), LED(1, 5), LED(1, 6), LED(1, 7), LED(1, 8), LED(1, 9),
+    LED(2, 0), LED(2, 1), LED(2, 2), LED(2, 3), LED(2, 4), LED(2, 5), LED(2, 6), LED(2, 7), LED(2, 8), LED(2, 9),
+    LED(3, 0), LED(3, 1), LED(3, 2), LED(3, 3), LED(3, 4), LED(3, 5), LED(3, 6), LED(3, 7), LED(3, 8), LED(3, 9)
+};
+// clang-format on
+
+// Selecting the PWM page takes two single byte register writes
+static const uint32_t page_select_bytes = 2 * 3;
+static const uint32_t block_bytes       = 2 + 16;
+static const uint32_t full_flush_bytes  = page_select_bytes + 12 * block_bytes;
+
+static uint32_t frames = 0;
+
+extern "C" bool rgb_matrix_indicators_user(void) {
+    frames++;
+    return true;
+}
+
+class IS31FL3733Flush : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+    }
+
+    // Renders and flushes the given number of frames, tapping a key every few of them
+    void render_frames(uint32_t count, bool typing = false) {
+        uint32_t last = frames + count;
+        for (uint32_t tick = 0; frames < last; tick++) {
+            if (typing && tick % 50 == 0) {
+                uint8_t key = tick / 50;
+                rgb_matrix_handle_key_event(key % MATRIX_ROWS, key % MATRIX_COLS, true);
+                rgb_matrix_handle_key_event(key % MATRIX_ROWS, key % MATRIX_COLS, false);
+            }
+            rgb_matrix_task();
+            advance_time(1);
+        }
+        // Let the flush of the last frame through
+        rgb_matrix_task();
+    }
+};
+
+TEST_F(IS31FL3733Flush, static_effect_is_not_retransmitted) {
+    rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+    render_frames(10);
+
+    i2c_mock_reset();
+    render_frames(100);
+    EXPECT_EQ(i2c_mock_stats.bytes, 0u);
+}
+
+TEST_F(IS31FL3733Flush, only_changed_blocks_are_transmitted) {
+    is31fl3733_set_color_all(0, 0, 0);
+    is31fl3733_flush();
+
+    // The red, green and blue registers of one LED live in three different blocks
+    i2c_mock_reset();
+    is31fl3733_set_color(12, 10, 20, 30);
+    is31fl3733_flush();
+    EXPECT_EQ(i2c_mock_stats.bytes, page_select_bytes + 3 * block_bytes);
+
+    i2c_mock_reset();
+    is31fl3733_set_color(12, 10, 40, 30);
+    is31fl3733_flush();
+    EXPECT_EQ(i2c_mock_stats.bytes, page_select_bytes + block_bytes);
+
+    i2c_mock_reset();
+    is31fl3733_set_color_all(1, 1, 1);
+    is31fl3733_flush();
+    EXPECT_EQ(i2c_mock_stats.bytes, full_flush_bytes);
+
+    i2c_mock_reset();
+    is31fl3733_set_color(12, 1, 1, 1);
+    is31fl3733_flush();
+    EXPECT_EQ(i2c_mock_stats.bytes, 0u);
+}
+
+TEST_F(IS31FL3733Flush, bytes_per_frame) {
+    static const struct {
+        const char *name;
+        uint8_t     mode;
+        bool        typing;
+    } runs[] = {
+        {"SOLID_COLOR", RGB_MATRIX_SOLID_COLOR, false},
+        {"SOLID_REACTIVE_SIMPLE", RGB_MATRIX_SOLID_REACTIVE_SIMPLE, true},
+        {"SPLASH", RGB_MATRIX_SPLASH, true},
+        {"BREATHING", RGB_MATRIX_BREATHING, false},
+        {"CYCLE_LEFT_RIGHT", RGB_MATRIX_CYCLE_LEFT_RIGHT, false},
+    };
+    const uint32_t count = 500;
+
+    for (auto &run : runs) {
+        rgb_matrix_mode_noeeprom(run.mode);
+        render_frames(10, run.typing);
+
+        i2c_mock_reset();
+        render_frames(count, run.typing);
+        EXPECT_LE(i2c_mock_stats.bytes, count * full_flush_bytes) << run.name;
+        if (run.mode == RGB_MATRIX_SOLID_COLOR) {
+            // Nothing changes once the first frame is out
+            EXPECT_EQ(i2c_mock_stats.bytes, 0u) << run.name;
+        }
+    }
+}
@@ -0,0 +1,27 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+
+#define X(col) ((col) * 224 / (MATRIX_COLS - 1))
+#define Y(row) ((row) * 64 / (MATRIX_ROWS - 1))
+
+// One LED under each key of the 4x10 test matrix, spread evenly over the whole LED area
+// clang-format off
+led_config_t g_led_config = { {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9 },
+    { 10, 11, 12, 13, 14, 15, 16, 17, 18, 19 },
+    { 20, 21, 22, 23, 24, 25, 26, 27, 28, 29 },
+    { 30, 31, 32, 33, 34, 35, 36, 37, 38, 39 }
+}, {
+    { X(0), Y(0) }, { X(1), Y(0) }, { X(2), Y(0) }, { X(3), Y(0) }, { X(4), Y(0) }, { X(5), Y(0) }, { X(6), Y(0) }, { X(7), Y(0) }, { X(8), Y(0) }, { X(9), Y(0) },
+    { X(0), Y(1) }, { X(1), Y(1) }, { X(2), Y(1) }, { X(3), Y(1) }, { X(4), Y(1) }, { X(5), Y(1) }, { X(6), Y(1) }, { X(7), Y(1) }, { X(8), Y(1) }, { X(9), Y(1) },
+    { X(0), Y(2) }, { X(1), Y(2) }, { X(2), Y(2) }, { X(3), Y(2) }, { X(4), Y(2) }, { X(5), Y(2) }, { X(6), Y(2) }, { X(7), Y(2) }, { X(8), Y(2) }, { X(9), Y(2) },
+    { X(0), Y(3) }, { X(1), Y(3) }, { X(2), Y(3) }, { X(3), Y(3) }, { X(4), Y(3) }, { X(5), Y(3) }, { X(6), Y(3) }, { X(7), Y(3) }, { X(8), Y(3) }, { X(9), Y(3) }
+}, {
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 4, 4, 4, 4, 4, 4, 4, 4, 1,
+    1, 1, 1, 4, 4, 4, 4, 1, 1, 1
+} };
+// clang-format on
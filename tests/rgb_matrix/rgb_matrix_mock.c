@@ -0,0 +1,40 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "rgb_matrix.h"
+#include "rgb_matrix_mock.h"
+
+RGB      rgb_matrix_mock_leds[RGB_MATRIX_LED_COUNT];
+uint32_t rgb_matrix_mock_flushes;
+
+void rgb_matrix_mock_reset(void) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        rgb_matrix_mock_leds[i] = (RGB){0};
+    }
+    rgb_matrix_mock_flushes = 0;
+}
+
+static void mock_init(void) {
+    rgb_matrix_mock_reset();
+}
+
+static void mock_set_color(int index, uint8_t r, uint8_t g, uint8_t b) {
+    rgb_matrix_mock_leds[index] = (RGB){.r = r, .g = g, .b = b};
+}
+
+static void mock_set_color_all(uint8_t r, uint8_t g, uint8_t b) {
+    for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+        mock_set_color(i, r, g, b);
+    }
+}
+
+static void mock_flush(void) {
+    rgb_matrix_mock_flushes++;
+}
+
+const rgb_matrix_driver_t rgb_matrix_driver = {
+    .init          = mock_init,
+    .set_color     = mock_set_color,
+    .set_color_all = mock_set_color_all,
+    .flush         = mock_flush,
+};
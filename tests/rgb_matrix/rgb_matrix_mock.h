@@ -0,0 +1,13 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include <stdint.h>
+#include "color.h"
+
+// LED colors as last set through the driver, along with the number of flushes since the last reset
+extern RGB      rgb_matrix_mock_leds[];
+extern uint32_t rgb_matrix_mock_flushes;
+
+void rgb_matrix_mock_reset(void);
@@ -0,0 +1,59 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+extern "C" {
+// The EEPROM config layout is asserted with the C11 spelling
+#define _Static_assert static_assert
+#include "rgb_matrix.h"
+#undef _Static_assert
+#include "rgb_matrix_mock.h"
+
+void advance_time(uint32_t ms);
+}
+#include "test_common.h"
+#include "test_fixture.hpp"
+
+static const char *const effect_names[] = {
+    "NONE",
+#define RGB_MATRIX_EFFECT(name) #name,
+#include "rgb_matrix_effects.inc"
+#undef RGB_MATRIX_EFFECT
+};
+
+class RgbMatrixEffects : public TestFixture {
+   protected:
+    void SetUp() override {
+        rgb_matrix_enable_noeeprom();
+        rgb_matrix_sethsv_noeeprom(HSV_RED);
+        rgb_matrix_set_speed_noeeprom(RGB_MATRIX_DEFAULT_SPD);
+    }
+
+    // Runs the task until the effect has been rendered and flushed the given number of times,
+    // pressing a key now and then so that the reactive effects have something to show
+    void render_frames(uint32_t frames) {
+        rgb_matrix_mock_reset();
+        for (uint32_t tick = 0; rgb_matrix_mock_flushes < frames; tick++) {
+            if (tick % 50 == 0) {
+                uint8_t key = tick / 50;
+                rgb_matrix_handle_key_event(key % MATRIX_ROWS, key % MATRIX_COLS, true);
+                rgb_matrix_handle_key_event(key % MATRIX_ROWS, key % MATRIX_COLS, false);
+            }
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+};
+
+TEST_F(RgbMatrixEffects, every_effect_lights_leds) {
+    for (uint8_t mode = 1; mode < RGB_MATRIX_EFFECT_MAX; mode++) {
+        rgb_matrix_mode_noeeprom(mode);
+        render_frames(100);
+
+        bool lit = false;
+        for (uint8_t i = 0; i < RGB_MATRIX_LED_COUNT; i++) {
+            RGB rgb = rgb_matrix_mock_leds[i];
+            lit |= rgb.r || rgb.g || rgb.b;
+        }
+        EXPECT_TRUE(lit) << effect_names[mode];
+    }
+}
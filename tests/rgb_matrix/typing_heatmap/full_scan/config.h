@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../../config.h"
+
+// Opts out of the neighbor table, every keypress scans the whole matrix
+#define RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH 0
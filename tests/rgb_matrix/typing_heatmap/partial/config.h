@@ -0,0 +1,9 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "../../config.h"
+
+// Too small for the test layout, the keys that don't fit scan the whole matrix
+#define RGB_MATRIX_TYPING_HEATMAP_NEIGHBORS_LENGTH 64
@@ -0,0 +1,10 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+RGB_MATRIX_ENABLE = yes
+RGB_MATRIX_DRIVER = custom
+
+SRC += ../../led_config.c ../../rgb_matrix_mock.c
+
+# Same expectations as with the neighbor table, when only part of it fits
+TEST_SRC += ../test_typing_heatmap.cpp
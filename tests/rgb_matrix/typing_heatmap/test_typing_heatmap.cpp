@@ -0,0 +1,129 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include <cstring>
+#include <random>
+
+extern "C" {
+// The EEPROM config layout is asserted with the C11 spelling
+#define _Static_assert static_assert
+#include "rgb_matrix.h"
+#undef _Static_assert
+#include "lib/lib8tion/lib8tion.h"
+
+void process_rgb_matrix_typing_heatmap(uint8_t row, uint8_t col);
+void advance_time(uint32_t ms);
+}
+#include "test_common.h"
+#include "test_fixture.hpp"
+
+#ifndef RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP
+#    define RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP 32
+#endif
+#ifndef RGB_MATRIX_TYPING_HEATMAP_SPREAD
+#    define RGB_MATRIX_TYPING_HEATMAP_SPREAD 40
+#endif
+#ifndef RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT
+#    define RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT 16
+#endif
+
+static uint8_t reference_frame_buffer[MATRIX_ROWS][MATRIX_COLS];
+
+// The keypress handling as it was before the neighbor table, scanning every key of the matrix
+static void reference_typing_heatmap(uint8_t row, uint8_t col) {
+    if (g_led_config.matrix_co[row][col] == NO_LED) {
+        return;
+    }
+    for (uint8_t i_row = 0; i_row < MATRIX_ROWS; i_row++) {
+        for (uint8_t i_col = 0; i_col < MATRIX_COLS; i_col++) {
+            if (g_led_config.matrix_co[i_row][i_col] == NO_LED) {
+                continue;
+            }
+            if (i_row == row && i_col == col) {
+                reference_frame_buffer[row][col] = qadd8(reference_frame_buffer[row][col], RGB_MATRIX_TYPING_HEATMAP_INCREASE_STEP);
+            } else {
+#define LED_DISTANCE(led_a, led_b) sqrt16(((int16_t)(led_a.x - led_b.x) * (int16_t)(led_a.x - led_b.x)) + ((int16_t)(led_a.y - led_b.y) * (int16_t)(led_a.y - led_b.y)))
+                uint8_t distance = LED_DISTANCE(g_led_config.point[g_led_config.matrix_co[row][col]], g_led_config.point[g_led_config.matrix_co[i_row][i_col]]);
+#undef LED_DISTANCE
+                if (distance <= RGB_MATRIX_TYPING_HEATMAP_SPREAD) {
+                    uint8_t amount = qsub8(RGB_MATRIX_TYPING_HEATMAP_SPREAD, distance);
+                    if (amount > RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT) {
+                        amount = RGB_MATRIX_TYPING_HEATMAP_AREA_LIMIT;
+                    }
+                    reference_frame_buffer[i_row][i_col] = qadd8(reference_frame_buffer[i_row][i_col], amount);
+                }
+            }
+        }
+    }
+}
+
+class TypingHeatmap : public TestFixture {
+   protected:
+    void SetUp() override {
+        memcpy(&saved_led_config, &g_led_config, sizeof(led_config_t));
+        rgb_matrix_enable_noeeprom();
+        restart_effect();
+    }
+
+    void TearDown() override {
+        memcpy(&g_led_config, &saved_led_config, sizeof(led_config_t));
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        render_frame();
+    }
+
+    void render_frame() {
+        for (int i = 0; i < 8; i++) {
+            rgb_matrix_task();
+            advance_time(1);
+        }
+    }
+
+    // Runs the effect init, which clears the heatmap and picks up layout changes
+    void restart_effect() {
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_SOLID_COLOR);
+        render_frame();
+        rgb_matrix_mode_noeeprom(RGB_MATRIX_TYPING_HEATMAP);
+        render_frame();
+        memset(g_rgb_frame_buffer, 0, sizeof(g_rgb_frame_buffer));
+        memset(reference_frame_buffer, 0, sizeof(reference_frame_buffer));
+    }
+
+    void press_and_compare(uint8_t row, uint8_t col) {
+        process_rgb_matrix_typing_heatmap(row, col);
+        reference_typing_heatmap(row, col);
+        ASSERT_EQ(memcmp(g_rgb_frame_buffer, reference_frame_buffer, sizeof(reference_frame_buffer)), 0) << "after pressing " << +row << "," << +col;
+    }
+
+    led_config_t saved_led_config;
+};
+
+TEST_F(TypingHeatmap, every_key_matches_full_scan) {
+    for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            press_and_compare(row, col);
+        }
+    }
+}
+
+TEST_F(TypingHeatmap, random_typing_matches_full_scan) {
+    std::mt19937 rng(8);
+    for (int i = 0; i < 2000; i++) {
+        press_and_compare(rng() % MATRIX_ROWS, rng() % MATRIX_COLS);
+        if (HasFatalFailure()) return;
+    }
+}
+
+TEST_F(TypingHeatmap, layout_changes_match_full_scan) {
+    // Keys without LEDs, and LEDs moved closer together than the regular grid
+    g_led_config.matrix_co[0][0] = NO_LED;
+    g_led_config.matrix_co[2][5] = NO_LED;
+    g_led_config.point[12]       = g_led_config.point[13];
+    g_led_config.point[33].x     = g_led_config.point[34].x - 5;
+    restart_effect();
+
+    std::mt19937 rng(3);
+    for (int i = 0; i < 1000; i++) {
+        press_and_compare(rng() % MATRIX_ROWS, rng() % MATRIX_COLS);
+        if (HasFatalFailure()) return;
+    }
+}
@@ -0,0 +1,12 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#pragma once
+
+#include "test_common.h"
+
+// Scan a large matrix, as found on some custom boards
+#undef MATRIX_ROWS
+#undef MATRIX_COLS
+#define MATRIX_ROWS 24
+#define MATRIX_COLS 24
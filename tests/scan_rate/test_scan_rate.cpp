@@ -0,0 +1,90 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keycode.h"
+#include "test_common.hpp"
+
+extern "C" {
+#include "matrix.h"
+}
+
+using testing::_;
+
+static const uint32_t scan_count = 2000;
+static uint32_t       key_events = 0;
+
+extern "C" bool process_record_user(uint16_t keycode, keyrecord_t *record) {
+    key_events++;
+    return true;
+}
+
+class ScanRate : public TestFixture {
+   protected:
+    void SetUp() override {
+        for (uint8_t row = 0; row < MATRIX_ROWS; row++) {
+            for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+                add_key(KeymapKey(0, col, row, KC_NO));
+            }
+        }
+        key_events = 0;
+    }
+
+    /**
+     * @brief Runs `scan_count` keyboard task loops, calling `toggle` before
+     * each one.
+     */
+    template <typename F>
+    void run_scans(F toggle) {
+        for (uint32_t scan = 0; scan < scan_count; scan++) {
+            toggle(scan);
+            run_one_scan_loop();
+        }
+    }
+};
+
+TEST_F(ScanRate, IdleMatrix) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    run_scans([](uint32_t scan) {});
+
+    EXPECT_EQ(key_events, 0);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanRate, SingleKeyChangePerScan) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    run_scans([](uint32_t scan) {
+        const uint8_t col = scan / 2 % MATRIX_COLS;
+        const uint8_t row = scan / 2 / MATRIX_COLS % MATRIX_ROWS;
+        if (scan % 2) {
+            release_key(col, row);
+        } else {
+            press_key(col, row);
+        }
+    });
+
+    EXPECT_EQ(key_events, scan_count);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(ScanRate, FullRowChangePerScan) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    run_scans([](uint32_t scan) {
+        const uint8_t row = scan / 2 % MATRIX_ROWS;
+        for (uint8_t col = 0; col < MATRIX_COLS; col++) {
+            if (scan % 2) {
+                release_key(col, row);
+            } else {
+                press_key(col, row);
+            }
+        }
+    });
+
+    EXPECT_EQ(key_events, scan_count * MATRIX_COLS);
+    VERIFY_AND_CLEAR(driver);
+}
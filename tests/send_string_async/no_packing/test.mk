@@ -0,0 +1,7 @@
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+
+SEND_STRING_ASYNC_ENABLE = yes
+
+# Same checks, with each step of a character in its own report
+TEST_SRC += ../test_send_string_async.cpp
@@ -0,0 +1,188 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+extern "C" {
+#include "send_string.h"
+}
+
+using testing::_;
+using testing::InSequence;
+
+class SendStringAsync : public TestFixture {};
+
+TEST_F(SendStringAsync, ReturnsBeforeTyping) {
+    TestDriver driver;
+
+    EXPECT_NO_REPORT(driver);
+    SEND_STRING("ab");
+    EXPECT_TRUE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+        EXPECT_EMPTY_REPORT(driver);
+#endif
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, ShiftedCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_A));
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_REPORT(driver, (KC_LSFT));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+#else
+    // Shift stays held between shifted characters, and is let go along with the last of them
+    EXPECT_REPORT(driver, (KC_LSFT, KC_B));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_C));
+    EXPECT_EMPTY_REPORT(driver);
+#endif
+    SEND_STRING("ABc");
+    idle_for(20);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, RepeatedCharacters) {
+    TestDriver driver;
+    InSequence s;
+
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    EXPECT_REPORT(driver, (KC_A));
+    EXPECT_EMPTY_REPORT(driver);
+    SEND_STRING("aa");
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, CodesAndDelays) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_ENTER));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING(SS_TAP(X_ENTER) SS_DELAY(10) "a");
+    idle_for(5);
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_A));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, KeepsScanningWhileTyping) {
+    TestDriver driver;
+    KeymapKey  key_x(0, 0, 0, KC_X);
+    set_keymap({key_x});
+
+    SEND_STRING("abc");
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_REPORT(driver, (KC_X, KC_A));
+    }
+    key_x.press();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+        EXPECT_REPORT(driver, (KC_X));
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_B));
+#else
+        EXPECT_REPORT(driver, (KC_X, KC_B));
+        EXPECT_REPORT(driver, (KC_B));
+        EXPECT_REPORT(driver, (KC_C));
+#endif
+    }
+    run_one_scan_loop();
+    key_x.release();
+    run_one_scan_loop();
+    VERIFY_AND_CLEAR(driver);
+
+    EXPECT_ANY_REPORT(driver).Times(testing::AnyNumber());
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, OverflowTypesOutQueued) {
+    TestDriver driver;
+    InSequence s;
+
+    // Longer than the queue, so some of it gets typed before send_string() returns
+    const char *text = "abcdefghijklmnopqrstuvwxyzabcdefghijklmn";
+    for (const char *c = text; *c; c++) {
+        EXPECT_REPORT(driver, (KC_A + (*c - 'a')));
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+        EXPECT_EMPTY_REPORT(driver);
+#endif
+    }
+#ifndef SEND_STRING_ASYNC_NO_PACKING
+    EXPECT_EMPTY_REPORT(driver);
+#endif
+    send_string(text);
+    EXPECT_TRUE(send_string_async_busy());
+    idle_for(100);
+    VERIFY_AND_CLEAR(driver);
+}
+
+TEST_F(SendStringAsync, WaitAndCancel) {
+    TestDriver driver;
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LSFT, KC_H));
+#ifdef SEND_STRING_ASYNC_NO_PACKING
+        EXPECT_REPORT(driver, (KC_LSFT));
+#endif
+        EXPECT_EMPTY_REPORT(driver);
+        EXPECT_REPORT(driver, (KC_I));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING("Hi");
+    send_string_async_wait();
+    EXPECT_FALSE(send_string_async_busy());
+    VERIFY_AND_CLEAR(driver);
+
+    {
+        InSequence s;
+        EXPECT_REPORT(driver, (KC_LSFT));
+        EXPECT_REPORT(driver, (KC_LSFT, KC_X));
+        EXPECT_EMPTY_REPORT(driver);
+    }
+    SEND_STRING("XYZ");
+    idle_for(2);
+    send_string_async_cancel();
+    EXPECT_FALSE(send_string_async_busy());
+    idle_for(10);
+    VERIFY_AND_CLEAR(driver);
+}
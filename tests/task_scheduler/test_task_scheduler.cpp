@@ -0,0 +1,173 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <string>
+
+extern "C" {
+#include "task_scheduler.h"
+#include "tracing.h"
+#include "led.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+static std::string ran;
+
+// Each task records its name and takes two milliseconds
+#define TEST_TASK(name)             \
+    static void task_##name(void) { \
+        ran += #name;               \
+        advance_time(2);            \
+    }
+
+TEST_TASK(a)
+TEST_TASK(b)
+TEST_TASK(c)
+TEST_TASK(f)
+
+class TaskScheduler : public TestFixture {
+   protected:
+    void SetUp() override {
+        ran.clear();
+    }
+
+    // Runs the scheduler once, returning the tasks run in that loop
+    std::string loop(task_scheduler_t *scheduler) {
+        ran.clear();
+        task_scheduler_run(scheduler, task_scheduler_clock());
+        return ran;
+    }
+};
+
+static task_scheduler_t make_scheduler(const scheduled_task_t *tasks, uint8_t count, scheduled_task_state_t *state, scheduled_task_t *registered = nullptr, uint8_t registered_size = 0) {
+    task_scheduler_t scheduler = {};
+    scheduler.tasks            = tasks;
+    scheduler.count            = count;
+    scheduler.registered       = registered;
+    scheduler.registered_size  = registered_size;
+    scheduler.state            = state;
+    return scheduler;
+}
+
+TEST_F(TaskScheduler, RunsEveryTaskWithoutBudget) {
+    static const scheduled_task_t tasks[] = {
+        {task_a, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+        {task_b, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+        {task_f, 0, TASK_PRIORITY_FOREGROUND, SCHEDULED_TASK_NO_TRACE},
+    };
+    scheduled_task_state_t state[3]  = {};
+    task_scheduler_t       scheduler = make_scheduler(tasks, 3, state);
+
+    // Tasks run in table order, whatever their priority
+    EXPECT_EQ(loop(&scheduler), "abf");
+    EXPECT_EQ(loop(&scheduler), "abf");
+    EXPECT_EQ(state[0].runs, 2);
+    EXPECT_EQ(state[0].deferrals, 0);
+    EXPECT_EQ(task_scheduler_ticks_to_us(state[0].max_duration), 2000);
+}
+
+TEST_F(TaskScheduler, RunsPeriodicTasksWhenDue) {
+    static const scheduled_task_t tasks[] = {
+        {task_a, 10, TASK_PRIORITY_FOREGROUND, TRACE_USER},
+        {task_b, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+    };
+    scheduled_task_state_t state[2]  = {};
+    task_scheduler_t       scheduler = make_scheduler(tasks, 2, state);
+
+    // Loops take two milliseconds, or four when task a runs: at 0, 10, 20 and 30 ms
+    for (int i = 0; i < 15; i++) {
+        loop(&scheduler);
+    }
+    EXPECT_EQ(state[1].runs, 15);
+    EXPECT_EQ(state[0].runs, 4);
+}
+
+TEST_F(TaskScheduler, DefersBackgroundTasksOverBudget) {
+    static const scheduled_task_t tasks[] = {
+        {task_f, 0, TASK_PRIORITY_FOREGROUND, TRACE_USER},
+        {task_a, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+        {task_b, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+        {task_c, 0, TASK_PRIORITY_BACKGROUND, TRACE_USER},
+    };
+    scheduled_task_state_t state[4]  = {};
+    task_scheduler_t       scheduler = make_scheduler(tasks, 4, state);
+    task_scheduler_set_budget(&scheduler, 5000);
+
+    // With a five millisecond budget two background tasks fit, the third one is deferred once and runs on the next loop
+    EXPECT_EQ(loop(&scheduler), "fab");
+    EXPECT_EQ(loop(&scheduler), "fabc");
+    EXPECT_EQ(loop(&scheduler), "fab");
+    EXPECT_EQ(state[0].runs, 3);
+    EXPECT_EQ(state[1].runs, 3);
+    EXPECT_EQ(state[1].deferrals, 0);
+    EXPECT_EQ(state[3].runs, 1);
+    EXPECT_EQ(state[3].deferrals, 2);
+
+    // Foreground tasks may use up the budget, then background tasks run every other loop
+    task_scheduler_set_budget(&scheduler, 1000);
+    EXPECT_EQ(loop(&scheduler), "fc");
+    EXPECT_EQ(loop(&scheduler), "fab");
+    EXPECT_EQ(loop(&scheduler), "fc");
+
+    // A budget shorter than a clock tick still limits the loop
+    task_scheduler_set_budget(&scheduler, 100);
+    EXPECT_EQ(scheduler.budget, 1);
+
+    task_scheduler_clear_stats(&scheduler);
+    EXPECT_EQ(state[1].runs, 0);
+    EXPECT_EQ(state[1].deferrals, 0);
+    EXPECT_EQ(state[1].max_duration, 0);
+}
+
+TEST_F(TaskScheduler, RunsRegisteredTasksAfterTable) {
+    static const scheduled_task_t tasks[] = {
+        {task_a, 0, TASK_PRIORITY_FOREGROUND, TRACE_USER},
+    };
+    scheduled_task_t       registered[1];
+    scheduled_task_state_t state[2]  = {};
+    task_scheduler_t       scheduler = make_scheduler(tasks, 1, state, registered, 1);
+
+    EXPECT_TRUE(task_scheduler_register(&scheduler, task_c, 10, TASK_PRIORITY_BACKGROUND));
+    EXPECT_FALSE(task_scheduler_register(&scheduler, task_b, 0, TASK_PRIORITY_FOREGROUND));
+
+    EXPECT_EQ(loop(&scheduler), "ac");
+    EXPECT_EQ(loop(&scheduler), "a");
+    EXPECT_EQ(task_scheduler_get_state(&scheduler, task_c), &state[1]);
+    EXPECT_EQ(task_scheduler_get_state(&scheduler, task_b), nullptr);
+}
+
+TEST_F(TaskScheduler, KeyboardTaskDiagnostics) {
+    TestDriver driver;
+
+    keyboard_task_clear_stats();
+    for (int i = 0; i < 5; i++) {
+        keyboard_task();
+        advance_time(1);
+    }
+
+    const scheduled_task_state_t *state = keyboard_task_get_state(led_task);
+    ASSERT_NE(state, nullptr);
+    EXPECT_EQ(state->runs, 5);
+    EXPECT_EQ(state->deferrals, 0);
+
+    // led_task has a period of one millisecond
+    keyboard_task();
+    keyboard_task();
+    EXPECT_EQ(state->runs, 6);
+
+    EXPECT_EQ(keyboard_task_get_state(task_a), nullptr);
+}
+
+TEST_F(TaskScheduler, KeyboardTaskRunsRegisteredTasks) {
+    TestDriver driver;
+
+    EXPECT_TRUE(keyboard_task_register(task_f, 0, TASK_PRIORITY_BACKGROUND));
+    keyboard_task();
+    EXPECT_EQ(ran, "f");
+    EXPECT_NE(keyboard_task_get_state(task_f), nullptr);
+}
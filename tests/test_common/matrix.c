@@ -42,10 +42,12 @@ void matrix_scan_kb(void) {}
 
 void press_key(uint8_t col, uint8_t row) {
     matrix[row] |= (matrix_row_t)1 << col;
+    matrix_mark_rows_dirty(row, 1);
 }
 
 void release_key(uint8_t col, uint8_t row) {
     matrix[row] &= ~((matrix_row_t)1 << col);
+    matrix_mark_rows_dirty(row, 1);
 }
 
 bool matrix_is_on(uint8_t row, uint8_t col) {
@@ -54,6 +56,7 @@ bool matrix_is_on(uint8_t row, uint8_t col) {
 
 void clear_all_keys(void) {
     memset(matrix, 0, sizeof(matrix));
+    matrix_mark_rows_dirty(0, MATRIX_ROWS);
 }
 
 void led_set(uint8_t usb_led) {}
@@ -0,0 +1,121 @@
+// Copyright 2026 QMK
+// SPDX-License-Identifier: GPL-2.0-or-later
+
+#include "keyboard_report_util.hpp"
+#include "test_common.hpp"
+
+#include <vector>
+
+extern "C" {
+#include "tracing.h"
+
+void advance_time(uint32_t ms);
+}
+
+using testing::_;
+
+struct trace_record {
+    uint8_t  id;
+    bool     begin;
+    uint32_t timestamp;
+
+    bool operator==(const trace_record &other) const {
+        return id == other.id && begin == other.begin && timestamp == other.timestamp;
+    }
+};
+
+static std::ostream &operator<<(std::ostream &os, const trace_record &record) {
+    return os << "{" << +record.id << (record.begin ? " begin " : " end ") << record.timestamp << "}";
+}
+
+static std::vector<trace_record> drain(uint8_t chunk = 255) {
+    std::vector<trace_record> records;
+    uint8_t                   buffer[255];
+    uint8_t                   length;
+    while ((length = tracing_read(buffer, chunk)) > 0) {
+        EXPECT_EQ(length % TRACE_RECORD_SIZE, 0);
+        for (uint8_t i = 0; i < length; i += TRACE_RECORD_SIZE) {
+            uint32_t timestamp = buffer[i + 1] | (buffer[i + 2] << 8) | (buffer[i + 3] << 16) | ((uint32_t)buffer[i + 4] << 24);
+            records.push_back({(uint8_t)(buffer[i] & ~TRACE_RECORD_BEGIN), (bool)(buffer[i] & TRACE_RECORD_BEGIN), timestamp});
+        }
+    }
+    return records;
+}
+
+class Tracing : public TestFixture {
+   protected:
+    void SetUp() override {
+        tracing_clear();
+    }
+};
+
+TEST_F(Tracing, SpansAreRecordedInOrder) {
+    uint32_t now = timer_read32();
+    TRACE_BEGIN(TRACE_USER);
+    TRACE_SPAN(TRACE_USER + 1, {});
+    TRACE_END(TRACE_USER);
+
+    std::vector<trace_record> expected = {
+        {TRACE_USER, true, now},
+        {TRACE_USER + 1, true, now},
+        {TRACE_USER + 1, false, now},
+        {TRACE_USER, false, now},
+    };
+    EXPECT_EQ(drain(), expected);
+    EXPECT_TRUE(drain().empty());
+}
+
+TEST_F(Tracing, KeyboardTaskIsInstrumented) {
+    TestDriver driver;
+    EXPECT_NO_REPORT(driver);
+
+    keyboard_task();
+    auto records = drain();
+
+    ASSERT_GE(records.size(), 6u);
+    EXPECT_EQ(records.front(), (trace_record{TRACE_KEYBOARD_TASK, true, records.front().timestamp}));
+    EXPECT_EQ(records[1].id, TRACE_MATRIX_TASK);
+    EXPECT_TRUE(records[1].begin);
+    EXPECT_EQ(records[2].id, TRACE_MATRIX_TASK);
+    EXPECT_FALSE(records[2].begin);
+    EXPECT_EQ(records[3].id, TRACE_QUANTUM_TASK);
+    EXPECT_EQ(records[4].id, TRACE_QUANTUM_TASK);
+    EXPECT_EQ(records.back(), (trace_record{TRACE_KEYBOARD_TASK, false, records.back().timestamp}));
+}
+
+TEST_F(Tracing, LostRecordsAreReported) {
+    for (int i = 0; i < TRACING_BUFFER_SIZE + 3; i++) {
+        TRACE_BEGIN(TRACE_USER);
+    }
+
+    auto records = drain();
+    ASSERT_EQ(records.size(), (size_t)TRACING_BUFFER_SIZE + 1);
+    EXPECT_EQ(records.front().id, TRACE_DROPPED);
+    EXPECT_EQ(records.front().timestamp, 3u);
+
+    // Once reported, the count starts over
+    TRACE_END(TRACE_USER);
+    records = drain();
+    ASSERT_EQ(records.size(), 1u);
+    EXPECT_EQ(records.front().id, TRACE_USER);
+}
+
+TEST_F(Tracing, ReadsOnlyWholeRecords) {
+    for (int i = 0; i < 5; i++) {
+        advance_time(i);
+        TRACE_END(TRACE_USER + i);
+    }
+
+    uint8_t buffer[TRACE_RECORD_SIZE * 2 + 3];
+    EXPECT_EQ(tracing_read(buffer, sizeof(buffer)), TRACE_RECORD_SIZE * 2);
+    EXPECT_EQ(buffer[0], TRACE_USER);
+    EXPECT_EQ(buffer[TRACE_RECORD_SIZE], TRACE_USER + 1);
+    EXPECT_EQ(tracing_read(buffer, TRACE_RECORD_SIZE - 1), 0);
+
+    // The buffer keeps wrapping around as records are read and written
+    auto records = drain(TRACE_RECORD_SIZE);
+    ASSERT_EQ(records.size(), 3u);
+    EXPECT_EQ(records[0].id, TRACE_USER + 2);
+    EXPECT_EQ(records[2].id, TRACE_USER + 4);
+    EXPECT_EQ(records[2].timestamp - records[0].timestamp, 3u + 4u);
+}
@@ -0,0 +1,145 @@
+#!/usr/bin/env python3
+# Copyright 2026 QMK
+# SPDX-License-Identifier: GPL-2.0-or-later
+"""Decodes spans recorded by TRACING_ENABLE.
+
+Reads either console output, where each drained batch is a line of the form
+"trace:<hex>", or a raw binary dump of the records read over raw HID. Prints
+per-span statistics in timestamp ticks, or in microseconds given the tick
+frequency with --frequency, or writes a Chrome trace (viewable in
+chrome://tracing or Perfetto) with --chrome.
+
+    qmk console | tee trace.log
+    util/tracing_decode.py trace.log
+"""
+import argparse
+import json
+import re
+import struct
+import sys
+
+RECORD_SIZE = 5
+RECORD_BEGIN = 0x80
+TRACE_DROPPED = 0x7F
+TRACE_USER = 0x40
+
+# Must match the enum in quantum/tracing.h
+SPAN_NAMES = [
+    'keyboard_task',
+    'matrix_task',
+    'quantum_task',
+    'split_transactions',
+    'led_matrix_task',
+    'rgb_matrix_task',
+    'rgblight_task',
+    'encoder_task',
+    'pointing_device_task',
+    'oled_task',
+    'backlight_task',
+    'st7565_task',
+    'mousekey_task',
+    'ps2_mouse_task',
+    'midi_task',
+    'joystick_task',
+    'bluetooth_task',
+    'haptic_task',
+    'led_task',
+    'os_detection_task',
+    'qp_internal_task',
+    'send_string_async_task',
+]
+
+
+def span_name(span_id):
+    if span_id < len(SPAN_NAMES):
+        return SPAN_NAMES[span_id]
+    if span_id >= TRACE_USER:
+        return f'user_{span_id - TRACE_USER}'
+    return f'span_{span_id}'
+
+
+def read_records(stream, binary):
+    if binary:
+        data = stream.buffer.read() if hasattr(stream, 'buffer') else stream.read()
+    else:
+        data = bytearray()
+        for line in stream:
+            match = re.search(r'trace:([0-9A-Fa-f]+)', line)
+            if match:
+                data += bytes.fromhex(match.group(1))
+
+    for offset in range(0, len(data) - RECORD_SIZE + 1, RECORD_SIZE):
+        header, timestamp = struct.unpack_from('<BI', data, offset)
+        yield header & ~RECORD_BEGIN, bool(header & RECORD_BEGIN), timestamp
+
+
+def pair_spans(records):
+    """Matches the beginning of each span with its end. Spans open when records were lost are discarded."""
+    open_spans = {}
+    spans = []
+    dropped = 0
+    for span_id, begin, timestamp in records:
+        if span_id == TRACE_DROPPED:
+            dropped += timestamp
+            open_spans.clear()
+        elif begin:
+            open_spans.setdefault(span_id, []).append(timestamp)
+        elif open_spans.get(span_id):
+            start = open_spans[span_id].pop()
+            spans.append((span_id, start, (timestamp - start) & 0xFFFFFFFF))
+    return spans, dropped
+
+
+def percentile(values, percent):
+    return values[min(len(values) - 1, len(values) * percent // 100)]
+
+
+def to_microseconds(spans, frequency):
+    return [(span_id, start * 1000000 // frequency, duration * 1000000 // frequency) for span_id, start, duration in spans]
+
+
+def print_statistics(spans, dropped, unit):
+    durations = {}
+    for span_id, _, duration in spans:
+        durations.setdefault(span_id, []).append(duration)
+
+    print(f'durations in {unit}')
+    print(f'{"span":<24}{"count":>8}{"min":>12}{"p50":>12}{"p99":>12}{"max":>12}')
+    for span_id in sorted(durations):
+        values = sorted(durations[span_id])
+        print(f'{span_name(span_id):<24}{len(values):>8}{values[0]:>12}{percentile(values, 50):>12}{percentile(values, 99):>12}{values[-1]:>12}')
+    if dropped:
+        print(f'{dropped} records were lost, consider draining faster or increasing TRACING_BUFFER_SIZE')
+
+
+def write_chrome_trace(spans, output):
+    events = [{'name': span_name(span_id), 'ph': 'X', 'ts': start, 'dur': duration, 'pid': 0, 'tid': 0} for span_id, start, duration in spans]
+    json.dump({'traceEvents': events, 'displayTimeUnit': 'ns'}, output)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__, formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument('input', nargs='?', help='console log or binary dump, defaults to stdin')
+    parser.add_argument('-b', '--binary', action='store_true', help='the input is a binary dump of records')
+    parser.add_argument('-f', '--frequency', type=int, metavar='HZ', help='timestamp ticks per second, to report durations in microseconds')
+    parser.add_argument('-c', '--chrome', metavar='FILE', help='write a Chrome trace to FILE instead of printing statistics')
+    args = parser.parse_args()
+
+    if args.input:
+        with open(args.input, 'rb' if args.binary else 'r') as stream:
+            spans, dropped = pair_spans(read_records(stream, args.binary))
+    else:
+        spans, dropped = pair_spans(read_records(sys.stdin, args.binary))
+
+    if args.frequency:
+        spans = to_microseconds(spans, args.frequency)
+
+    if args.chrome:
+        with open(args.chrome, 'w') as output:
+            write_chrome_trace(spans, output)
+    else:
+        print_statistics(spans, dropped, 'microseconds' if args.frequency else 'ticks')
+
+
+if __name__ == '__main__':
+    main()